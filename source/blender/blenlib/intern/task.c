@@ -200,15 +200,40 @@ struct TaskPool {
 #endif
 };
 
+/* Per-thread double ended queue of tasks.
+ *
+ * Each worker thread owns a queue, tasks pushed from a worker thread go to its
+ * own queue and tasks pushed from other threads are spread over all the queues.
+ * A worker pops tasks from the head of its own queue and steals from the tail
+ * of the other queues when its own queue is empty, so threads only contend when
+ * stealing instead of on every push and pop.
+ */
+typedef struct TaskQueue {
+	ListBase list;
+	/* Number of tasks in the list, read without lock as a hint to skip empty queues. */
+	volatile size_t num;
+	SpinLock lock;
+} TaskQueue;
+
 struct TaskScheduler {
 	pthread_t *threads;
 	struct TaskThread *task_threads;
 	int num_threads;
 	bool background_thread_only;
 
-	ListBase queue;
+	/* Used to put idle worker threads to sleep. */
 	ThreadMutex queue_mutex;
 	ThreadCondition queue_cond;
+	/* Incremented on each push, a worker only sleeps when nothing was pushed
+	 * since it started looking for a task.
+	 */
+	uint32_t push_epoch;
+	/* Number of worker threads sleeping on queue_cond, pushing threads only
+	 * lock queue_mutex to wake them up when not zero.
+	 */
+	uint32_t num_sleeping;
+	/* Queue used for the next push from a thread not owning a queue. */
+	uint32_t next_queue;
 
 	volatile bool do_exit;
 
@@ -220,6 +245,8 @@ typedef struct TaskThread {
 	TaskScheduler *scheduler;
 	int id;
 	TaskThreadLocalStorage tls;
+	/* Tasks queue of the thread, unused for the main thread. */
+	TaskQueue queue;
 } TaskThread;
 
 /* Helper */
@@ -348,55 +375,149 @@ static void task_pool_num_increase(TaskPool *pool, size_t new)
 	BLI_mutex_unlock(&pool->num_mutex);
 }
 
-static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, Task **task)
+BLI_INLINE void task_queue_init(TaskQueue *queue)
 {
-	bool found_task = false;
-	BLI_mutex_lock(&scheduler->queue_mutex);
+	BLI_listbase_clear(&queue->list);
+	queue->num = 0;
+	BLI_spin_init(&queue->lock);
+}
 
-	while (!scheduler->queue.first && !scheduler->do_exit)
-		BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+BLI_INLINE void task_queue_push(TaskQueue *queue, Task *task, TaskPriority priority)
+{
+	BLI_spin_lock(&queue->lock);
+	if (priority == TASK_PRIORITY_HIGH)
+		BLI_addhead(&queue->list, task);
+	else
+		BLI_addtail(&queue->list, task);
+	queue->num++;
+	BLI_spin_unlock(&queue->lock);
+}
 
-	do {
-		Task *current_task;
+/* Pop a task which can be run by a worker thread, from the head for the owner
+ * of the queue and from the tail for other threads stealing work.
+ */
+static Task *task_queue_pop(TaskScheduler *scheduler, TaskQueue *queue, const bool steal)
+{
+	Task *task = NULL;
 
-		/* Assuming we can only have a void queue in 'exit' case here seems logical
-		 * (we should only be here after our worker thread has been woken up from a
-		 * condition_wait(), which only happens after a new task was added to the queue),
-		 * but it is wrong.
-		 * Waiting on condition may wake up the thread even if condition is not signaled
-		 * (spurious wake-ups), and some race condition may also empty the queue **after**
-		 * condition has been signaled, but **before** awoken thread reaches this point...
-		 * See http://stackoverflow.com/questions/8594591
-		 *
-		 * So we only abort here if do_exit is set.
-		 */
-		if (scheduler->do_exit) {
-			BLI_mutex_unlock(&scheduler->queue_mutex);
-			return false;
+	if (queue->num == 0) {
+		return NULL;
+	}
+
+	BLI_spin_lock(&queue->lock);
+	for (Task *current_task = (steal) ? queue->list.last : queue->list.first;
+	     current_task != NULL;
+	     current_task = (steal) ? current_task->prev : current_task->next)
+	{
+		if (scheduler->background_thread_only && !current_task->pool->run_in_background) {
+			continue;
 		}
 
-		for (current_task = scheduler->queue.first;
-		     current_task != NULL;
-		     current_task = current_task->next)
-		{
-			TaskPool *pool = current_task->pool;
+		task = current_task;
+		BLI_remlink(&queue->list, task);
+		queue->num--;
+		break;
+	}
+	BLI_spin_unlock(&queue->lock);
 
-			if (scheduler->background_thread_only && !pool->run_in_background) {
-				continue;
-			}
+	return task;
+}
+
+/* Pop a task of the given pool. */
+static Task *task_queue_pop_pool(TaskQueue *queue, TaskPool *pool)
+{
+	Task *task = NULL;
 
-			*task = current_task;
-			found_task = true;
-			BLI_remlink(&scheduler->queue, *task);
+	if (queue->num == 0) {
+		return NULL;
+	}
+
+	BLI_spin_lock(&queue->lock);
+	for (Task *current_task = queue->list.first; current_task != NULL; current_task = current_task->next) {
+		if (current_task->pool == pool) {
+			task = current_task;
+			BLI_remlink(&queue->list, task);
+			queue->num--;
 			break;
 		}
-		if (!found_task)
-			BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
-	} while (!found_task);
+	}
+	BLI_spin_unlock(&queue->lock);
 
-	BLI_mutex_unlock(&scheduler->queue_mutex);
+	return task;
+}
+
+/* Queue receiving the tasks pushed from the current thread. */
+static TaskQueue *task_scheduler_push_queue(TaskScheduler *scheduler)
+{
+	TaskThread *thread = pthread_getspecific(scheduler->tls_id_key);
+	if (thread != NULL) {
+		return &thread->queue;
+	}
+
+	/* Spread the tasks pushed from main or foreign threads over the workers. */
+	const uint32_t index = atomic_fetch_and_add_uint32(&scheduler->next_queue, 1);
+	return &scheduler->task_threads[(index % scheduler->num_threads) + 1].queue;
+}
 
-	return true;
+/* Wake up sleeping worker threads after tasks were pushed. */
+static void task_scheduler_notify(TaskScheduler *scheduler, const bool all)
+{
+	atomic_add_and_fetch_uint32(&scheduler->push_epoch, 1);
+
+	/* The epoch increment above and the sleeping counter increment in
+	 * task_scheduler_thread_wait_pop are both full barriers, either the worker
+	 * sees the new epoch or we see it sleeping.
+	 */
+	if (atomic_add_and_fetch_uint32(&scheduler->num_sleeping, 0) != 0) {
+		BLI_mutex_lock(&scheduler->queue_mutex);
+		if (all)
+			BLI_condition_notify_all(&scheduler->queue_cond);
+		else
+			BLI_condition_notify_one(&scheduler->queue_cond);
+		BLI_mutex_unlock(&scheduler->queue_mutex);
+	}
+}
+
+static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, TaskThread *thread, Task **task)
+{
+	const int num_threads = scheduler->num_threads;
+
+	while (true) {
+		const uint32_t epoch = atomic_add_and_fetch_uint32(&scheduler->push_epoch, 0);
+
+		if (scheduler->do_exit) {
+			return false;
+		}
+
+		/* First look in our own queue. */
+		*task = task_queue_pop(scheduler, &thread->queue, false);
+		if (*task != NULL) {
+			return true;
+		}
+
+		/* Then steal from the other worker threads. */
+		for (int i = 1; i < num_threads; i++) {
+			TaskThread *victim = &scheduler->task_threads[((thread->id - 1 + i) % num_threads) + 1];
+			*task = task_queue_pop(scheduler, &victim->queue, true);
+			if (*task != NULL) {
+				return true;
+			}
+		}
+
+		/* Nothing to do, sleep until something new is pushed.
+		 *
+		 * Waiting on condition may wake up the thread even if condition is not signaled
+		 * (spurious wake-ups), so we loop while the push epoch is unchanged.
+		 * See http://stackoverflow.com/questions/8594591
+		 */
+		BLI_mutex_lock(&scheduler->queue_mutex);
+		atomic_add_and_fetch_uint32(&scheduler->num_sleeping, 1);
+		while (!scheduler->do_exit && atomic_add_and_fetch_uint32(&scheduler->push_epoch, 0) == epoch) {
+			BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+		}
+		atomic_sub_and_fetch_uint32(&scheduler->num_sleeping, 1);
+		BLI_mutex_unlock(&scheduler->queue_mutex);
+	}
 }
 
 BLI_INLINE void handle_local_queue(TaskThreadLocalStorage *tls,
@@ -430,7 +551,7 @@ static void *task_scheduler_thread_run(void *thread_p)
 	pthread_setspecific(scheduler->tls_id_key, thread);
 
 	/* keep popping off tasks */
-	while (task_scheduler_thread_wait_pop(scheduler, &task)) {
+	while (task_scheduler_thread_wait_pop(scheduler, thread, &task)) {
 		TaskPool *pool = task->pool;
 
 		/* run task */
@@ -459,7 +580,6 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
 	 * threads, so we keep track of the number of users. */
 	scheduler->do_exit = false;
 
-	BLI_listbase_clear(&scheduler->queue);
 	BLI_mutex_init(&scheduler->queue_mutex);
 	BLI_condition_init(&scheduler->queue_cond);
 
@@ -480,11 +600,17 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
 	scheduler->task_threads = MEM_mallocN(sizeof(TaskThread) * (num_threads + 1),
 	                                      "TaskScheduler task threads");
 
-	/* Initialize TLS for main thread. */
+	/* Initialize TLS and queue for main thread. */
 	initialize_task_tls(&scheduler->task_threads[0].tls);
+	task_queue_init(&scheduler->task_threads[0].queue);
 
 	pthread_key_create(&scheduler->tls_id_key, NULL);
 
+	/* Initialize all the queues before launching threads which could steal from them. */
+	for (int i = 0; i < num_threads; i++) {
+		task_queue_init(&scheduler->task_threads[i + 1].queue);
+	}
+
 	/* launch threads that will be waiting for work */
 	if (num_threads > 0) {
 		int i;
@@ -514,6 +640,7 @@ void BLI_task_scheduler_free(TaskScheduler *scheduler)
 	/* stop all waiting threads */
 	BLI_mutex_lock(&scheduler->queue_mutex);
 	scheduler->do_exit = true;
+	atomic_add_and_fetch_uint32(&scheduler->push_epoch, 1);
 	BLI_condition_notify_all(&scheduler->queue_cond);
 	BLI_mutex_unlock(&scheduler->queue_mutex);
 
@@ -531,22 +658,23 @@ void BLI_task_scheduler_free(TaskScheduler *scheduler)
 		MEM_freeN(scheduler->threads);
 	}
 
-	/* Delete task thread data */
+	/* Delete task thread data and leftover tasks */
 	if (scheduler->task_threads) {
 		for (int i = 0; i < scheduler->num_threads + 1; ++i) {
 			TaskThreadLocalStorage *tls = &scheduler->task_threads[i].tls;
 			free_task_tls(tls);
+
+			TaskQueue *queue = &scheduler->task_threads[i].queue;
+			for (task = queue->list.first; task; task = task->next) {
+				task_data_free(task, 0);
+			}
+			BLI_freelistN(&queue->list);
+			BLI_spin_end(&queue->lock);
 		}
 
 		MEM_freeN(scheduler->task_threads);
 	}
 
-	/* delete leftover tasks */
-	for (task = scheduler->queue.first; task; task = task->next) {
-		task_data_free(task, 0);
-	}
-	BLI_freelistN(&scheduler->queue);
-
 	/* delete mutex/condition */
 	BLI_mutex_end(&scheduler->queue_mutex);
 	BLI_condition_end(&scheduler->queue_cond);
@@ -564,15 +692,9 @@ static void task_scheduler_push(TaskScheduler *scheduler, Task *task, TaskPriori
 	task_pool_num_increase(task->pool, 1);
 
 	/* add task to queue */
-	BLI_mutex_lock(&scheduler->queue_mutex);
-
-	if (priority == TASK_PRIORITY_HIGH)
-		BLI_addhead(&scheduler->queue, task);
-	else
-		BLI_addtail(&scheduler->queue, task);
+	task_queue_push(task_scheduler_push_queue(scheduler), task, priority);
 
-	BLI_condition_notify_one(&scheduler->queue_cond);
-	BLI_mutex_unlock(&scheduler->queue_mutex);
+	task_scheduler_notify(scheduler, false);
 }
 
 static void task_scheduler_push_all(TaskScheduler *scheduler,
@@ -586,14 +708,17 @@ static void task_scheduler_push_all(TaskScheduler *scheduler,
 
 	task_pool_num_increase(pool, num_tasks);
 
-	BLI_mutex_lock(&scheduler->queue_mutex);
+	TaskQueue *queue = task_scheduler_push_queue(scheduler);
+	BLI_spin_lock(&queue->lock);
 
 	for (int i = 0; i < num_tasks; i++) {
-		BLI_addhead(&scheduler->queue, tasks[i]);
+		BLI_addhead(&queue->list, tasks[i]);
 	}
+	queue->num += num_tasks;
 
-	BLI_condition_notify_all(&scheduler->queue_cond);
-	BLI_mutex_unlock(&scheduler->queue_mutex);
+	BLI_spin_unlock(&queue->lock);
+
+	task_scheduler_notify(scheduler, true);
 }
 
 static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
@@ -601,22 +726,25 @@ static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
 	Task *task, *nexttask;
 	size_t done = 0;
 
-	BLI_mutex_lock(&scheduler->queue_mutex);
+	/* free all tasks from this pool from the queues */
+	for (int i = 0; i < scheduler->num_threads + 1; i++) {
+		TaskQueue *queue = &scheduler->task_threads[i].queue;
 
-	/* free all tasks from this pool from the queue */
-	for (task = scheduler->queue.first; task; task = nexttask) {
-		nexttask = task->next;
+		BLI_spin_lock(&queue->lock);
+		for (task = queue->list.first; task; task = nexttask) {
+			nexttask = task->next;
 
-		if (task->pool == pool) {
-			task_data_free(task, pool->thread_id);
-			BLI_freelinkN(&scheduler->queue, task);
+			if (task->pool == pool) {
+				task_data_free(task, pool->thread_id);
+				BLI_freelinkN(&queue->list, task);
+				queue->num--;
 
-			done++;
+				done++;
+			}
 		}
+		BLI_spin_unlock(&queue->lock);
 	}
 
-	BLI_mutex_unlock(&scheduler->queue_mutex);
-
 	/* notify done */
 	task_pool_num_decrease(pool, done);
 }
@@ -847,12 +975,16 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 	if (atomic_fetch_and_and_uint8((uint8_t *)&pool->is_suspended, 0)) {
 		if (pool->num_suspended) {
 			task_pool_num_increase(pool, pool->num_suspended);
-			BLI_mutex_lock(&scheduler->queue_mutex);
 
-			BLI_movelisttolist(&scheduler->queue, &pool->suspended_queue);
+			/* Spread the suspended tasks over all the worker queues. */
+			Task *task, *nexttask;
+			for (task = pool->suspended_queue.first; task; task = nexttask) {
+				nexttask = task->next;
+				task_queue_push(task_scheduler_push_queue(scheduler), task, TASK_PRIORITY_LOW);
+			}
+			BLI_listbase_clear(&pool->suspended_queue);
 
-			BLI_condition_notify_all(&scheduler->queue_cond);
-			BLI_mutex_unlock(&scheduler->queue_mutex);
+			task_scheduler_notify(scheduler, true);
 		}
 	}
 
@@ -863,27 +995,22 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 	BLI_mutex_lock(&pool->num_mutex);
 
 	while (pool->num != 0) {
-		Task *task, *work_task = NULL;
+		Task *work_task = NULL;
 		bool found_task = false;
 
 		BLI_mutex_unlock(&pool->num_mutex);
 
-		BLI_mutex_lock(&scheduler->queue_mutex);
-
 		/* find task from this pool. if we get a task from another pool,
 		 * we can get into deadlock */
 
-		for (task = scheduler->queue.first; task; task = task->next) {
-			if (task->pool == pool) {
-				work_task = task;
+		for (int i = 0; i < scheduler->num_threads + 1; i++) {
+			work_task = task_queue_pop_pool(&scheduler->task_threads[i].queue, pool);
+			if (work_task != NULL) {
 				found_task = true;
-				BLI_remlink(&scheduler->queue, task);
 				break;
 			}
 		}
 
-		BLI_mutex_unlock(&scheduler->queue_mutex);
-
 		/* if found task, do it, otherwise wait until other tasks are done */
 		if (found_task) {
 			/* run task */
@@ -892,7 +1019,7 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 			BLI_assert(!tls->do_delayed_push);
 
 			/* delete task */
-			task_free(pool, task, pool->thread_id);
+			task_free(pool, work_task, pool->thread_id);
 
 			/* Handle all tasks from local queue. */
 			handle_local_queue(tls, pool->thread_id);
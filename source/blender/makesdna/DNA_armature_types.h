@@ -152,6 +152,7 @@ typedef enum eArmature_Drawtype {
 typedef enum eArmature_VertDeformer {
 	ARM_VDEF_BLENDER = 0,
 	ARM_VDEF_BGE_CPU = 1,
+	ARM_VDEF_BGE_CPU_SIMD = 2,
 } eArmature_VertDeformer;
 
 /* armature->deformflag */
@@ -986,6 +986,8 @@ static void rna_def_armature(BlenderRNA *brna)
 	static const EnumPropertyItem prop_vdeformer[] = {
 		{ARM_VDEF_BLENDER, "BLENDER", 0, "Blender", "Use Blender's armature vertex deformation"},
 		{ARM_VDEF_BGE_CPU, "BGE_CPU", 0, "BGE", "Use vertex deformation code optimized for the BGE"},
+		{ARM_VDEF_BGE_CPU_SIMD, "BGE_CPU_SIMD", 0, "BGE SIMD",
+		                        "Use multithreaded and vectorized vertex deformation with at most four bones per vertex"},
 		{0, NULL, 0, NULL, NULL}
 	};
 	static const EnumPropertyItem prop_ghost_type_items[] = {
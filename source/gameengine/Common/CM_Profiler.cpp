@@ -0,0 +1,212 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Common/CM_Profiler.cpp
+ *  \ingroup common
+ */
+
+#include "CM_Profiler.h"
+#include "CM_Thread.h"
+#include "CM_Message.h"
+
+#include <fstream>
+#include <iomanip>
+#include <cstring>
+
+CM_ProfileTrack::CM_ProfileTrack(const std::string& name)
+	:m_name(name),
+	m_events(MaxEvents),
+	m_count(0)
+{
+}
+
+CM_ProfileTrack::~CM_ProfileTrack()
+{
+}
+
+const std::string& CM_ProfileTrack::GetName() const
+{
+	return m_name;
+}
+
+void CM_ProfileTrack::AddEvent(const char *name, const char *detail, CM_Clock::Rep start, CM_Clock::Rep end)
+{
+	const unsigned long long count = m_count.load(std::memory_order_relaxed);
+	Event& event = m_events[count % MaxEvents];
+	event.name = name;
+	event.start = start;
+	event.end = end;
+	if (detail) {
+		strncpy(event.detail, detail, sizeof(event.detail) - 1);
+		event.detail[sizeof(event.detail) - 1] = '\0';
+	}
+	else {
+		event.detail[0] = '\0';
+	}
+
+	// Publish the event to the reader.
+	m_count.store(count + 1, std::memory_order_release);
+}
+
+void CM_ProfileTrack::GetEvents(CM_Clock::Rep since, CM_Clock::Rep until, std::vector<Event>& events) const
+{
+	const unsigned long long count = m_count.load(std::memory_order_acquire);
+	const unsigned long long first = (count > MaxEvents) ? count - MaxEvents : 0;
+
+	const unsigned int offset = events.size();
+	std::vector<unsigned long long> indices;
+	for (unsigned long long i = first; i < count; ++i) {
+		const Event& event = m_events[i % MaxEvents];
+		if (event.end >= since && event.start <= until) {
+			events.push_back(event);
+			indices.push_back(i);
+		}
+	}
+
+	/* The writer can overwrite the oldest slots while they are copied, the event of index i
+	 * is reused by the event of index i + MaxEvents. Read the count again after the copies
+	 * and skip the events possibly modified, including the one being written. */
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const unsigned long long newCount = m_count.load(std::memory_order_relaxed);
+	if (newCount < MaxEvents) {
+		return;
+	}
+
+	const unsigned long long firstValid = newCount - MaxEvents + 1;
+	unsigned int numInvalid = 0;
+	while (numInvalid < indices.size() && indices[numInvalid] < firstValid) {
+		++numInvalid;
+	}
+	events.erase(events.begin() + offset, events.begin() + offset + numInvalid);
+}
+
+std::atomic<bool> CM_Profiler::m_enabled(false);
+CM_Clock CM_Profiler::m_clock;
+
+/// All the tracks, never freed before the exit as the threads keep a pointer to their track.
+static std::vector<std::unique_ptr<CM_ProfileTrack> > profileTracks;
+static CM_ThreadMutex profileTracksMutex;
+
+void CM_Profiler::SetEnabled(bool enabled)
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+CM_Clock::Rep CM_Profiler::GetTime()
+{
+	return m_clock.GetTimeNano();
+}
+
+CM_ProfileTrack *CM_Profiler::GetThreadTrack()
+{
+	static thread_local CM_ProfileTrack *track = nullptr;
+	if (!track) {
+		profileTracksMutex.Lock();
+		track = new CM_ProfileTrack("Thread " + std::to_string(profileTracks.size()));
+		profileTracks.emplace_back(track);
+		profileTracksMutex.Unlock();
+	}
+
+	return track;
+}
+
+CM_ProfileTrack *CM_Profiler::AddTrack(const std::string& name)
+{
+	profileTracksMutex.Lock();
+	CM_ProfileTrack *track = new CM_ProfileTrack(name);
+	profileTracks.emplace_back(track);
+	profileTracksMutex.Unlock();
+
+	return track;
+}
+
+/// Write a string with the JSON escapes.
+static void writeJsonString(std::ostream& stream, const char *str)
+{
+	stream << '"';
+	for (const char *c = str; *c; ++c) {
+		switch (*c) {
+			case '"':
+			case '\\':
+			{
+				stream << '\\' << *c;
+				break;
+			}
+			default:
+			{
+				if ((unsigned char)*c < 0x20) {
+					stream << ' ';
+				}
+				else {
+					stream << *c;
+				}
+				break;
+			}
+		}
+	}
+	stream << '"';
+}
+
+bool CM_Profiler::WriteTrace(const std::string& path, CM_Clock::Rep since, CM_Clock::Rep until)
+{
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		CM_Error("cannot write profile trace file \"" << path << "\"");
+		return false;
+	}
+
+	// Chrome trace times are in microseconds.
+	file << std::fixed << std::setprecision(3);
+	file << "{\"traceEvents\":[\n";
+
+	bool first = true;
+	std::vector<CM_ProfileTrack::Event> events;
+
+	profileTracksMutex.Lock();
+	for (unsigned int tid = 0, size = profileTracks.size(); tid < size; ++tid) {
+		const CM_ProfileTrack *track = profileTracks[tid].get();
+
+		file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+		     << ",\"args\":{\"name\":";
+		writeJsonString(file, track->GetName().c_str());
+		file << "}}";
+		first = false;
+
+		events.clear();
+		track->GetEvents(since, until, events);
+		for (const CM_ProfileTrack::Event& event : events) {
+			file << ",\n{\"name\":";
+			writeJsonString(file, event.name);
+			file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid << ",\"ts\":" << event.start * 1.0e-3
+			     << ",\"dur\":" << (event.end - event.start) * 1.0e-3;
+			if (event.detail[0] != '\0') {
+				file << ",\"args\":{\"detail\":";
+				writeJsonString(file, event.detail);
+				file << "}";
+			}
+			file << "}";
+		}
+	}
+	profileTracksMutex.Unlock();
+
+	file << "\n]}\n";
+
+	return file.good();
+}
@@ -0,0 +1,147 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_Profiler.h
+ *  \ingroup common
+ */
+
+#ifndef __CM_PROFILER_H__
+#define __CM_PROFILER_H__
+
+#include "CM_Clock.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <limits>
+
+/** Ring buffer of timed events written by a single thread.
+ * When the buffer is full the oldest events are overwritten.
+ */
+class CM_ProfileTrack
+{
+public:
+	struct Event
+	{
+		/// Static name of the event.
+		const char *name;
+		CM_Clock::Rep start;
+		CM_Clock::Rep end;
+		/// Copy of an optional detail, e.g. a scene or object name.
+		char detail[40];
+	};
+
+	/// Number of events kept per track.
+	static const unsigned int MaxEvents = (1 << 14);
+
+private:
+	std::string m_name;
+	std::vector<Event> m_events;
+	/// Total number of events added, the index of the next event is modulo the buffer size.
+	std::atomic<unsigned long long> m_count;
+
+public:
+	CM_ProfileTrack(const std::string& name);
+	~CM_ProfileTrack();
+
+	const std::string& GetName() const;
+
+	/** Add an event.
+	 * \param name Name of the event, must not be freed before the track.
+	 * \param detail Optional detail copied in the event, can be nullptr.
+	 */
+	void AddEvent(const char *name, const char *detail, CM_Clock::Rep start, CM_Clock::Rep end);
+
+	/** Copy the events overlapping the time range.
+	 * Can be called while the owner thread adds events, the events overwritten during the copy are skipped.
+	 */
+	void GetEvents(CM_Clock::Rep since, CM_Clock::Rep until, std::vector<Event>& events) const;
+};
+
+/** Low overhead profiler of hierarchical scoped events, see CM_ProfileScope.
+ * Each thread writes in its own track and the tracks are exported in the
+ * Chrome trace format, readable in chrome://tracing or similar viewers.
+ * When disabled a scope costs a single test.
+ */
+class CM_Profiler
+{
+private:
+	static std::atomic<bool> m_enabled;
+	static CM_Clock m_clock;
+
+public:
+	static void SetEnabled(bool enabled);
+	inline static bool IsEnabled()
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	/// Return the time in nanoseconds used by all the events.
+	static CM_Clock::Rep GetTime();
+
+	/// Return the track of the calling thread, created on first call.
+	static CM_ProfileTrack *GetThreadTrack();
+	/// Create a track not related to a thread, e.g. for the time categories.
+	static CM_ProfileTrack *AddTrack(const std::string& name);
+
+	/** Write the events of all the tracks overlapping a time range to a trace file.
+	 * The threads can keep adding events during the call, see CM_ProfileTrack::GetEvents.
+	 * \return False if the file can't be written.
+	 */
+	static bool WriteTrace(const std::string& path, CM_Clock::Rep since = 0,
+	                       CM_Clock::Rep until = std::numeric_limits<CM_Clock::Rep>::max());
+};
+
+/** Record an event for the lifetime of the scope, the scopes nested in
+ * the same thread are displayed as children.
+ */
+class CM_ProfileScope
+{
+private:
+	const char *m_name;
+	const char *m_detail;
+	CM_Clock::Rep m_start;
+
+public:
+	/** \param name Static name of the event.
+	 * \param detail Optional detail, must be valid until the end of the scope.
+	 */
+	inline CM_ProfileScope(const char *name, const char *detail = nullptr)
+		:m_name(CM_Profiler::IsEnabled() ? name : nullptr),
+		m_detail(detail),
+		m_start(0)
+	{
+		if (m_name) {
+			m_start = CM_Profiler::GetTime();
+		}
+	}
+
+	inline ~CM_ProfileScope()
+	{
+		if (m_name) {
+			// The end is measured before the track which could be created.
+			const CM_Clock::Rep end = CM_Profiler::GetTime();
+			CM_Profiler::GetThreadTrack()->AddEvent(m_name, m_detail, m_start, end);
+		}
+	}
+};
+
+#endif  // __CM_PROFILER_H__
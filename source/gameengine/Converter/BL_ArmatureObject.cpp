@@ -42,8 +42,10 @@ extern "C" {
 #include "BL_ActionActuator.h"
 #include "BL_Action.h"
 #include "BL_SceneConverter.h"
+#include "BL_PoseCache.h"
 #include "KX_Globals.h"
 #include "KX_KetsjiEngine.h"
+#include "KX_Scene.h"
 
 #include "RAS_DebugDraw.h"
 
@@ -51,6 +53,9 @@ extern "C" {
 
 #include "CM_Message.h"
 
+#include <algorithm>
+#include <climits>
+
 /**
  * Move here pose function for game engine so that we can mix with GE objects
  * Principle is as follow:
@@ -196,7 +201,16 @@ BL_ArmatureObject::BL_ArmatureObject(Object *armature, Scene *scene)
 	:m_scene(scene),
 	m_lastframe(0.0),
 	m_drawDebug(false),
-	m_lastapplyframe(0.0)
+	m_lastapplyframe(0.0),
+	m_usePoseCache(true),
+	m_animationLodStep(0),
+	m_animationLodFrame(0),
+	m_animationLodTime(0.0),
+	m_animationLodReplicas(0),
+	m_animationLodInterval(1),
+	m_animationLodEvalFrame(0),
+	m_animationLodPrevPose(nullptr),
+	m_animationLodNextPose(nullptr)
 {
 	m_controlledConstraints = new EXP_ListValue<BL_ArmatureConstraint>();
 
@@ -210,6 +224,14 @@ BL_ArmatureObject::BL_ArmatureObject(Object *armature, Scene *scene)
 	m_objArma->pose->flag |= POSE_GAME_ENGINE;
 	memcpy(m_obmat, m_objArma->obmat, sizeof(m_obmat));
 
+	// The constraints use the transform of the other objects, the pose is specific to this instance.
+	for (bPoseChannel *pchan = (bPoseChannel *)m_objArma->pose->chanbase.first; pchan; pchan = pchan->next) {
+		if (pchan->constraints.first) {
+			m_usePoseCache = false;
+			break;
+		}
+	}
+
 	LoadChannels();
 }
 
@@ -218,6 +240,8 @@ BL_ArmatureObject::~BL_ArmatureObject()
 	m_poseChannels->Release();
 	m_controlledConstraints->Release();
 
+	ClearAnimationLodPoses();
+
 	if (m_objArma) {
 		BKE_libblock_free(G.main, m_objArma->data);
 		/* avoid BKE_libblock_free(G.main, m_objArma)
@@ -356,6 +380,8 @@ BL_ArmatureChannel *BL_ArmatureObject::GetChannel(int index)
 EXP_Value *BL_ArmatureObject::GetReplica()
 {
 	BL_ArmatureObject *replica = new BL_ArmatureObject(*this);
+	// Avoid evaluating all the replicas skipped by the animation lod on the same frame.
+	replica->m_animationLodFrame = m_animationLodReplicas++;
 	replica->ProcessReplica();
 	return replica;
 }
@@ -371,6 +397,10 @@ void BL_ArmatureObject::ProcessReplica()
 	m_objArma = BKE_object_copy(G.main, m_objArma);
 	m_objArma->data = BKE_armature_copy(G.main, tmp);
 
+	m_animationLodReplicas = 0;
+	m_animationLodPrevPose = nullptr;
+	m_animationLodNextPose = nullptr;
+
 	LoadChannels();
 }
 
@@ -414,7 +444,12 @@ void BL_ArmatureObject::ApplyPose() // TODO: bouger dans SetPoseByAction ?
 		}
 		// update ourself
 		UpdateBlenderObjectMatrix(m_objArma);
-		BKE_pose_where_is(m_scene, m_objArma);
+		if (m_usePoseCache) {
+			GetScene()->GetPoseCache().ApplyPose(m_origObjArma, m_objArma, m_scene);
+		}
+		else {
+			BKE_pose_where_is(m_scene, m_objArma);
+		}
 		// restore ourself
 		memcpy(m_objArma->obmat, m_obmat, sizeof(m_obmat)); // TODO: Pourquoi restorer ?
 		m_lastapplyframe = m_lastframe;
@@ -447,6 +482,85 @@ bool BL_ArmatureObject::UpdateTimestep(double curtime)
 	return false;
 }
 
+bool BL_ArmatureObject::NeedAnimationLodUpdate(double curtime)
+{
+	if (curtime != m_animationLodTime) {
+		m_animationLodTime = curtime;
+		++m_animationLodFrame;
+	}
+
+	m_animationLodInterval = 1;
+
+	if (m_animationLodStep == 0) {
+		return true;
+	}
+
+	// Use the most detailed level of the visible children meshes.
+	short level = SHRT_MAX;
+	for (KX_GameObject *child : GetChildren()) {
+		if (child->GetLodManager() && !child->GetCulled()) {
+			level = std::min(level, child->GetCurrentLodLevel());
+		}
+	}
+
+	if (level == SHRT_MAX || level == 0) {
+		return true;
+	}
+
+	m_animationLodInterval = 1 + level * m_animationLodStep;
+	if ((m_animationLodFrame % m_animationLodInterval) != 0) {
+		return false;
+	}
+
+	// The actions blend with the last evaluated pose, not with the interpolated one.
+	if (m_animationLodNextPose) {
+		extract_pose_from_pose(m_objArma->pose, m_animationLodNextPose);
+	}
+
+	return true;
+}
+
+void BL_ArmatureObject::UpdateAnimationLodPose(double curtime, bool evaluated)
+{
+	if (m_animationLodInterval == 1) {
+		ClearAnimationLodPoses();
+		return;
+	}
+
+	if (evaluated) {
+		// Store the new pose once per animation update, the updates can be redundant.
+		if (!m_animationLodNextPose || m_animationLodEvalFrame != m_animationLodFrame) {
+			std::swap(m_animationLodPrevPose, m_animationLodNextPose);
+			GetPose(&m_animationLodNextPose);
+			if (!m_animationLodPrevPose) {
+				GetPose(&m_animationLodPrevPose);
+			}
+			m_animationLodEvalFrame = m_animationLodFrame;
+		}
+	}
+	// Nothing to interpolate before the first evaluation.
+	else if (!m_animationLodNextPose) {
+		return;
+	}
+
+	const float factor = std::min((float)(m_animationLodFrame - m_animationLodEvalFrame) / m_animationLodInterval, 1.0f);
+	extract_pose_from_pose(m_objArma->pose, m_animationLodPrevPose);
+	BlendInPose(m_animationLodNextPose, factor, BL_Action::ACT_BLEND_BLEND);
+	UpdateTimestep(curtime);
+}
+
+void BL_ArmatureObject::ClearAnimationLodPoses()
+{
+	if (m_animationLodPrevPose) {
+		BKE_pose_free(m_animationLodPrevPose);
+		m_animationLodPrevPose = nullptr;
+	}
+	if (m_animationLodNextPose) {
+		BKE_pose_free(m_animationLodNextPose);
+		m_animationLodNextPose = nullptr;
+	}
+}
+
 Object *BL_ArmatureObject::GetArmatureObject()
 {
 	return m_objArma;
@@ -461,6 +575,11 @@ int BL_ArmatureObject::GetVertDeformType() const
 	return ((bArmature *)m_objArma->data)->gevertdeformer;
 }
 
+bool BL_ArmatureObject::GetUsePoseCache() const
+{
+	return m_usePoseCache;
+}
+
 void BL_ArmatureObject::GetPose(bPose **pose) const
 {
 	/* If the caller supplies a null pose, create a new one. */
@@ -572,6 +691,7 @@ PyAttributeDef BL_ArmatureObject::Attributes[] = {
 
 	EXP_PYATTRIBUTE_RO_FUNCTION("constraints",       BL_ArmatureObject, pyattr_get_constraints),
 	EXP_PYATTRIBUTE_RO_FUNCTION("channels",      BL_ArmatureObject, pyattr_get_channels),
+	EXP_PYATTRIBUTE_SHORT_RW("animationLodStep", 0, 100, true, BL_ArmatureObject, m_animationLodStep),
 	EXP_PYATTRIBUTE_NULL //Sentinel
 };
 
@@ -57,6 +57,24 @@ protected:
 	bool m_drawDebug;
 
 	double m_lastapplyframe;
+	/// True if the pose doesn't depend on other objects and can be shared with the other instances.
+	bool m_usePoseCache;
+	/// Frames added to the animation update interval per lod level of the children meshes, 0 to disable.
+	short m_animationLodStep;
+	/// Number of animation updates, offset per instance to spread the updates over the frames.
+	unsigned int m_animationLodFrame;
+	double m_animationLodTime;
+	/// Number of replicas of this armature, offsets the animation lod frame of each new replica.
+	unsigned int m_animationLodReplicas;
+	/// Evaluation interval of the last animation update, 1 when the pose is evaluated at each update.
+	unsigned int m_animationLodInterval;
+	/// Animation update of the last evaluation.
+	unsigned int m_animationLodEvalFrame;
+	/// Poses of the two last evaluations, the skipped updates interpolate between them.
+	bPose *m_animationLodPrevPose;
+	bPose *m_animationLodNextPose;
+
+	void ClearAnimationLodPoses();
 
 public:
 	BL_ArmatureObject(Object *armature, Scene *scene);
@@ -74,15 +92,29 @@ public:
 	void GetPose(bPose **pose) const;
 	/// Never edit this, only for accessing names.
 	bPose *GetPose() const;
+	/// Evaluate the pose matrices, the pose is copied from the scene pose cache when possible.
 	void ApplyPose();
 	void SetPoseByAction(bAction *action, float localtime);
 	void BlendInPose(bPose *blend_pose, float weight, short mode);
 
 	bool UpdateTimestep(double curtime);
+	/** Return true if the pose must be evaluated for this animation update, the armature
+	 * is evaluated every 1 + level * m_animationLodStep frames where level is the lowest
+	 * lod level of its visible children meshes.
+	 * \param curtime The animation time, the frames are counted only when it changes.
+	 */
+	bool NeedAnimationLodUpdate(double curtime);
+	/** Set the pose after the actions update when the animation lod is used. The pose is interpolated
+	 * one interval late between the two last evaluated poses, so the deformers are updated at each
+	 * animation update.
+	 * \param evaluated True if the actions were evaluated in this update.
+	 */
+	void UpdateAnimationLodPose(double curtime, bool evaluated);
 
 	Object *GetArmatureObject();
 	Object *GetOrigArmatureObject();
 	int GetVertDeformType() const;
+	bool GetUsePoseCache() const;
 	bool GetDrawDebug() const;
 	void DrawDebug(RAS_DebugDraw& debugDraw);
 
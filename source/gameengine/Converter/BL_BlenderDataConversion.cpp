@@ -103,6 +103,8 @@
 #include "BL_ConvertSensors.h"
 #include "BL_ConvertProperties.h"
 #include "BL_ConvertObjectInfo.h"
+#include "BL_Converter.h"
+#include "BL_MeshCache.h"
 #include "BL_ArmatureObject.h"
 #include "BL_ActionData.h"
 
@@ -121,6 +123,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_threads.h"
+#include "BLI_task.h"
 
 #include "DNA_object_types.h"
 #include "DNA_material_types.h"
@@ -441,20 +444,22 @@ static RAS_MaterialBucket *BL_ConvertMaterial(Material *ma, KX_Scene *scene, BL_
 	return bucket;
 }
 
-/* blenderobj can be nullptr, make sure its checked for */
-KX_Mesh *BL_ConvertMesh(Mesh *me, Object *blenderobj, KX_Scene *scene, BL_SceneConverter& converter)
-{
+/// Mesh data kept between the steps of a mesh conversion.
+struct BL_MeshConversion {
+	Mesh *mesh;
 	KX_Mesh *meshobj;
+	DerivedMesh *dm;
+	std::vector<BL_MeshMaterial> mats;
+	/// The cache of the converted arrays, nullptr if the mesh is not cached.
+	BL_MeshCache *cache;
+};
 
-	// Without checking names, we get some reuse we don't want that can cause
-	// problems with material LoDs.
-	if (blenderobj && ((meshobj = converter.FindGameMesh(me)) != nullptr)) {
-		const std::string bge_name = meshobj->GetName();
-		const std::string blender_name = ((ID *)blenderobj->data)->name + 2;
-		if (bge_name == blender_name) {
-			return meshobj;
-		}
-	}
+/** Create the mesh and convert its materials, this step uses the scene and the converter
+ * and can't be run in parallel.
+ */
+static void BL_ConvertMeshBegin(BL_MeshConversion& conversion, Object *blenderobj, KX_Scene *scene, BL_SceneConverter& converter)
+{
+	Mesh *me = conversion.mesh;
 
 	// Get DerivedMesh data.
 	DerivedMesh *dm = CDDM_from_mesh(me);
@@ -486,7 +491,7 @@ KX_Mesh *BL_ConvertMesh(Mesh *me, Object *blenderobj, KX_Scene *scene, BL_SceneC
 	vertformat.uvSize = max_ii(1, uvCount);
 	vertformat.colorSize = max_ii(1, colorCount);
 
-	meshobj = new KX_Mesh(scene, me, layersInfo);
+	KX_Mesh *meshobj = new KX_Mesh(scene, me, layersInfo);
 
 	const unsigned short totmat = max_ii(me->totcol, 1);
 	std::vector<BL_MeshMaterial> mats(totmat);
@@ -511,17 +516,136 @@ KX_Mesh *BL_ConvertMesh(Mesh *me, Object *blenderobj, KX_Scene *scene, BL_SceneC
 		mats[i] = {meshmat->GetDisplayArray(), bucket, mat->IsVisible(), mat->IsTwoSided(), mat->IsCollider(), mat->IsWire()};
 	}
 
-	BL_ConvertDerivedMeshToArray(dm, me, mats, layersInfo);
+	conversion.meshobj = meshobj;
+	conversion.dm = dm;
+	conversion.mats = std::move(mats);
+	conversion.cache = BL_MeshCache::IsCacheable(me) ? &KX_GetActiveEngine()->GetConverter()->GetMeshCache() : nullptr;
+}
+
+/// Fill the display arrays of the mesh, meshes can be filled in parallel.
+static void BL_ConvertMeshArrays(BL_MeshConversion& conversion)
+{
+	BL_MeshCache *cache = conversion.cache;
+	if (!cache) {
+		BL_ConvertDerivedMeshToArray(conversion.dm, conversion.mesh, conversion.mats, conversion.meshobj->GetLayersInfo());
+		return;
+	}
+
+	// Reuse the arrays of the mesh loaded previously from the same library.
+	const uint64_t hash = BL_MeshCache::Hash(conversion.mesh, conversion.mats);
+	if (cache->Restore(conversion.mesh, hash, conversion.mats)) {
+		return;
+	}
+
+	BL_ConvertDerivedMeshToArray(conversion.dm, conversion.mesh, conversion.mats, conversion.meshobj->GetLayersInfo());
+	cache->Store(conversion.mesh, hash, conversion.mats);
+}
+
+/// Finalize and register the mesh.
+static void BL_ConvertMeshEnd(BL_MeshConversion& conversion, KX_Scene *scene, BL_SceneConverter& converter)
+{
+	KX_Mesh *meshobj = conversion.meshobj;
 
 	meshobj->EndConversion(scene->GetBoundingBoxManager());
 
-	dm->release(dm);
+	conversion.dm->release(conversion.dm);
 
 	// Needed for python scripting.
 	scene->GetLogicManager()->RegisterMeshName(meshobj->GetName(), meshobj);
-	converter.RegisterGameMesh(meshobj, me);
+	converter.RegisterGameMesh(meshobj, conversion.mesh);
+}
+
+/* blenderobj can be nullptr, make sure its checked for */
+KX_Mesh *BL_ConvertMesh(Mesh *me, Object *blenderobj, KX_Scene *scene, BL_SceneConverter& converter)
+{
+	KX_Mesh *meshobj;
 
-	return meshobj;
+	// Without checking names, we get some reuse we don't want that can cause
+	// problems with material LoDs.
+	if (blenderobj && ((meshobj = converter.FindGameMesh(me)) != nullptr)) {
+		const std::string bge_name = meshobj->GetName();
+		const std::string blender_name = ((ID *)blenderobj->data)->name + 2;
+		if (bge_name == blender_name) {
+			return meshobj;
+		}
+	}
+
+	BL_MeshConversion conversion;
+	conversion.mesh = me;
+	BL_ConvertMeshBegin(conversion, blenderobj, scene, converter);
+	BL_ConvertMeshArrays(conversion);
+	BL_ConvertMeshEnd(conversion, scene, converter);
+
+	return conversion.meshobj;
+}
+
+static void convert_mesh_arrays_task(TaskPool *__restrict UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	BL_ConvertMeshArrays(*static_cast<BL_MeshConversion *>(taskdata));
+}
+
+/** Convert ahead all the meshes used by the objects of a scene and their dupli groups
+ * to fill their display arrays in parallel, the objects conversion then finds the meshes
+ * already converted in the scene converter.
+ */
+static void BL_ConvertSceneMeshes(KX_Scene *kxscene, BL_SceneConverter& converter, TaskScheduler *scheduler)
+{
+	Scene *blenderscene = kxscene->GetBlenderScene();
+
+	// The objects in the same order as the objects conversion, the first object using a mesh gives its materials.
+	std::vector<Object *> objects;
+	std::set<Group *> groups;
+
+	Scene *sce_iter;
+	Base *base;
+	for (SETLOOPER(blenderscene, sce_iter, base)) {
+		objects.push_back(base->object);
+	}
+	for (unsigned int i = 0; i < objects.size(); ++i) {
+		Group *group = objects[i]->dup_group;
+		if ((objects[i]->transflag & OB_DUPLIGROUP) && group && groups.insert(group).second) {
+			for (GroupObject *go = (GroupObject *)group->gobject.first; go; go = (GroupObject *)go->next) {
+				objects.push_back(go->ob);
+			}
+		}
+	}
+
+	std::set<Mesh *> meshes;
+	std::vector<BL_MeshConversion> conversions;
+	for (Object *ob : objects) {
+		if (ob->type != OB_MESH) {
+			continue;
+		}
+
+		Mesh *mesh = static_cast<Mesh *>(ob->data);
+		if (!meshes.insert(mesh).second || converter.FindGameMesh(mesh)) {
+			continue;
+		}
+
+		BL_MeshConversion conversion;
+		conversion.mesh = mesh;
+		BL_ConvertMeshBegin(conversion, ob, kxscene, converter);
+		conversions.push_back(std::move(conversion));
+	}
+
+	// Not worth the tasks overhead.
+	if (conversions.size() < 2) {
+		for (BL_MeshConversion& conversion : conversions) {
+			BL_ConvertMeshArrays(conversion);
+		}
+	}
+	else {
+		TaskPool *pool = BLI_task_pool_create(scheduler, nullptr);
+		for (BL_MeshConversion& conversion : conversions) {
+			BLI_task_pool_push(pool, convert_mesh_arrays_task, &conversion, false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+
+	for (BL_MeshConversion& conversion : conversions) {
+		BL_ConvertMeshEnd(conversion, kxscene, converter);
+	}
 }
 
 void BL_ConvertDerivedMeshToArray(DerivedMesh *dm, Mesh *me, const std::vector<BL_MeshMaterial>& mats,
@@ -958,6 +1082,12 @@ static KX_GameObject *BL_GameObjectFromBlenderObject(Object *ob, KX_Scene *kxsce
 	switch (ob->type) {
 		case OB_LAMP:
 		{
+			// Without rasterizer (headless mode) the lamps are only converted as empty objects.
+			if (!rendertools) {
+				gameobj = new KX_EmptyObject();
+				break;
+			}
+
 			KX_LightObject *gamelight = BL_GameLightFromBlenderLamp(static_cast<Lamp *>(ob->data), ob->lay, kxscene, rendertools);
 			gameobj = gamelight;
 			gamelight->AddRef();
@@ -1338,8 +1468,9 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 		{
 			SYS_SystemHandle syshandle = SYS_GetSystem();
 			int visualizePhysics = SYS_GetCommandLineInt(syshandle, "show_physics", 0);
+			int deterministic = SYS_GetCommandLineInt(syshandle, "deterministic", 0);
 
-			phyEnv = CcdPhysicsEnvironment::Create(blenderscene, visualizePhysics);
+			phyEnv = CcdPhysicsEnvironment::Create(blenderscene, visualizePhysics, deterministic);
 			physicsEngine = UseBullet;
 			break;
 		}
@@ -1407,8 +1538,10 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 
 	// Convert world.
 	KX_WorldInfo *worldinfo = new KX_WorldInfo(blenderscene, blenderscene->world);
-	worldinfo->UpdateWorldSettings(rendertools);
-	worldinfo->UpdateBackGround(rendertools);
+	if (rendertools) {
+		worldinfo->UpdateWorldSettings(rendertools);
+		worldinfo->UpdateBackGround(rendertools);
+	}
 	kxscene->SetWorldInfo(worldinfo);
 
 	const bool showObstacleSimulation = (blenderscene->gm.flag & GAME_SHOW_OBSTACLE_SIMULATION) != 0;
@@ -1441,6 +1574,9 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 
 	BL_SetBlenderSceneBackground(blenderscene);
 
+	// Fill the display arrays of all the meshes in parallel before the objects conversion.
+	BL_ConvertSceneMeshes(kxscene, converter, ketsjiEngine->GetTaskScheduler());
+
 	/* Let's support scene set.
 	 * Beware of name conflict in linked data, it will not crash but will create confusion
 	 * in Python scripting and in certain actuators (replace mesh). Linked scene *should* have
@@ -1824,7 +1960,7 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 	logicbrick_conversionlist->Release();
 }
 
-void BL_PostConvertBlenderObjects(KX_Scene *kxscene, const BL_SceneConverter& sceneconverter)
+void BL_PostConvertBlenderObjects(KX_Scene *kxscene, RAS_Rasterizer *rendertools, const BL_SceneConverter& sceneconverter)
 {
 	const std::vector<KX_GameObject *>& sumolist = sceneconverter.GetObjects();
 	EXP_ListValue<KX_GameObject> *objectlist = kxscene->GetObjectList();
@@ -1851,38 +1987,41 @@ void BL_PostConvertBlenderObjects(KX_Scene *kxscene, const BL_SceneConverter& sc
 
 #endif  // WITH_PYTHON
 
-	// Init textures for all materials.
-	for (KX_BlenderMaterial *mat : sceneconverter.GetMaterials()) {
-		mat->InitTextures();
-	}
+	// Without rasterizer (headless mode) no textures are loaded.
+	if (rendertools) {
+		// Init textures for all materials.
+		for (KX_BlenderMaterial *mat : sceneconverter.GetMaterials()) {
+			mat->InitTextures();
+		}
 
-	// Look at every material texture and ask to create realtime map.
-	for (KX_GameObject *gameobj : sumolist) {
-		for (KX_Mesh *mesh : gameobj->GetMeshList()) {
-			for (RAS_MeshMaterial *meshmat : mesh->GetMeshMaterialList()) {
-				RAS_IMaterial *mat = meshmat->GetBucket()->GetMaterial();
-
-				for (unsigned short k = 0; k < RAS_Texture::MaxUnits; ++k) {
-					RAS_Texture *tex = mat->GetTexture(k);
-					if (!tex || !tex->Ok()) {
-						continue;
-					}
+		// Look at every material texture and ask to create realtime map.
+		for (KX_GameObject *gameobj : sumolist) {
+			for (KX_Mesh *mesh : gameobj->GetMeshList()) {
+				for (RAS_MeshMaterial *meshmat : mesh->GetMeshMaterialList()) {
+					RAS_IMaterial *mat = meshmat->GetBucket()->GetMaterial();
+
+					for (unsigned short k = 0; k < RAS_Texture::MaxUnits; ++k) {
+						RAS_Texture *tex = mat->GetTexture(k);
+						if (!tex || !tex->Ok()) {
+							continue;
+						}
 
-					EnvMap *env = tex->GetTex()->env;
-					if (!env || env->stype != ENV_REALT) {
-						continue;
-					}
+						EnvMap *env = tex->GetTex()->env;
+						if (!env || env->stype != ENV_REALT) {
+							continue;
+						}
 
-					KX_GameObject *viewpoint = gameobj;
-					if (env->object) {
-						KX_GameObject *obj = sceneconverter.FindGameObject(env->object);
-						if (obj) {
-							viewpoint = obj;
+						KX_GameObject *viewpoint = gameobj;
+						if (env->object) {
+							KX_GameObject *obj = sceneconverter.FindGameObject(env->object);
+							if (obj) {
+								viewpoint = obj;
+							}
 						}
-					}
 
-					KX_TextureRendererManager::RendererType type = tex->IsCubeMap() ? KX_TextureRendererManager::CUBE : KX_TextureRendererManager::PLANAR;
-					kxscene->GetTextureRendererManager()->AddRenderer(type, tex, viewpoint);
+						KX_TextureRendererManager::RendererType type = tex->IsCubeMap() ? KX_TextureRendererManager::CUBE : KX_TextureRendererManager::PLANAR;
+						kxscene->GetTextureRendererManager()->AddRenderer(type, tex, viewpoint);
+					}
 				}
 			}
 		}
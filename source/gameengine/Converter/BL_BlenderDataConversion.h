@@ -32,6 +32,8 @@ class RAS_Rasterizer;
 class RAS_ICanvas;
 class KX_KetsjiEngine;
 class KX_Scene;
+class KX_Mesh;
+class KX_GameObject;
 class BL_SceneConverter;
 class BL_ActionData;
 struct Mesh;
@@ -63,7 +65,7 @@ void BL_ConvertBlenderObjects(Main *maggie, KX_Scene *kxscene, KX_KetsjiEngine *
 							  RAS_Rasterizer *rendertools, RAS_ICanvas *canvas, BL_SceneConverter& sceneconverter,
                               bool alwaysUseExpandFraming, float camZoom, bool libloading);
 // Non-multithreadable conversion.
-void BL_PostConvertBlenderObjects(KX_Scene *kxscene, const BL_SceneConverter& sceneconverter);
+void BL_PostConvertBlenderObjects(KX_Scene *kxscene, RAS_Rasterizer *rendertools, const BL_SceneConverter& sceneconverter);
 
 
 SCA_IInputDevice::SCA_EnumInputs BL_ConvertKeyCode(int key_code);
@@ -85,6 +85,7 @@
 /* This little block needed for linking to Blender... */
 #include "BKE_text.h"
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
 #include "BLI_math.h"
 #include "BLI_path_util.h"
 
@@ -864,8 +865,14 @@ void BL_ConvertActuators(const char *maggiename,
 
 				unsigned long seedArg = randAct->seed;
 				if (seedArg == 0) {
-					seedArg = (int)(ketsjiEngine->GetRealTime() * 100000.0);
-					seedArg ^= (intptr_t)randAct;
+					// The time and address vary for each run, use the names in deterministic mode.
+					if (ketsjiEngine->GetFlag(KX_KetsjiEngine::DETERMINISTIC)) {
+						seedArg = BLI_ghashutil_strhash_p(blenderobject->id.name) ^ BLI_ghashutil_strhash_p(bact->name);
+					}
+					else {
+						seedArg = (int)(ketsjiEngine->GetRealTime() * 100000.0);
+						seedArg ^= (intptr_t)randAct;
+					}
 				}
 				SCA_RandomActuator::KX_RANDOMACT_MODE modeArg
 				    = SCA_RandomActuator::KX_RANDOMACT_NODEF;
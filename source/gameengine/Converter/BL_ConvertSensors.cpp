@@ -50,6 +50,8 @@
 #include "DNA_controller_types.h"
 #include "DNA_actuator_types.h" /* for SENS_ALL_KEYS ? this define is
                                  * probably misplaced */
+#include "BLI_utildefines.h"
+#include "BLI_ghash.h"
 /* end of blender include block */
 
 #include "RAS_IMaterial.h"
@@ -529,8 +531,14 @@ void BL_ConvertSensors(struct Object *blenderobject,
 						if (eventmgr) {
 							int randomSeed = blenderrndsensor->seed;
 							if (randomSeed == 0) {
-								randomSeed = (int)(kxengine->GetRealTime() * 100000.0);
-								randomSeed ^= (intptr_t)blenderrndsensor;
+								// The time and address vary for each run, use the names in deterministic mode.
+								if (kxengine->GetFlag(KX_KetsjiEngine::DETERMINISTIC)) {
+									randomSeed = BLI_ghashutil_strhash_p(blenderobject->id.name) ^ BLI_ghashutil_strhash_p(sens->name);
+								}
+								else {
+									randomSeed = (int)(kxengine->GetRealTime() * 100000.0);
+									randomSeed ^= (intptr_t)blenderrndsensor;
+								}
 							}
 							gamesensor = new SCA_RandomSensor(eventmgr, gameobj, randomSeed);
 						}
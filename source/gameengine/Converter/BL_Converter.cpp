@@ -46,6 +46,7 @@
 #include "BL_SceneConverter.h"
 #include "BL_BlenderDataConversion.h"
 #include "BL_ConvertObjectInfo.h"
+#include "BL_MeshCache.h"
 #include "BL_ActionActuator.h"
 #include "KX_BlenderMaterial.h"
 
@@ -75,7 +76,11 @@ extern "C" {
 
 #include "BLI_task.h"
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 
+#include "PIL_time.h"
+
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
@@ -120,8 +125,14 @@ void BL_Converter::SceneSlot::Merge(const BL_SceneConverter& converter)
 	}
 }
 
+/// Maximum number of objects merged between two checks of the merge time.
+static const unsigned int mergeObjectCount = 32;
+
 BL_Converter::BL_Converter(Main *maggie, KX_KetsjiEngine *engine, bool alwaysUseExpandFraming, float camZoom)
-	:m_maggie(maggie),
+	:m_mergeState{nullptr, 0, MERGE_STAGE_BEGIN, 0},
+	m_mergeTime(0.004),
+	m_meshCache(new BL_MeshCache()),
+	m_maggie(maggie),
 	m_ketsjiEngine(engine),
 	m_alwaysUseExpandFraming(alwaysUseExpandFraming),
 	m_camZoom(camZoom)
@@ -143,6 +154,8 @@ BL_Converter::~BL_Converter()
 	   Because it needs to lock the mutex, even if there's no active task when it's
 	   in the scene converter destructor. */
 	BLI_task_pool_free(m_threadinfo.m_pool);
+
+	delete m_meshCache;
 }
 
 Scene *BL_Converter::GetBlenderSceneForName(const std::string &name)
@@ -205,7 +218,7 @@ void BL_Converter::ConvertScene(BL_SceneConverter& converter, bool libloading, b
 
 void BL_Converter::PostConvertScene(const BL_SceneConverter& converter)
 {
-	BL_PostConvertBlenderObjects(converter.GetScene(), converter);
+	BL_PostConvertBlenderObjects(converter.GetScene(), m_ketsjiEngine->GetRasterizer(), converter);
 }
 
 void BL_Converter::RemoveScene(KX_Scene *scene)
@@ -214,6 +227,14 @@ void BL_Converter::RemoveScene(KX_Scene *scene)
 	Texture::FreeAllTextures(scene);
 #endif  // WITH_PYTHON
 
+	// Complete the merge of a library in this scene before freeing the scene.
+	if (m_mergeState.m_status && m_mergeState.m_status->GetMergeScene() == scene) {
+		while (!MergeLibraryStep()) {
+		}
+		m_mergeState.m_status->Finish();
+		m_mergeState.m_status = nullptr;
+	}
+
 	/* Delete the meshes as some one of them depends to the data owned by the scene
 	 * e.g the display array bucket owned by the meshes and needed to be unregistered
 	 * from the bucket manager in the scene.
@@ -262,22 +283,140 @@ std::vector<std::string> BL_Converter::GetLibraryNames() const
 	return names;
 }
 
-void BL_Converter::ProcessScheduledLibraries()
+bool BL_Converter::MergeLibraryStep()
 {
-	m_threadinfo.m_mutex.Lock();
-	const std::vector<KX_LibLoadStatus *> mergeQueue = m_mergequeue;
-	m_mergequeue.clear();
-	m_threadinfo.m_mutex.Unlock();
+	MergeState& state = m_mergeState;
+	KX_LibLoadStatus *status = state.m_status;
+	std::vector<BL_SceneConverter>& converters = status->GetSceneConverters();
+	const unsigned int numConverters = converters.size();
+	const unsigned int index = state.m_converter;
+	if (index == numConverters) {
+		return true;
+	}
+
+	const BL_SceneConverter& converter = converters[index];
+	KX_Scene *to = status->GetMergeScene();
+	KX_Scene *from = converter.GetScene();
+	// Part of the merge of the current scene converter done after this step.
+	float stageProgress = 0.0f;
 
-	for (KX_LibLoadStatus *libload : mergeQueue) {
-		KX_Scene *mergeScene = libload->GetMergeScene();
-		std::vector<BL_SceneConverter>& converters = libload->GetSceneConverters();
-		for (const BL_SceneConverter& converter : converters) {
-			MergeScene(mergeScene, converter);
+	switch (state.m_stage) {
+		case MERGE_STAGE_BEGIN:
+		{
+			PostConvertScene(converter);
+			MergeSceneData(to, converter);
+			if (to->MergeSceneBegin(from)) {
+				state.m_stage = MERGE_STAGE_OBJECTS;
+				state.m_index = 0;
+			}
+			else {
+				delete from;
+				++state.m_converter;
+			}
+			stageProgress = 0.1f;
+			break;
+		}
+		case MERGE_STAGE_OBJECTS:
+		{
+			const unsigned int numObjects = from->GetObjectList()->GetCount() + from->GetInactiveList()->GetCount();
+			state.m_index = to->MergeSceneObjects(from, state.m_index, mergeObjectCount);
+			if (state.m_index == numObjects) {
+				state.m_stage = MERGE_STAGE_END;
+			}
+			stageProgress = 0.1f + 0.6f * (float)state.m_index / (float)std::max(numObjects, 1u);
+			break;
+		}
+		case MERGE_STAGE_END:
+		{
+			// The shaders of all the materials depend on the lights of the scene.
+			const bool newLights = (from->GetLightList()->GetCount() > 0);
+			to->MergeSceneEnd(from);
+			delete from;
+
+			if (newLights) {
+				ReloadShaders(to);
+				++state.m_converter;
+				state.m_stage = MERGE_STAGE_BEGIN;
+			}
+			else {
+				state.m_stage = MERGE_STAGE_SHADERS;
+				state.m_index = 0;
+			}
+			stageProgress = 0.8f;
+			break;
+		}
+		case MERGE_STAGE_SHADERS:
+		{
+			// Else only the new materials need their shader, compile one per step.
+			const std::vector<KX_BlenderMaterial *>& materials = converter.m_materials;
+			const unsigned int numMaterials = materials.size();
+			if (!m_ketsjiEngine->GetRasterizer()) {
+				state.m_index = numMaterials;
+			}
+			else if (state.m_index < numMaterials) {
+				materials[state.m_index++]->ReloadMaterial();
+			}
+			if (state.m_index >= numMaterials) {
+				++state.m_converter;
+				state.m_stage = MERGE_STAGE_BEGIN;
+			}
+			stageProgress = 0.8f + 0.2f * (float)state.m_index / (float)std::max(numMaterials, 1u);
+			break;
 		}
+	}
 
-		libload->Finish();
+	if (state.m_converter == numConverters) {
+		return true;
 	}
+	// A new scene converter is merged next.
+	if (state.m_converter != index) {
+		stageProgress = 0.0f;
+	}
+
+	// We'll call conversion 90% and merging 10% for now.
+	status->SetProgress(0.9f + 0.1f * ((float)state.m_converter + stageProgress) / (float)numConverters);
+
+	return false;
+}
+
+void BL_Converter::MergeLibraries(double time)
+{
+	const double endtime = PIL_check_seconds_timer() + time;
+
+	while (true) {
+		// Start merging the next converted library.
+		if (!m_mergeState.m_status) {
+			m_threadinfo.m_mutex.Lock();
+			if (m_mergequeue.empty()) {
+				m_threadinfo.m_mutex.Unlock();
+				break;
+			}
+			m_mergeState = {m_mergequeue.front(), 0, MERGE_STAGE_BEGIN, 0};
+			m_mergequeue.erase(m_mergequeue.begin());
+			m_threadinfo.m_mutex.Unlock();
+		}
+
+		bool merged;
+		{
+			CM_ProfileScope profileScope("LibLoadMerge", m_mergeState.m_status->GetLibraryName().c_str());
+			merged = MergeLibraryStep();
+		}
+
+		if (merged) {
+			m_mergeState.m_status->Finish();
+			m_mergeState.m_status = nullptr;
+		}
+
+		// At least one step is done per frame.
+		if (time > 0.0 && PIL_check_seconds_timer() >= endtime) {
+			break;
+		}
+	}
+}
+
+void BL_Converter::ProcessScheduledLibraries()
+{
+	MergeLibraries(m_mergeTime);
 
 	for (Main *maggie : m_freeQueue) {
 		FreeBlendFileData(maggie);
@@ -290,9 +429,20 @@ void BL_Converter::FinalizeAsyncLoads()
 	// Finish all loading libraries.
 	BLI_task_pool_work_and_wait(m_threadinfo.m_pool);
 	// Merge all libraries data in the current scene, to avoid memory leak of unmerged scenes.
+	MergeLibraries(0.0);
 	ProcessScheduledLibraries();
 }
 
+double BL_Converter::GetMergeTime() const
+{
+	return m_mergeTime;
+}
+
+void BL_Converter::SetMergeTime(double time)
+{
+	m_mergeTime = time;
+}
+
 void BL_Converter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
 {
 	m_threadinfo.m_mutex.Lock();
@@ -305,6 +455,8 @@ void BL_Converter::AsyncConvertTask(TaskPool *pool, void *ptr, int UNUSED(thread
 	KX_LibLoadStatus *status = static_cast<KX_LibLoadStatus *>(ptr);
 	BL_Converter *converter = status->GetConverter();
 
+	CM_ProfileScope profileScope("LibLoadConvert", status->GetLibraryName().c_str());
+
 	std::vector<BL_SceneConverter>& converters = status->GetSceneConverters();
 	for (BL_SceneConverter& sceneConverter : converters) {
 		converter->ConvertScene(sceneConverter, true, false);
@@ -360,6 +512,8 @@ static void load_datablocks(Main *main_tmp, BlendHandle *blendlib, const char *p
 
 KX_LibLoadStatus *BL_Converter::LinkBlendFile(BlendHandle *blendlib, const char *path, char *group, KX_Scene *scene_merge, char **err_str, short options)
 {
+	CM_ProfileScope profileScope("LibLoad", path);
+
 	const int idcode = BKE_idcode_from_name(group);
 	static char err_local[255];
 
@@ -541,6 +695,9 @@ bool BL_Converter::FreeBlendFileData(Main *maggie)
 
 	// For each scene try to remove any usage of ressources from the library.
 	for (KX_Scene *scene : m_ketsjiEngine->CurrentScenes()) {
+		// The parked replicas are not in the object list and could use the library.
+		scene->RemoveObjectPoolsRessources(libraryId);
+
 		// Both list containing all the scene objects.
 		std::array<EXP_ListValue<KX_GameObject> *, 2> allObjects{{scene->GetObjectList(), scene->GetInactiveList()}};
 
@@ -620,7 +777,9 @@ bool BL_Converter::FreeBlendFileData(Main *maggie)
 		}
 
 		// Reload materials cause they used lamps removed now.
-		scene->GetBucketManager()->ReloadMaterials();
+		if (m_ketsjiEngine->GetRasterizer()) {
+			scene->GetBucketManager()->ReloadMaterials();
+		}
 	}
 
 	// Remove and destruct the KX_LibLoadStatus associated to the just free library.
@@ -680,15 +839,27 @@ void BL_Converter::MergeScene(KX_Scene *to, const BL_SceneConverter& converter)
 	MergeSceneData(to, converter);
 
 	KX_Scene *from = converter.GetScene();
+	// The shaders of all the materials depend on the lights of the scene.
+	const bool newLights = (from->GetLightList()->GetCount() > 0);
 	to->MergeScene(from);
 
-	ReloadShaders(to);
+	if (newLights) {
+		ReloadShaders(to);
+	}
+	else {
+		ReloadShaders(converter);
+	}
 
 	delete from;
 }
 
 void BL_Converter::ReloadShaders(KX_Scene *scene)
 {
+	// Without rasterizer (headless mode) the materials have no shaders.
+	if (!m_ketsjiEngine->GetRasterizer()) {
+		return;
+	}
+
 	for (std::unique_ptr<KX_BlenderMaterial>& mat : m_sceneSlots[scene].m_materials) {
 		mat->ReloadMaterial();
 	}
@@ -701,6 +872,10 @@ void BL_Converter::ReloadShaders(KX_Scene *scene)
 
 void BL_Converter::ReloadShaders(const BL_SceneConverter& converter)
 {
+	if (!m_ketsjiEngine->GetRasterizer()) {
+		return;
+	}
+
 	for (KX_BlenderMaterial *mat : converter.m_materials) {
 		mat->ReloadMaterial();
 	}
@@ -784,6 +959,11 @@ KX_Mesh *BL_Converter::ConvertMeshSpecial(KX_Scene *kx_scene, Main *maggie, cons
 	return meshobj;
 }
 
+BL_MeshCache& BL_Converter::GetMeshCache()
+{
+	return *m_meshCache;
+}
+
 void BL_Converter::PrintStats()
 {
 	CM_Message("BGE STATS");
@@ -812,4 +992,9 @@ void BL_Converter::PrintStats()
 	CM_Message("\t materials: " << nummat);
 	CM_Message("\t meshes: " << nummesh);
 	CM_Message("\t actions: " << numacts);
+
+	CM_Message(std::endl << "Library mesh cache:");
+	CM_Message("\t hits: " << m_meshCache->GetHits());
+	CM_Message("\t misses: " << m_meshCache->GetMisses());
+	CM_Message("\t size: " << m_meshCache->GetSize() / 1024 << " KB");
 }
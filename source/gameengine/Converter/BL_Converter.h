@@ -53,6 +53,7 @@ class BL_ConvertObjectInfo;
 class KX_KetsjiEngine;
 class KX_LibLoadStatus;
 class KX_BlenderMaterial;
+class BL_MeshCache;
 class SCA_IActuator;
 class SCA_IController;
 class KX_Mesh;
@@ -97,6 +98,31 @@ private:
 
 	/// List of loaded libraries to merge.
 	std::vector<KX_LibLoadStatus *> m_mergequeue;
+
+	/// Steps of the merge of a scene converter.
+	enum MergeStage {
+		MERGE_STAGE_BEGIN,
+		MERGE_STAGE_OBJECTS,
+		MERGE_STAGE_END,
+		MERGE_STAGE_SHADERS
+	};
+
+	/// State of the library merged over several frames by ProcessScheduledLibraries.
+	struct MergeState {
+		/// The library being merged, nullptr if none.
+		KX_LibLoadStatus *m_status;
+		/// Index of the scene converter being merged.
+		unsigned int m_converter;
+		MergeStage m_stage;
+		/// Index of the next object or material to merge in the current stage.
+		unsigned int m_index;
+	} m_mergeState;
+
+	/// Time in seconds spent per frame to merge the libraries, 0 to merge them at once.
+	double m_mergeTime;
+
+	/// Converted meshes of the libraries, kept to load the same libraries again.
+	BL_MeshCache *m_meshCache;
 	/// List of libraries to free.
 	std::vector<Main *> m_freeQueue;
 
@@ -146,6 +172,15 @@ private:
 	/// Delay library merging to ProcessScheduledLibraries.
 	void AddScenesToMergeQueue(KX_LibLoadStatus *status);
 
+	/** Proceed the next step of the merge of the current library.
+	 * \return True when all the scene converters of the library are merged.
+	 */
+	bool MergeLibraryStep();
+	/** Merge the scheduled libraries.
+	 * \param time The time in seconds to spend merging, 0 to merge all the libraries.
+	 */
+	void MergeLibraries(double time);
+
 	/** Asynchronously convert scenes from a library.
 	 * \param ptr Pointer to the library status.
 	 */
@@ -195,11 +230,17 @@ public:
 
 	KX_Mesh *ConvertMeshSpecial(KX_Scene *kx_scene, Main *maggie, const std::string& name);
 
+	BL_MeshCache& GetMeshCache();
+
 	/// Merge scheduled loaded libraries and remove scheduled libraries.
 	void ProcessScheduledLibraries();
 	/// Wait until all libraries are loaded.
 	void FinalizeAsyncLoads();
 
+	/// Time spent per frame to merge the asynchronously loaded libraries.
+	double GetMergeTime() const;
+	void SetMergeTime(double time);
+
 	void PrintStats();
 
 	// LibLoad Options.
@@ -0,0 +1,225 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_MeshCache.cpp
+ *  \ingroup bgeconv
+ */
+
+
+#include "BL_MeshCache.h"
+
+#include "RAS_DisplayArray.h"
+
+extern "C" {
+#  include "BKE_customdata.h"
+}
+
+#include "DNA_ID.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include <cstring>
+
+/// Maximum memory used by the cached arrays.
+static const size_t maxCacheSize = 256 * 1024 * 1024;
+
+/// Custom data layers used by the conversion, the other layers can contain pointers.
+static const int hashedLayerTypes[] = {CD_MVERT, CD_MEDGE, CD_MPOLY, CD_MLOOP, CD_MLOOPUV, CD_MLOOPCOL, CD_CUSTOMLOOPNORMAL};
+
+static uint64_t mesh_cache_hash(uint64_t hash, const void *data, size_t size)
+{
+	// FNV-1a over 64 bits words then the remaining bytes.
+	const unsigned char *bytes = (const unsigned char *)data;
+	const size_t numWords = size / sizeof(uint64_t);
+	for (size_t i = 0; i < numWords; ++i, bytes += sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(word));
+		hash = (hash ^ word) * 1099511628211ull;
+	}
+	for (size_t i = numWords * sizeof(uint64_t); i < size; ++i, ++bytes) {
+		hash = (hash ^ *bytes) * 1099511628211ull;
+	}
+	return hash;
+}
+
+static uint64_t mesh_cache_hash_layers(uint64_t hash, const CustomData *data, int count)
+{
+	for (int type : hashedLayerTypes) {
+		const int numLayers = CustomData_number_of_layers(data, type);
+		const size_t size = CustomData_sizeof(type) * count;
+		hash = mesh_cache_hash(hash, &numLayers, sizeof(numLayers));
+		for (int i = 0; i < numLayers; ++i) {
+			const void *layer = CustomData_get_layer_n(data, type, i);
+			if (layer) {
+				hash = mesh_cache_hash(hash, layer, size);
+			}
+		}
+	}
+
+	// The tangents are computed from the active uv layer.
+	const int activeUv = CustomData_get_active_layer(data, CD_MLOOPUV);
+	const int activeColor = CustomData_get_active_layer(data, CD_MLOOPCOL);
+	hash = mesh_cache_hash(hash, &activeUv, sizeof(activeUv));
+	hash = mesh_cache_hash(hash, &activeColor, sizeof(activeColor));
+
+	return hash;
+}
+
+static size_t mesh_cache_array_size(const RAS_DisplayArray *array)
+{
+	const RAS_DisplayArray::Format& format = array->GetFormat();
+	const size_t vertexSize = sizeof(mt::vec3_packed) * 2 + sizeof(mt::vec4_packed) + sizeof(mt::vec2_packed) * format.uvSize +
+	                          sizeof(unsigned int) * format.colorSize + sizeof(RAS_VertexInfo);
+	return vertexSize * array->GetVertexCount() +
+	       sizeof(unsigned int) * (array->GetPrimitiveIndexCount() + array->GetTriangleIndexCount());
+}
+
+BL_MeshCache::BL_MeshCache()
+	:m_size(0),
+	m_hits(0),
+	m_misses(0)
+{
+}
+
+BL_MeshCache::~BL_MeshCache() = default;
+
+bool BL_MeshCache::IsCacheable(Mesh *mesh)
+{
+	// Only the meshes from libraries can be loaded again.
+	return (mesh->id.lib != nullptr);
+}
+
+std::string BL_MeshCache::GetName(Mesh *mesh)
+{
+	return std::string(mesh->id.lib->name) + mesh->id.name;
+}
+
+uint64_t BL_MeshCache::Hash(Mesh *mesh, const std::vector<BL_MeshMaterial>& mats)
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	const int counts[] = {mesh->totvert, mesh->totedge, mesh->totpoly, mesh->totloop};
+	hash = mesh_cache_hash(hash, counts, sizeof(counts));
+
+	// Settings of the normals computation.
+	const short autoSmooth = (mesh->flag & ME_AUTOSMOOTH);
+	hash = mesh_cache_hash(hash, &autoSmooth, sizeof(autoSmooth));
+	hash = mesh_cache_hash(hash, &mesh->smoothresh, sizeof(mesh->smoothresh));
+
+	hash = mesh_cache_hash_layers(hash, &mesh->vdata, mesh->totvert);
+	hash = mesh_cache_hash_layers(hash, &mesh->edata, mesh->totedge);
+	hash = mesh_cache_hash_layers(hash, &mesh->pdata, mesh->totpoly);
+	hash = mesh_cache_hash_layers(hash, &mesh->ldata, mesh->totloop);
+
+	// The materials change the vertex format, the primitive type and the indices.
+	for (const BL_MeshMaterial& mat : mats) {
+		const RAS_DisplayArray::Format& format = mat.array->GetFormat();
+		const unsigned char settings[] = {format.uvSize, format.colorSize, mat.visible, mat.wire,
+		                                  (unsigned char)mat.array->GetPrimitiveType()};
+		hash = mesh_cache_hash(hash, settings, sizeof(settings));
+	}
+
+	return hash;
+}
+
+bool BL_MeshCache::Restore(Mesh *mesh, uint64_t hash, const std::vector<BL_MeshMaterial>& mats)
+{
+	const std::string name = GetName(mesh);
+
+	m_mutex.Lock();
+	const auto it = m_entries.find(name);
+	std::shared_ptr<const Entry> entry;
+	if (it != m_entries.end() && it->second->m_hash == hash && it->second->m_arrays.size() == mats.size()) {
+		entry = it->second;
+		++m_hits;
+	}
+	else {
+		++m_misses;
+	}
+	m_mutex.Unlock();
+
+	if (!entry) {
+		return false;
+	}
+
+	for (unsigned int i = 0, size = mats.size(); i < size; ++i) {
+		mats[i].array->CopyData(*entry->m_arrays[i]);
+	}
+
+	return true;
+}
+
+void BL_MeshCache::Store(Mesh *mesh, uint64_t hash, const std::vector<BL_MeshMaterial>& mats)
+{
+	std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+	entry->m_hash = hash;
+	entry->m_size = 0;
+	for (const BL_MeshMaterial& mat : mats) {
+		entry->m_arrays.emplace_back(new RAS_DisplayArray(*mat.array));
+		entry->m_size += mesh_cache_array_size(mat.array);
+	}
+
+	// Don't remove all the cache for a single mesh.
+	if (entry->m_size > maxCacheSize / 2) {
+		return;
+	}
+
+	const std::string name = GetName(mesh);
+
+	m_mutex.Lock();
+	RemoveEntry(name);
+
+	while (m_size + entry->m_size > maxCacheSize) {
+		const std::string oldest = m_order.front();
+		RemoveEntry(oldest);
+	}
+
+	m_size += entry->m_size;
+	m_entries[name] = entry;
+	m_order.push_back(name);
+	m_mutex.Unlock();
+}
+
+void BL_MeshCache::RemoveEntry(const std::string& name)
+{
+	const auto it = m_entries.find(name);
+	if (it == m_entries.end()) {
+		return;
+	}
+
+	m_size -= it->second->m_size;
+	m_entries.erase(it);
+	m_order.remove(name);
+}
+
+unsigned int BL_MeshCache::GetHits() const
+{
+	return m_hits;
+}
+
+unsigned int BL_MeshCache::GetMisses() const
+{
+	return m_misses;
+}
+
+size_t BL_MeshCache::GetSize() const
+{
+	return m_size;
+}
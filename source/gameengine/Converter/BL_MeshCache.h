@@ -0,0 +1,104 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_MeshCache.h
+ *  \ingroup bgeconv
+ */
+
+
+#ifndef __BL_MESH_CACHE_H__
+#define __BL_MESH_CACHE_H__
+
+#include "BL_BlenderDataConversion.h"
+
+#include "CM_Thread.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class RAS_DisplayArray;
+struct Mesh;
+
+/** Cache of the display arrays converted from the meshes of the loaded libraries.
+ * A mesh is identified by its library path and name, the arrays are reused only if
+ * the hash of the mesh data and conversion settings didn't change since they were
+ * stored. Reloading a library then copies the arrays instead of converting again.
+ * The oldest meshes are removed when the cache is too big.
+ * The cache is thread safe.
+ */
+class BL_MeshCache
+{
+public:
+	BL_MeshCache();
+	~BL_MeshCache();
+
+	/// Return true if the converted arrays of this mesh can be cached.
+	static bool IsCacheable(Mesh *mesh);
+
+	/** Compute the hash of the data of a mesh used by its conversion.
+	 * \param mesh The blender mesh.
+	 * \param mats The display arrays and settings of each material of the mesh.
+	 */
+	static uint64_t Hash(Mesh *mesh, const std::vector<BL_MeshMaterial>& mats);
+
+	/** Fill the display arrays of a mesh from the cache.
+	 * \return True if the mesh was found with the same hash.
+	 */
+	bool Restore(Mesh *mesh, uint64_t hash, const std::vector<BL_MeshMaterial>& mats);
+	/// Store a copy of the converted display arrays of a mesh.
+	void Store(Mesh *mesh, uint64_t hash, const std::vector<BL_MeshMaterial>& mats);
+
+	/// Number of meshes restored from the cache.
+	unsigned int GetHits() const;
+	/// Number of meshes not found or outdated in the cache.
+	unsigned int GetMisses() const;
+	/// Memory used by the cached arrays in bytes.
+	size_t GetSize() const;
+
+private:
+	struct Entry
+	{
+		uint64_t m_hash;
+		size_t m_size;
+		std::vector<std::unique_ptr<RAS_DisplayArray> > m_arrays;
+	};
+
+	/// Unique name of a mesh among all the libraries.
+	static std::string GetName(Mesh *mesh);
+
+	/// Remove an entry and its name in the insertion order.
+	void RemoveEntry(const std::string& name);
+
+	/// Shared entries to copy the arrays out of the lock while an entry is replaced.
+	std::unordered_map<std::string, std::shared_ptr<const Entry> > m_entries;
+	/// Names of the entries from the oldest to the newest.
+	std::list<std::string> m_order;
+	size_t m_size;
+	CM_ThreadMutex m_mutex;
+
+	unsigned int m_hits;
+	unsigned int m_misses;
+};
+
+#endif  // __BL_MESH_CACHE_H__
@@ -0,0 +1,264 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_PoseCache.cpp
+ *  \ingroup bgeconv
+ */
+
+#include "BL_PoseCache.h"
+
+extern "C" {
+#  include "BLI_listbase.h"
+#  include "BLI_math_matrix.h"
+#  include "BLI_math_vector.h"
+#  include "BKE_armature.h"
+}
+
+#include "DNA_action_types.h"
+#include "DNA_object_types.h"
+
+#include <cstring>
+
+/// Number of floats of the local transform of a channel stored in a key.
+static const unsigned short channelKeySize = 28;
+
+static void pose_cache_channel_key(const bPoseChannel *pchan, std::vector<float>& transforms)
+{
+	transforms.insert(transforms.end(), pchan->loc, pchan->loc + 3);
+	transforms.insert(transforms.end(), pchan->size, pchan->size + 3);
+	transforms.insert(transforms.end(), pchan->eul, pchan->eul + 3);
+	transforms.insert(transforms.end(), pchan->quat, pchan->quat + 4);
+	transforms.insert(transforms.end(), pchan->rotAxis, pchan->rotAxis + 3);
+	// B-Bone settings can be animated as the transforms.
+	transforms.insert(transforms.end(), {pchan->rotAngle, (float)pchan->rotmode, pchan->roll1, pchan->roll2,
+	                                     pchan->curveInX, pchan->curveInY, pchan->curveOutX, pchan->curveOutY,
+	                                     pchan->ease1, pchan->ease2, pchan->scaleIn, pchan->scaleOut});
+}
+
+static const float *pose_cache_channel_set(bPoseChannel *pchan, const float *transforms)
+{
+	copy_v3_v3(pchan->loc, transforms);
+	copy_v3_v3(pchan->size, transforms + 3);
+	copy_v3_v3(pchan->eul, transforms + 6);
+	copy_v4_v4(pchan->quat, transforms + 9);
+	copy_v3_v3(pchan->rotAxis, transforms + 13);
+	pchan->rotAngle = transforms[16];
+	pchan->rotmode = (short)transforms[17];
+	pchan->roll1 = transforms[18];
+	pchan->roll2 = transforms[19];
+	pchan->curveInX = transforms[20];
+	pchan->curveInY = transforms[21];
+	pchan->curveOutX = transforms[22];
+	pchan->curveOutY = transforms[23];
+	pchan->ease1 = transforms[24];
+	pchan->ease2 = transforms[25];
+	pchan->scaleIn = transforms[26];
+	pchan->scaleOut = transforms[27];
+
+	return transforms + channelKeySize;
+}
+
+static void pose_cache_pose_key(const bPose *pose, std::vector<float>& transforms)
+{
+	transforms.reserve(transforms.size() + BLI_listbase_count(&pose->chanbase) * channelKeySize);
+	for (const bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		pose_cache_channel_key(pchan, transforms);
+	}
+}
+
+bool BL_PoseCache::Key::operator==(const Key& other) const
+{
+	return (m_armature == other.m_armature && m_actions == other.m_actions && m_transforms == other.m_transforms);
+}
+
+size_t BL_PoseCache::KeyHash::operator()(const Key& key) const
+{
+	// FNV-1a over the actions and the bits of the transforms.
+	size_t hash = std::hash<Object *>()(key.m_armature) ^ 2166136261u;
+	for (bAction *action : key.m_actions) {
+		hash = (hash ^ std::hash<bAction *>()(action)) * 16777619u;
+	}
+	for (float value : key.m_transforms) {
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		hash = (hash ^ bits) * 16777619u;
+	}
+	return hash;
+}
+
+BL_PoseCache::BL_PoseCache()
+	:m_hits(0),
+	m_misses(0),
+	m_actionHits(0),
+	m_actionMisses(0)
+{
+}
+
+void BL_PoseCache::Clear()
+{
+	m_entries.clear();
+	m_actionEntries.clear();
+}
+
+void BL_PoseCache::ApplyPose(Object *origArmature, Object *armature, Scene *scene)
+{
+	bPose *pose = armature->pose;
+	// The channels must be rebuilt by BKE_pose_where_is before reading them.
+	if (!pose || (pose->flag & POSE_RECALC)) {
+		BKE_pose_where_is(scene, armature);
+		return;
+	}
+
+	Key key;
+	key.m_armature = origArmature;
+	pose_cache_pose_key(pose, key.m_transforms);
+
+	m_mutex.Lock();
+	const std::pair<std::unordered_map<Key, Entry, KeyHash>::iterator, bool> result =
+		m_entries.emplace(std::move(key), Entry{false, {}});
+	Entry& entry = result.first->second;
+	const bool owner = result.second;
+	const bool ready = entry.m_ready;
+	if (ready) {
+		++m_hits;
+	}
+	else {
+		++m_misses;
+	}
+	m_mutex.Unlock();
+
+	/* The entry is never modified once ready and the references to the
+	 * elements of an unordered map are kept on insertion. */
+	if (ready) {
+		const ChannelMatrices *matrices = entry.m_channels.data();
+		for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next, ++matrices) {
+			memcpy(pchan->chan_mat, matrices->m_chanMat, sizeof(pchan->chan_mat));
+			memcpy(pchan->pose_mat, matrices->m_poseMat, sizeof(pchan->pose_mat));
+			copy_v3_v3(pchan->pose_head, matrices->m_poseHead);
+			copy_v3_v3(pchan->pose_tail, matrices->m_poseTail);
+		}
+		// As done by BKE_pose_where_is.
+		invert_m4_m4(armature->imat, armature->obmat);
+		return;
+	}
+
+	BKE_pose_where_is(scene, armature);
+
+	// An other armature is already evaluating this pose.
+	if (!owner) {
+		return;
+	}
+
+	std::vector<ChannelMatrices> channels;
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		ChannelMatrices matrices;
+		copy_m4_m4(matrices.m_chanMat, pchan->chan_mat);
+		copy_m4_m4(matrices.m_poseMat, pchan->pose_mat);
+		copy_v3_v3(matrices.m_poseHead, pchan->pose_head);
+		copy_v3_v3(matrices.m_poseTail, pchan->pose_tail);
+		channels.push_back(matrices);
+	}
+
+	m_mutex.Lock();
+	entry.m_channels = std::move(channels);
+	entry.m_ready = true;
+	m_mutex.Unlock();
+}
+
+bool BL_PoseCache::GetActionPose(Key&& key, Object *origArmature, Object *armature, ActionEntry *& entry)
+{
+	entry = nullptr;
+
+	bPose *pose = armature->pose;
+	// The channels must be rebuilt by BKE_pose_where_is before reading them.
+	if (!pose || (pose->flag & POSE_RECALC)) {
+		return false;
+	}
+
+	key.m_armature = origArmature;
+	pose_cache_pose_key(pose, key.m_transforms);
+
+	m_mutex.Lock();
+	const std::pair<std::unordered_map<Key, ActionEntry, KeyHash>::iterator, bool> result =
+		m_actionEntries.emplace(std::move(key), ActionEntry{false, {}});
+	ActionEntry& found = result.first->second;
+	const bool ready = found.m_ready;
+	if (ready) {
+		++m_actionHits;
+	}
+	else {
+		++m_actionMisses;
+	}
+	m_mutex.Unlock();
+
+	if (!ready) {
+		// Only the first armature using the key stores its transforms.
+		if (result.second) {
+			entry = &found;
+		}
+		return false;
+	}
+
+	const float *transforms = found.m_transforms.data();
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		transforms = pose_cache_channel_set(pchan, transforms);
+	}
+
+	return true;
+}
+
+void BL_PoseCache::StoreActionPose(ActionEntry *entry, Object *armature)
+{
+	std::vector<float> transforms;
+	pose_cache_pose_key(armature->pose, transforms);
+
+	m_mutex.Lock();
+	entry->m_transforms = std::move(transforms);
+	entry->m_ready = true;
+	m_mutex.Unlock();
+}
+
+unsigned int BL_PoseCache::GetHits() const
+{
+	return m_hits;
+}
+
+unsigned int BL_PoseCache::GetMisses() const
+{
+	return m_misses;
+}
+
+unsigned int BL_PoseCache::GetActionHits() const
+{
+	return m_actionHits;
+}
+
+unsigned int BL_PoseCache::GetActionMisses() const
+{
+	return m_actionMisses;
+}
+
+void BL_PoseCache::ResetStats()
+{
+	m_hits = 0;
+	m_misses = 0;
+	m_actionHits = 0;
+	m_actionMisses = 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_PoseCache.h
+ *  \ingroup bgeconv
+ */
+
+#ifndef __BL_POSE_CACHE_H__
+#define __BL_POSE_CACHE_H__
+
+#include "CM_Thread.h"
+
+#include <unordered_map>
+#include <vector>
+
+struct bAction;
+struct Object;
+struct Scene;
+
+/** Cache of the evaluated poses of the armatures instanced from a same armature.
+ * A pose is identified by the original armature and the local transforms of all
+ * its channels, armatures with the same key share the evaluated matrices instead
+ * of calling BKE_pose_where_is. Before that, the armatures playing the same actions
+ * at the same frames from the same pose share the local transforms set by the actions
+ * instead of evaluating them. The armatures using constraints depend on other
+ * objects and must not use the cache.
+ * The cache is thread safe and cleared before each animation update.
+ */
+class BL_PoseCache
+{
+public:
+	struct Key
+	{
+		Object *m_armature;
+		/// Actions applied to the pose, empty for the evaluated matrices.
+		std::vector<bAction *> m_actions;
+		/// Local transforms of all the channels, preceded by the state of the actions.
+		std::vector<float> m_transforms;
+
+		bool operator==(const Key& other) const;
+	};
+
+	struct ActionEntry
+	{
+		/// False while the actions are evaluated by the first armature using this key.
+		bool m_ready;
+		/// Local transforms of all the channels after the actions.
+		std::vector<float> m_transforms;
+	};
+
+	BL_PoseCache();
+	~BL_PoseCache() = default;
+
+	/// Remove all the cached poses.
+	void Clear();
+
+	/** Evaluate the pose of an armature or copy it from a cached pose.
+	 * \param origArmature The original armature shared by the instances.
+	 * \param armature The armature object owning the pose to evaluate.
+	 * \param scene The scene used by BKE_pose_where_is.
+	 */
+	void ApplyPose(Object *origArmature, Object *armature, Scene *scene);
+
+	/** Copy the local transforms set by the actions of an armature from the cache.
+	 * \param key The actions and their state, see BL_Action::GetPoseKey. The pose
+	 * of the armature before the actions is appended to it.
+	 * \param origArmature The original armature shared by the instances.
+	 * \param armature The armature object owning the pose before the actions.
+	 * \param entry Set to the entry to fill with StoreActionPose once the actions are
+	 * evaluated when the caller is the first to use this key, else nullptr.
+	 * \return True if the transforms were copied and the actions must not be evaluated.
+	 */
+	bool GetActionPose(Key&& key, Object *origArmature, Object *armature, ActionEntry *& entry);
+	/// Store the local transforms of an armature after the evaluation of its actions.
+	void StoreActionPose(ActionEntry *entry, Object *armature);
+
+	/// Number of poses copied from the cache since the last reset of the statistics.
+	unsigned int GetHits() const;
+	/// Number of poses evaluated since the last reset of the statistics.
+	unsigned int GetMisses() const;
+	/// Number of actions poses copied from the cache since the last reset of the statistics.
+	unsigned int GetActionHits() const;
+	/// Number of actions poses evaluated since the last reset of the statistics.
+	unsigned int GetActionMisses() const;
+	void ResetStats();
+
+private:
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	struct ChannelMatrices
+	{
+		float m_chanMat[4][4];
+		float m_poseMat[4][4];
+		float m_poseHead[3];
+		float m_poseTail[3];
+	};
+
+	struct Entry
+	{
+		/// False while the pose is evaluated by the first armature using this key.
+		bool m_ready;
+		std::vector<ChannelMatrices> m_channels;
+	};
+
+	std::unordered_map<Key, Entry, KeyHash> m_entries;
+	std::unordered_map<Key, ActionEntry, KeyHash> m_actionEntries;
+	CM_ThreadMutex m_mutex;
+
+	unsigned int m_hits;
+	unsigned int m_misses;
+	unsigned int m_actionHits;
+	unsigned int m_actionMisses;
+};
+
+#endif  // __BL_POSE_CACHE_H__
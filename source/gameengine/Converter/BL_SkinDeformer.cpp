@@ -128,9 +128,27 @@ void BL_SkinDeformer::BlenderDeformVerts(bool recalcNormal)
 	}
 }
 
-void BL_SkinDeformer::BGEDeformVerts(bool recalcNormal)
+void BL_SkinDeformer::VerifyChannels()
 {
+	if (!m_dfnrToPC.empty()) {
+		return;
+	}
+
 	Object *par_arma = m_armobj->GetArmatureObject();
+	m_dfnrToPC.resize(BLI_listbase_count(&m_objMesh->defbase));
+	int i;
+	bDeformGroup *dg;
+	for (i = 0, dg = (bDeformGroup *)m_objMesh->defbase.first; dg; ++i, dg = dg->next) {
+		m_dfnrToPC[i] = BKE_pose_channel_find_name(par_arma->pose, dg->name);
+
+		if (m_dfnrToPC[i] && m_dfnrToPC[i]->bone->flag & BONE_NO_DEFORM) {
+			m_dfnrToPC[i] = nullptr;
+		}
+	}
+}
+
+void BL_SkinDeformer::BGEDeformVerts(bool recalcNormal)
+{
 	MDeformVert *dverts = m_bmesh->dvert;
 	Eigen::Matrix4f pre_mat, post_mat, chan_mat, norm_chan_mat;
 
@@ -138,20 +156,9 @@ void BL_SkinDeformer::BGEDeformVerts(bool recalcNormal)
 		return;
 	}
 
-	const unsigned short defbase_tot = BLI_listbase_count(&m_objMesh->defbase);
+	VerifyChannels();
 
-	if (m_dfnrToPC.empty()) {
-		m_dfnrToPC.resize(defbase_tot);
-		int i;
-		bDeformGroup *dg;
-		for (i = 0, dg = (bDeformGroup *)m_objMesh->defbase.first; dg; ++i, dg = dg->next) {
-			m_dfnrToPC[i] = BKE_pose_channel_find_name(par_arma->pose, dg->name);
-
-			if (m_dfnrToPC[i] && m_dfnrToPC[i]->bone->flag & BONE_NO_DEFORM) {
-				m_dfnrToPC[i] = nullptr;
-			}
-		}
-	}
+	const unsigned short defbase_tot = m_dfnrToPC.size();
 
 	post_mat = Eigen::Matrix4f::Map((float *)m_obmat).inverse() * Eigen::Matrix4f::Map((float *)m_armobj->GetArmatureObject()->obmat);
 	pre_mat = post_mat.inverse();
@@ -216,6 +223,92 @@ void BL_SkinDeformer::BGEDeformVerts(bool recalcNormal)
 	m_copyNormals = true;
 }
 
+void BL_SkinDeformer::BuildSkinLayout()
+{
+	VerifyChannels();
+
+	m_skinLayout.Clear();
+	m_skinChannels.clear();
+
+	// Layout bone of each deform group, 0 for the groups without deforming channel.
+	std::vector<unsigned short> groupBones(m_dfnrToPC.size(), 0);
+	for (unsigned int i = 0, size = m_dfnrToPC.size(); i < size; ++i) {
+		if (m_dfnrToPC[i]) {
+			m_skinChannels.push_back(m_dfnrToPC[i]);
+			groupBones[i] = m_skinChannels.size();
+		}
+	}
+
+	std::vector<unsigned short> bones;
+	std::vector<float> weights;
+	MDeformVert *dv = m_bmesh->dvert;
+	for (int i = 0; i < m_bmesh->totvert; ++i, ++dv) {
+		bones.clear();
+		weights.clear();
+
+		MDeformWeight *dw = dv->dw;
+		for (unsigned int j = dv->totweight; j != 0; j--, dw++) {
+			const unsigned int index = dw->def_nr;
+			if (index < groupBones.size() && groupBones[index] != 0) {
+				bones.push_back(groupBones[index]);
+				weights.push_back(dw->weight);
+			}
+		}
+
+		mt::vec3_packed normal;
+		normal_short_to_float_v3(normal.data, m_bmesh->mvert[i].no);
+		m_skinLayout.AddVertex(bones.data(), weights.data(), bones.size(), normal);
+	}
+
+	m_skinMatrices.resize(m_skinChannels.size() + 1);
+	m_skinMatrices[0] = mt::mat4::Identity();
+
+	m_skinDualQuats.resize(m_skinChannels.size() + 1);
+	DualQuat& identity = m_skinDualQuats[0];
+	memset(&identity, 0, sizeof(DualQuat));
+	unit_qt(identity.quat);
+}
+
+void BL_SkinDeformer::BGESimdDeformVerts(bool recalcNormal)
+{
+	if (!m_bmesh->dvert) {
+		return;
+	}
+
+	if (m_skinLayout.GetVertexCount() != (unsigned int)m_bmesh->totvert) {
+		BuildSkinLayout();
+	}
+
+	const mt::mat4 post_mat = mt::mat4(m_obmat).Inverse() * mt::mat4(m_armobj->GetArmatureObject()->obmat);
+	const mt::mat4 pre_mat = post_mat.Inverse();
+
+	// Compute the skinning matrices once per bone instead of once per vertex weight.
+	for (unsigned int i = 0, size = m_skinChannels.size(); i < size; ++i) {
+		m_skinMatrices[i + 1] = post_mat * mt::mat4(m_skinChannels[i]->chan_mat) * pre_mat;
+	}
+
+	mt::vec3_packed *normals = recalcNormal ? m_transnors.data() : nullptr;
+
+	// Volume preservation of the armature modifier, use dual quaternion skinning.
+	if (m_deformflags & ARM_DEF_QUATERNION) {
+		for (unsigned int i = 0, size = m_skinChannels.size(); i < size; ++i) {
+			// The rest matrix of the bone in the mesh space separates the bone scale from its rotation.
+			float skinmat[4][4];
+			float restmat[4][4];
+			m_skinMatrices[i + 1].Pack(skinmat);
+			(post_mat * mt::mat4(m_skinChannels[i]->bone->arm_mat)).Pack(restmat);
+			mat4_to_dquat(&m_skinDualQuats[i + 1], restmat, skinmat);
+		}
+
+		m_skinLayout.DeformDualQuaternion(m_skinDualQuats, m_transverts.data(), normals);
+	}
+	else {
+		m_skinLayout.Deform(m_skinMatrices, m_transverts.data(), normals);
+	}
+
+	m_copyNormals = true;
+}
+
 void BL_SkinDeformer::UpdateTransverts()
 {
 	if (m_transverts.empty()) {
@@ -237,22 +330,26 @@ void BL_SkinDeformer::UpdateTransverts()
 		// copy the untransformed data from the original mvert
 		for (unsigned int i = 0, size = array->GetVertexCount(); i < size; ++i) {
 			const RAS_VertexInfo& vinfo = array->GetVertexInfo(i);
-			const mt::vec3 pos = mt::vec3(m_transverts[vinfo.GetOrigIndex()]);
-			array->SetPosition(i, pos);
+			const mt::vec3_packed& pos = m_transverts[vinfo.GetOrigIndex()];
+			array->GetPosition(i) = pos;
 
 			if (autoUpdate) {
-				aabbMin = mt::vec3::Min(aabbMin, pos);
-				aabbMax = mt::vec3::Max(aabbMax, pos);
+				aabbMin = mt::vec3::Min(aabbMin, mt::vec3(pos.data));
+				aabbMax = mt::vec3::Max(aabbMax, mt::vec3(pos.data));
 			}
 		}
+
+		// Upload the normals only when they were deformed.
+		unsigned int modifiedFlag = RAS_DisplayArray::POSITION_MODIFIED;
 		if (m_copyNormals) {
 			for (unsigned int i = 0, size = array->GetVertexCount(); i < size; ++i) {
 				const RAS_VertexInfo& vinfo = array->GetVertexInfo(i);
-				array->SetNormal(i, m_transnors[vinfo.GetOrigIndex()]);
+				array->GetNormal(i) = m_transnors[vinfo.GetOrigIndex()];
 			}
+			modifiedFlag |= RAS_DisplayArray::NORMAL_MODIFIED;
 		}
 
-		array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED | RAS_DisplayArray::NORMAL_MODIFIED);
+		array->NotifyUpdate(modifiedFlag);
 	}
 
 	m_boundingBox->SetAabb(aabbMin, aabbMax);
@@ -273,11 +370,22 @@ bool BL_SkinDeformer::UpdateInternal(bool shape_applied, bool recalcNormal)
 
 		m_armobj->ApplyPose();
 
-		if (m_armobj->GetVertDeformType() == ARM_VDEF_BGE_CPU) {
-			BGEDeformVerts(recalcNormal);
-		}
-		else {
-			BlenderDeformVerts(recalcNormal);
+		switch (m_armobj->GetVertDeformType()) {
+			case ARM_VDEF_BGE_CPU:
+			{
+				BGEDeformVerts(recalcNormal);
+				break;
+			}
+			case ARM_VDEF_BGE_CPU_SIMD:
+			{
+				BGESimdDeformVerts(recalcNormal);
+				break;
+			}
+			default:
+			{
+				BlenderDeformVerts(recalcNormal);
+				break;
+			}
 		}
 
 		/* Update the current frame */
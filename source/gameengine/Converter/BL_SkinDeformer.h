@@ -30,6 +30,7 @@
 
 #include "BL_MeshDeformer.h"
 #include "BL_ArmatureObject.h"
+#include "BL_SkinLayout.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -80,8 +81,23 @@ protected:
 	std::vector<bPoseChannel *> m_dfnrToPC;
 	short m_deformflags;
 
+	/// Compact influences used by BGESimdDeformVerts, built on first use.
+	BL_SkinLayout m_skinLayout;
+	/// Deforming channels of the layout, the bone i of the layout is the channel i - 1.
+	std::vector<bPoseChannel *> m_skinChannels;
+	/// Skinning matrices of the layout bones updated each deformation.
+	BL_SkinLayout::MatrixList m_skinMatrices;
+	/// Dual quaternions of the layout bones, used when the armature modifier preserves volume.
+	BL_SkinLayout::DualQuatList m_skinDualQuats;
+
+	/// Map the deform groups to the deforming pose channels.
+	void VerifyChannels();
+	void BuildSkinLayout();
+
 	void BlenderDeformVerts(bool recalcNormal);
 	void BGEDeformVerts(bool recalcNormal);
+	/// Deform the vertices in parallel with at most four bones per vertex.
+	void BGESimdDeformVerts(bool recalcNormal);
 
 	virtual void UpdateTransverts();
 };
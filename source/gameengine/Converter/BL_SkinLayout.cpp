@@ -0,0 +1,249 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_SkinLayout.cpp
+ *  \ingroup bgeconv
+ */
+
+#include "BL_SkinLayout.h"
+
+#include "BLI_math_matrix.h"
+
+#include "vectorial/simd4f.h"
+
+#include "tbb/tbb.h"
+
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+/// Number of vertices deformed by a task.
+static const unsigned int deformGrainSize = 1024;
+
+/// Number of floats of a packed dual quaternion: real part, dual part and scale matrix.
+static const unsigned short dualQuatSize = 24;
+
+void BL_SkinLayout::Clear()
+{
+	m_bones.clear();
+	m_weights.clear();
+	m_normals.clear();
+}
+
+void BL_SkinLayout::AddVertex(const unsigned short *bones, const float *weights, unsigned int count, const mt::vec3_packed& normal)
+{
+	std::pair<float, unsigned short> influences[MAX_INFLUENCES];
+	unsigned short numInfluences = 0;
+
+	// Keep the most influent bones sorted by decreasing weight.
+	for (unsigned int i = 0; i < count; ++i) {
+		const float weight = weights[i];
+		if (weight <= 0.0f || (numInfluences == MAX_INFLUENCES && weight <= influences[MAX_INFLUENCES - 1].first)) {
+			continue;
+		}
+
+		unsigned short j = (numInfluences < MAX_INFLUENCES) ? numInfluences++ : MAX_INFLUENCES - 1;
+		for (; j > 0 && influences[j - 1].first < weight; --j) {
+			influences[j] = influences[j - 1];
+		}
+		influences[j] = std::make_pair(weight, bones[i]);
+	}
+
+	float total = 0.0f;
+	for (unsigned short i = 0; i < numInfluences; ++i) {
+		total += influences[i].first;
+	}
+
+	// Vertex without influence, use the identity bone.
+	if (numInfluences == 0) {
+		influences[0] = std::make_pair(1.0f, 0);
+		numInfluences = 1;
+		total = 1.0f;
+	}
+
+	for (unsigned short i = 0; i < MAX_INFLUENCES; ++i) {
+		if (i < numInfluences) {
+			m_bones.push_back(influences[i].second);
+			m_weights.push_back(influences[i].first / total);
+		}
+		else {
+			m_bones.push_back(0);
+			m_weights.push_back(0.0f);
+		}
+	}
+
+	m_normals.push_back(normal);
+}
+
+unsigned int BL_SkinLayout::GetVertexCount() const
+{
+	return m_normals.size();
+}
+
+/// Normalize a blended normal, a null normal is kept.
+static inline simd4f normalizeNormal(simd4f no)
+{
+	const float len2 = simd4f_dot3_scalar(no, no);
+	return (len2 > 0.0f) ? simd4f_mul(no, simd4f_splat(1.0f / sqrtf(len2))) : no;
+}
+
+void BL_SkinLayout::Deform(const MatrixList& matrices, mt::vec3_packed *positions, mt::vec3_packed *normals) const
+{
+	// Pack the matrices columns for the loads of the kernel.
+	std::vector<float> columns(matrices.size() * 16);
+	for (unsigned int i = 0, size = matrices.size(); i < size; ++i) {
+		matrices[i].Pack(&columns[i * 16]);
+	}
+
+	tbb::parallel_for(tbb::blocked_range<unsigned int>(0, GetVertexCount(), deformGrainSize),
+		[this, &columns, positions, normals](const tbb::blocked_range<unsigned int>& r) {
+		for (unsigned int i = r.begin(), end = r.end(); i < end; ++i) {
+			const unsigned short *bones = &m_bones[i * MAX_INFLUENCES];
+			const float *weights = &m_weights[i * MAX_INFLUENCES];
+
+			float *pos = positions[i].data;
+			const float *restnor = m_normals[i].data;
+			const simd4f px = simd4f_splat(pos[0]);
+			const simd4f py = simd4f_splat(pos[1]);
+			const simd4f pz = simd4f_splat(pos[2]);
+			const simd4f nx = simd4f_splat(restnor[0]);
+			const simd4f ny = simd4f_splat(restnor[1]);
+			const simd4f nz = simd4f_splat(restnor[2]);
+
+			/* Blend the position and normal transformed by each bone, the unused influences
+			 * have a null weight and are computed anyway to avoid branches. */
+			simd4f co = simd4f_zero();
+			simd4f no = simd4f_zero();
+			for (unsigned short j = 0; j < MAX_INFLUENCES; ++j) {
+				const float *mat = &columns[bones[j] * 16];
+				const simd4f weight = simd4f_splat(weights[j]);
+				const simd4f col0 = simd4f_uload4(mat);
+				const simd4f col1 = simd4f_uload4(mat + 4);
+				const simd4f col2 = simd4f_uload4(mat + 8);
+				const simd4f col3 = simd4f_uload4(mat + 12);
+
+				const simd4f boneco = simd4f_madd(col0, px, simd4f_madd(col1, py, simd4f_madd(col2, pz, col3)));
+				co = simd4f_madd(boneco, weight, co);
+
+				if (normals) {
+					const simd4f boneno = simd4f_madd(col0, nx, simd4f_madd(col1, ny, simd4f_mul(col2, nz)));
+					no = simd4f_madd(boneno, weight, no);
+				}
+			}
+
+			simd4f_ustore3(co, pos);
+			if (normals) {
+				simd4f_ustore3(normalizeNormal(no), normals[i].data);
+			}
+		}
+	});
+}
+
+void BL_SkinLayout::DeformDualQuaternion(const DualQuatList& dquats, mt::vec3_packed *positions, mt::vec3_packed *normals) const
+{
+	/* Pack the dual quaternions, the bones without scale use the identity scale matrix
+	 * to blend the scale matrices without branches. */
+	std::vector<float> packed(dquats.size() * dualQuatSize);
+	bool useScale = false;
+	for (unsigned int i = 0, size = dquats.size(); i < size; ++i) {
+		const DualQuat& dq = dquats[i];
+		float *data = &packed[i * dualQuatSize];
+		std::copy(dq.quat, dq.quat + 4, data);
+		std::copy(dq.trans, dq.trans + 4, data + 4);
+		if (dq.scale_weight != 0.0f) {
+			std::copy(&dq.scale[0][0], &dq.scale[0][0] + 16, data + 8);
+			useScale = true;
+		}
+		else {
+			unit_m4((float (*)[4])(data + 8));
+		}
+	}
+
+	tbb::parallel_for(tbb::blocked_range<unsigned int>(0, GetVertexCount(), deformGrainSize),
+		[this, &packed, useScale, positions, normals](const tbb::blocked_range<unsigned int>& r) {
+		for (unsigned int i = r.begin(), end = r.end(); i < end; ++i) {
+			const unsigned short *bones = &m_bones[i * MAX_INFLUENCES];
+			const float *weights = &m_weights[i * MAX_INFLUENCES];
+			const float *first = &packed[bones[0] * dualQuatSize];
+
+			simd4f real = simd4f_zero();
+			simd4f dual = simd4f_zero();
+			simd4f scale[4] = {simd4f_zero(), simd4f_zero(), simd4f_zero(), simd4f_zero()};
+			for (unsigned short j = 0; j < MAX_INFLUENCES; ++j) {
+				const float *dq = &packed[bones[j] * dualQuatSize];
+				// Interpolate the rotations in the direction of the most influent bone.
+				const float dot = dq[0] * first[0] + dq[1] * first[1] + dq[2] * first[2] + dq[3] * first[3];
+				const simd4f weight = simd4f_splat((dot < 0.0f) ? -weights[j] : weights[j]);
+
+				real = simd4f_madd(simd4f_uload4(dq), weight, real);
+				dual = simd4f_madd(simd4f_uload4(dq + 4), weight, dual);
+
+				if (useScale) {
+					const simd4f scaleWeight = simd4f_splat(weights[j]);
+					for (unsigned short k = 0; k < 4; ++k) {
+						scale[k] = simd4f_madd(simd4f_uload4(dq + 8 + k * 4), scaleWeight, scale[k]);
+					}
+				}
+			}
+
+			// Convert the blended dual quaternion to a rotation matrix and a translation, as mul_v3m3_dq.
+			float q[4];
+			float t[4];
+			simd4f_ustore4(real, q);
+			simd4f_ustore4(dual, t);
+
+			const float w = q[0], x = q[1], y = q[2], z = q[3];
+			const float len2 = w * w + x * x + y * y + z * z;
+			const simd4f invlen2 = simd4f_splat((len2 > 0.0f) ? 1.0f / len2 : 0.0f);
+
+			const simd4f col0 = simd4f_mul(simd4f_create(w * w + x * x - y * y - z * z, 2.0f * (x * y + w * z),
+			                                             2.0f * (x * z - w * y), 0.0f), invlen2);
+			const simd4f col1 = simd4f_mul(simd4f_create(2.0f * (x * y - w * z), w * w + y * y - x * x - z * z,
+			                                             2.0f * (y * z + w * x), 0.0f), invlen2);
+			const simd4f col2 = simd4f_mul(simd4f_create(2.0f * (x * z + w * y), 2.0f * (y * z - w * x),
+			                                             w * w + z * z - x * x - y * y, 0.0f), invlen2);
+			const simd4f trans = simd4f_mul(simd4f_create(2.0f * (-t[0] * x + w * t[1] - t[2] * z + y * t[3]),
+			                                              2.0f * (-t[0] * y + t[1] * z - x * t[3] + w * t[2]),
+			                                              2.0f * (-t[0] * z + x * t[2] + w * t[3] - t[1] * y), 0.0f), invlen2);
+
+			float *pos = positions[i].data;
+			simd4f co = simd4f_create(pos[0], pos[1], pos[2], 1.0f);
+			if (useScale) {
+				co = simd4f_madd(scale[0], simd4f_splat(pos[0]), simd4f_madd(scale[1], simd4f_splat(pos[1]),
+				     simd4f_madd(scale[2], simd4f_splat(pos[2]), scale[3])));
+			}
+			co = simd4f_madd(col0, simd4f_splat_x(co), simd4f_madd(col1, simd4f_splat_y(co),
+			     simd4f_madd(col2, simd4f_splat_z(co), trans)));
+			simd4f_ustore3(co, pos);
+
+			if (normals) {
+				const float *restnor = m_normals[i].data;
+				simd4f no = simd4f_create(restnor[0], restnor[1], restnor[2], 0.0f);
+				if (useScale) {
+					no = simd4f_madd(scale[0], simd4f_splat(restnor[0]), simd4f_madd(scale[1], simd4f_splat(restnor[1]),
+					     simd4f_mul(scale[2], simd4f_splat(restnor[2]))));
+				}
+				no = simd4f_madd(col0, simd4f_splat_x(no), simd4f_madd(col1, simd4f_splat_y(no),
+				     simd4f_mul(col2, simd4f_splat_z(no))));
+				simd4f_ustore3(normalizeNormal(no), normals[i].data);
+			}
+		}
+	});
+}
@@ -0,0 +1,86 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_SkinLayout.h
+ *  \ingroup bgeconv
+ */
+
+#ifndef __BL_SKIN_LAYOUT_H__
+#define __BL_SKIN_LAYOUT_H__
+
+#include "mathfu.h"
+
+#include "BLI_math_rotation.h"
+
+#include <vector>
+
+/** Compact vertex influences used by the linear blend skinning.
+ * Each vertex is influenced by at most four bones of which the weights are normalized.
+ * The bone 0 is reserved for the identity matrix and used by the vertices without
+ * any influence and the unused influences, the deformation is then done without
+ * branches and in parallel over blocks of vertices.
+ */
+class BL_SkinLayout
+{
+public:
+	typedef std::vector<mt::mat4, mt::simd_allocator<mt::mat4> > MatrixList;
+	typedef std::vector<DualQuat> DualQuatList;
+
+	/// Maximum number of bones influencing a vertex.
+	static const unsigned short MAX_INFLUENCES = 4;
+
+	BL_SkinLayout() = default;
+	~BL_SkinLayout() = default;
+
+	/// Remove all the vertices.
+	void Clear();
+
+	/** Add a vertex, only the four most influent bones are kept.
+	 * \param bones The bones influencing the vertex, starting from 1.
+	 * \param weights The weights of the bones.
+	 * \param count The number of influences.
+	 * \param normal The rest normal of the vertex.
+	 */
+	void AddVertex(const unsigned short *bones, const float *weights, unsigned int count, const mt::vec3_packed& normal);
+
+	unsigned int GetVertexCount() const;
+
+	/** Deform the vertices.
+	 * \param matrices The skinning matrices of each bone, the first is the identity.
+	 * \param positions The rest positions replaced by the deformed positions.
+	 * \param normals The deformed normals, can be null.
+	 */
+	void Deform(const MatrixList& matrices, mt::vec3_packed *positions, mt::vec3_packed *normals) const;
+
+	/** Deform the vertices with dual quaternion skinning, preserving the volume of twisted joints.
+	 * \param dquats The dual quaternions of each bone, the first is the identity.
+	 * \param positions The rest positions replaced by the deformed positions.
+	 * \param normals The deformed normals, can be null.
+	 */
+	void DeformDualQuaternion(const DualQuatList& dquats, mt::vec3_packed *positions, mt::vec3_packed *normals) const;
+
+private:
+	/// Bones and weights of the influences, MAX_INFLUENCES per vertex, sorted by decreasing weight.
+	std::vector<unsigned short> m_bones;
+	std::vector<float> m_weights;
+	std::vector<mt::vec3_packed> m_normals;
+};
+
+#endif  // __BL_SKIN_LAYOUT_H__
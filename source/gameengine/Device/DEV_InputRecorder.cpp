@@ -0,0 +1,286 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Device/DEV_InputRecorder.cpp
+ *  \ingroup device
+ */
+
+#include "DEV_InputRecorder.h"
+#include "DEV_Joystick.h"
+
+#include "SCA_IInputDevice.h"
+
+#include "CM_Message.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/// Header of a stream: magic and version.
+static const char streamMagic[4] = {'B', 'G', 'E', 'I'};
+static const uint32_t streamVersion = 1;
+
+DEV_InputRecorder::DEV_InputRecorder(Mode mode, const std::string& path)
+	:m_mode(mode),
+	m_valid(false),
+	m_finished(false),
+	m_missingJoystick(false),
+	m_frames(0)
+{
+	if (m_mode == RECORD) {
+		m_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!m_file.is_open()) {
+			CM_Error("cannot open input record file \"" << path << "\"");
+			return;
+		}
+
+		m_file.write(streamMagic, sizeof(streamMagic));
+		Write<uint32_t>(streamVersion);
+	}
+	else {
+		m_file.open(path, std::ios::in | std::ios::binary);
+		if (!m_file.is_open()) {
+			CM_Error("cannot open input replay file \"" << path << "\"");
+			return;
+		}
+
+		char magic[4];
+		m_file.read(magic, sizeof(magic));
+		const uint32_t version = Read<uint32_t>();
+		if (!m_file || memcmp(magic, streamMagic, sizeof(magic)) != 0 || version != streamVersion) {
+			CM_Error("invalid input replay file \"" << path << "\"");
+			return;
+		}
+	}
+
+	m_valid = true;
+}
+
+DEV_InputRecorder::~DEV_InputRecorder()
+{
+}
+
+template <class Type>
+void DEV_InputRecorder::Write(Type value)
+{
+	m_file.write((const char *)&value, sizeof(Type));
+}
+
+template <class Type>
+Type DEV_InputRecorder::Read()
+{
+	Type value = 0;
+	m_file.read((char *)&value, sizeof(Type));
+	return value;
+}
+
+bool DEV_InputRecorder::IsValid() const
+{
+	return m_valid;
+}
+
+DEV_InputRecorder::Mode DEV_InputRecorder::GetMode() const
+{
+	return m_mode;
+}
+
+bool DEV_InputRecorder::IsFinished() const
+{
+	return m_finished;
+}
+
+unsigned int DEV_InputRecorder::GetFrames() const
+{
+	return m_frames;
+}
+
+void DEV_InputRecorder::RecordInputs(SCA_IInputDevice *inputDevice)
+{
+	/* Only the inputs which received an event are written, the first status and
+	 * value are the ones from the previous frame and are not written. */
+	std::vector<uint16_t> types;
+	for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+		const SCA_InputEvent& event = inputDevice->GetInput((SCA_IInputDevice::SCA_EnumInputs)i);
+		if (event.m_status.size() > 1 || event.m_values.size() > 1 || !event.m_queue.empty()) {
+			types.push_back(i);
+		}
+	}
+
+	Write<uint16_t>(types.size());
+	for (uint16_t type : types) {
+		const SCA_InputEvent& event = inputDevice->GetInput((SCA_IInputDevice::SCA_EnumInputs)type);
+
+		Write<uint16_t>(type);
+		Write<uint16_t>(event.m_status.size() - 1);
+		for (unsigned int i = 1, size = event.m_status.size(); i < size; ++i) {
+			Write<uint8_t>(event.m_status[i]);
+		}
+		Write<uint16_t>(event.m_queue.size());
+		for (SCA_InputEvent::SCA_EnumInputs queue : event.m_queue) {
+			Write<uint8_t>(queue);
+		}
+		Write<uint16_t>(event.m_values.size() - 1);
+		for (unsigned int i = 1, size = event.m_values.size(); i < size; ++i) {
+			Write<int32_t>(event.m_values[i]);
+		}
+		Write<uint32_t>(event.m_unicode);
+	}
+
+	const std::wstring& text = inputDevice->GetText();
+	Write<uint16_t>(text.size());
+	for (wchar_t character : text) {
+		Write<uint32_t>(character);
+	}
+}
+
+void DEV_InputRecorder::ReplayInputs(SCA_IInputDevice *inputDevice)
+{
+	// The live events are ignored.
+	inputDevice->DiscardInputs();
+
+	for (unsigned short i = 0, numTypes = Read<uint16_t>(); i < numTypes; ++i) {
+		const uint16_t type = Read<uint16_t>();
+		if (type >= SCA_IInputDevice::MAX_KEYS) {
+			m_file.setstate(std::ios::failbit);
+			return;
+		}
+
+		SCA_InputEvent& event = inputDevice->GetInput((SCA_IInputDevice::SCA_EnumInputs)type);
+		for (unsigned short j = 0, size = Read<uint16_t>(); j < size; ++j) {
+			event.m_status.push_back((SCA_InputEvent::SCA_EnumInputs)Read<uint8_t>());
+		}
+		for (unsigned short j = 0, size = Read<uint16_t>(); j < size; ++j) {
+			event.m_queue.push_back((SCA_InputEvent::SCA_EnumInputs)Read<uint8_t>());
+		}
+		for (unsigned short j = 0, size = Read<uint16_t>(); j < size; ++j) {
+			event.m_values.push_back(Read<int32_t>());
+		}
+		event.m_unicode = Read<uint32_t>();
+	}
+
+	std::wstring text;
+	for (unsigned short i = 0, size = Read<uint16_t>(); i < size; ++i) {
+		text += (wchar_t)Read<uint32_t>();
+	}
+	inputDevice->SetText(text);
+}
+
+void DEV_InputRecorder::RecordJoysticks()
+{
+	DEV_Joystick *joysticks[JOYINDEX_MAX];
+	uint8_t mask = 0;
+	for (short i = 0; i < JOYINDEX_MAX; ++i) {
+		joysticks[i] = DEV_Joystick::GetInstance(i);
+		if (joysticks[i]) {
+			mask |= (1 << i);
+		}
+	}
+
+	Write<uint8_t>(mask);
+	for (short i = 0; i < JOYINDEX_MAX; ++i) {
+		if (!joysticks[i]) {
+			continue;
+		}
+
+		DEV_Joystick::State state;
+		joysticks[i]->GetState(state);
+		for (unsigned short j = 0; j < JOYAXIS_MAX; ++j) {
+			// SDL axes are in the range of a short.
+			Write<int16_t>(state.axis[j]);
+		}
+		Write<uint32_t>(state.buttons);
+		Write<uint8_t>((state.trigAxis ? 1 : 0) | (state.trigButton ? 2 : 0));
+	}
+}
+
+void DEV_InputRecorder::ReplayJoysticks()
+{
+	const uint8_t mask = Read<uint8_t>();
+	for (short i = 0; i < JOYINDEX_MAX; ++i) {
+		if (!(mask & (1 << i))) {
+			continue;
+		}
+
+		DEV_Joystick::State state;
+		for (unsigned short j = 0; j < JOYAXIS_MAX; ++j) {
+			state.axis[j] = Read<int16_t>();
+		}
+		state.buttons = Read<uint32_t>();
+		const uint8_t trig = Read<uint8_t>();
+		state.trigAxis = (trig & 1);
+		state.trigButton = (trig & 2);
+
+		DEV_Joystick *joystick = DEV_Joystick::GetInstance(i);
+		if (joystick) {
+			joystick->SetState(state);
+		}
+		else if (!m_missingJoystick) {
+			CM_Warning("recorded joystick " << i << " is not connected, its inputs are not replayed");
+			m_missingJoystick = true;
+		}
+	}
+}
+
+void DEV_InputRecorder::ProceedInputs(SCA_IInputDevice *inputDevice)
+{
+	if (!m_valid) {
+		return;
+	}
+
+	if (m_mode == RECORD) {
+		RecordInputs(inputDevice);
+		++m_frames;
+		return;
+	}
+
+	if (m_finished || m_file.peek() == std::char_traits<char>::eof()) {
+		m_finished = true;
+		inputDevice->DiscardInputs();
+		return;
+	}
+
+	ReplayInputs(inputDevice);
+	++m_frames;
+
+	if (!m_file) {
+		CM_Error("corrupted input replay file at frame " << m_frames);
+		m_finished = true;
+		inputDevice->DiscardInputs();
+	}
+}
+
+void DEV_InputRecorder::ProceedJoysticks()
+{
+	if (!m_valid || m_finished) {
+		return;
+	}
+
+	if (m_mode == RECORD) {
+		RecordJoysticks();
+		return;
+	}
+
+	ReplayJoysticks();
+
+	if (!m_file) {
+		CM_Error("corrupted input replay file at frame " << m_frames);
+		m_finished = true;
+	}
+}
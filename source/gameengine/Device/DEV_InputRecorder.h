@@ -0,0 +1,90 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file DEV_InputRecorder.h
+ *  \ingroup device
+ */
+
+#ifndef __DEV_INPUTRECORDER_H__
+#define __DEV_INPUTRECORDER_H__
+
+#include <string>
+#include <fstream>
+
+class SCA_IInputDevice;
+
+/** Record the inputs of each logic frame in a file or replay them from a file.
+ * The stream contains for each frame the keyboard, mouse and window events
+ * received during the frame and the state of the connected joysticks.
+ * Replaying a stream in a deterministic engine reproduces the same game.
+ *
+ * The values are stored in native byte order, a stream is meant to be replayed
+ * on the same kind of machine.
+ */
+class DEV_InputRecorder
+{
+public:
+	enum Mode {
+		RECORD,
+		REPLAY
+	};
+
+private:
+	Mode m_mode;
+	std::fstream m_file;
+	/// True when the file is opened and the header is valid.
+	bool m_valid;
+	/// True when all the frames of the stream were replayed.
+	bool m_finished;
+	/// True when a recorded joystick is not connected during replay.
+	bool m_missingJoystick;
+	/// Number of frames recorded or replayed.
+	unsigned int m_frames;
+
+	template <class Type>
+	void Write(Type value);
+	template <class Type>
+	Type Read();
+
+	void RecordInputs(SCA_IInputDevice *inputDevice);
+	void ReplayInputs(SCA_IInputDevice *inputDevice);
+	void RecordJoysticks();
+	void ReplayJoysticks();
+
+public:
+	DEV_InputRecorder(Mode mode, const std::string& path);
+	~DEV_InputRecorder();
+
+	bool IsValid() const;
+	Mode GetMode() const;
+	/// Return true when the replayed stream has no more frames.
+	bool IsFinished() const;
+	unsigned int GetFrames() const;
+
+	/** Record the events received by the input device during the frame, or replace
+	 * them by the recorded events. Must be called once per frame before any release
+	 * of the move events.
+	 */
+	void ProceedInputs(SCA_IInputDevice *inputDevice);
+	/// Record or replace the state of the joysticks, must be called after the joystick events handling.
+	void ProceedJoysticks();
+};
+
+#endif  // __DEV_INPUTRECORDER_H__
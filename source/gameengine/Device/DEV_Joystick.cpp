@@ -57,7 +57,8 @@ DEV_Joystick::DEV_Joystick(short index)
 	m_buttonmax(-1),
 	m_isinit(0),
 	m_istrig_axis(0),
-	m_istrig_button(0)
+	m_istrig_button(0),
+	m_buttons(0)
 {
 	for (int i = 0; i < JOYAXIS_MAX; i++) {
 		m_axis_array[i] = 0;
@@ -187,43 +188,48 @@ bool DEV_Joystick::aAxisIsPositive(int axis_single)
 
 bool DEV_Joystick::aAnyButtonPressIsPositive(void)
 {
-#ifdef WITH_SDL
-	if (!(SDL_CHECK(SDL_GameControllerGetButton))) {
-		return false;
-	}
-
 	/* this is needed for the "all events" option
 	 * so we know if there are no buttons pressed */
-	for (int i = 0; i < m_buttonmax; i++) {
-		if (SDL_GameControllerGetButton(m_private->m_gamecontroller, (SDL_GameControllerButton)i)) {
-			return true;
-		}
-	}
-#endif
-	return false;
+	return (m_buttons != 0);
 }
 
 bool DEV_Joystick::aButtonPressIsPositive(int button)
 {
-#ifdef WITH_SDL
-	if ((SDL_CHECK(SDL_GameControllerGetButton) &&
-	     SDL_GameControllerGetButton(m_private->m_gamecontroller, (SDL_GameControllerButton)button))) {
-		return true;
+	if (button < 0 || button >= 32) {
+		return false;
 	}
-#endif
-	return false;
+
+	return (m_buttons & (1u << button)) != 0;
 }
 
 
 bool DEV_Joystick::aButtonReleaseIsPositive(int button)
 {
 #ifdef WITH_SDL
-	if (!(SDL_CHECK(SDL_GameControllerGetButton) &&
-	      SDL_GameControllerGetButton(m_private->m_gamecontroller, (SDL_GameControllerButton)button))) {
-		return true;
-	}
-#endif
+	return !aButtonPressIsPositive(button);
+#else
 	return false;
+#endif
+}
+
+void DEV_Joystick::GetState(State& state) const
+{
+	for (int i = 0; i < JOYAXIS_MAX; i++) {
+		state.axis[i] = m_axis_array[i];
+	}
+	state.buttons = m_buttons;
+	state.trigAxis = m_istrig_axis;
+	state.trigButton = m_istrig_button;
+}
+
+void DEV_Joystick::SetState(const State& state)
+{
+	for (int i = 0; i < JOYAXIS_MAX; i++) {
+		m_axis_array[i] = state.axis[i];
+	}
+	m_buttons = state.buttons;
+	m_istrig_axis = state.trigAxis;
+	m_istrig_button = state.trigButton;
 }
 
 bool DEV_Joystick::CreateJoystickDevice(void)
@@ -85,6 +85,9 @@ class DEV_Joystick
 	bool			m_istrig_axis;
 	bool			m_istrig_button;
 
+	/// Bit mask of the pressed buttons, updated once per event handling.
+	unsigned int	m_buttons;
+
 #ifdef WITH_SDL
 	/**
 	 * event callbacks
@@ -92,6 +95,9 @@ class DEV_Joystick
 	void OnAxisEvent(SDL_Event *sdl_event);
 	void OnButtonEvent(SDL_Event *sdl_event);
 	void OnNothing(SDL_Event *sdl_event);
+
+	/// Update the bit mask of the pressed buttons from the game controller.
+	void UpdateButtons();
 		
 #endif /* WITH_SDL */
 	/**
@@ -119,6 +125,14 @@ class DEV_Joystick
 	~DEV_Joystick();
 	
 public:
+	/// Axes and buttons state, used to record and replay the joystick inputs.
+	struct State
+	{
+		int axis[JOYAXIS_MAX];
+		unsigned int buttons;
+		bool trigAxis;
+		bool trigButton;
+	};
 
 	static DEV_Joystick *GetInstance(short joyindex);
 	static bool HandleEvents(short (&addrem)[JOYINDEX_MAX]);
@@ -154,6 +168,10 @@ public:
 		return m_istrig_button;
 	}
 
+	void GetState(State& state) const;
+	/// Override the state of the last event handling.
+	void SetState(const State& state);
+
 	/**
 	 * Force Feedback - Vibration
 	 * We could add many optional arguments to these functions to take into account different sort of vibrations.
@@ -57,6 +57,21 @@ void DEV_Joystick::OnNothing(SDL_Event *sdl_event)
 	m_istrig_axis = m_istrig_button = 0;
 }
 
+void DEV_Joystick::UpdateButtons()
+{
+	m_buttons = 0;
+
+	if (SDL_GameControllerGetButton == (void *)0 || !m_private->m_gamecontroller) {
+		return;
+	}
+
+	for (int i = 0; i < m_buttonmax && i < 32; i++) {
+		if (SDL_GameControllerGetButton(m_private->m_gamecontroller, (SDL_GameControllerButton)i)) {
+			m_buttons |= (1u << i);
+		}
+	}
+}
+
 bool DEV_Joystick::HandleEvents(short(&addrem)[JOYINDEX_MAX])
 {
 	SDL_Event sdl_event;
@@ -153,6 +168,15 @@ bool DEV_Joystick::HandleEvents(short(&addrem)[JOYINDEX_MAX])
 			}
 		}
 	}
+
+	/* The buttons state is read once after all the events were processed,
+	 * the sensors then use the same state for the whole frame. */
+	for (int i = 0; i < JOYINDEX_MAX; i++) {
+		if (DEV_Joystick::m_instance[i]) {
+			DEV_Joystick::m_instance[i]->UpdateButtons();
+		}
+	}
+
 	return remap;
 }
 #endif /* WITH_SDL */
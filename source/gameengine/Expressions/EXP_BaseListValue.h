@@ -21,6 +21,10 @@
 
 #include "EXP_Value.h"
 
+#include "CM_Thread.h"
+
+#include <unordered_map>
+
 class EXP_BaseListValue : public EXP_PropValue
 {
 	Py_Header
@@ -34,6 +38,20 @@ protected:
 	VectorType m_valueArray;
 	bool m_bReleaseContents;
 
+	/** Index of the first value for each name, built by FindValue for the large lists.
+	 * It is invalidated by any modification of the list or rename of a value.
+	 */
+	mutable std::unordered_map<std::string, unsigned int> m_nameIndex;
+	mutable bool m_nameIndexValid;
+	/// Revision of the names at the construction of the index.
+	mutable unsigned int m_nameIndexRevision;
+	/// Lock of the index built lazily by FindValue, the names can be looked up from several threads.
+	mutable CM_ThreadSpinLock m_nameIndexLock;
+
+	/// Must be called after any direct modification of m_valueArray.
+	void InvalidateNameIndex();
+	void BuildNameIndex() const;
+
 	void SetValue(int i, EXP_Value *val);
 	EXP_Value *GetValue(int i);
 	EXP_Value *FindValue(const std::string& name) const;
@@ -45,6 +63,7 @@ protected:
 
 public:
 	EXP_BaseListValue();
+	EXP_BaseListValue(const EXP_BaseListValue& other);
 	virtual ~EXP_BaseListValue();
 
 	virtual int GetValueType();
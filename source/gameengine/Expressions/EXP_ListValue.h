@@ -80,6 +80,7 @@ public:
 		for (unsigned int i = 0; i < numelements; i++) {
 			replica->m_valueArray[i] = m_valueArray[i]->GetReplica();
 		}
+		replica->InvalidateNameIndex();
 
 		return replica;
 	}
@@ -24,8 +24,9 @@
 
 #include "CM_RefCount.h"
 
-#include <map> // Array functionality for the property list.
 #include <vector>
+#include <memory>
+#include <atomic>
 #include <string> // std::string class.
 
 #ifndef GEN_NO_TRACE
@@ -135,6 +136,10 @@ public:
 
 	/// Get property number <inIndex>.
 	virtual EXP_Value *GetProperty(int inIndex);
+	/** Get property number <inIndex> only if it is already stored as a value, returns nullptr
+	 * for the int, float and bool properties stored inline, they never own sub-properties.
+	 */
+	EXP_Value *GetStoredProperty(int inIndex);
 	/// Get the amount of properties assiocated with this value.
 	virtual int GetPropertyCount();
 
@@ -160,12 +165,55 @@ public:
 
 	virtual bool IsError() const;
 
+	/// Revision of the names of all the values, incremented by each call to SetName.
+	static unsigned int GetNameRevision();
+
 protected:
 	virtual void DestructFromPython();
 
+	/// Invalidate the name indices of the lists, must be called by each implementation of SetName.
+	static void NameChanged();
+
 private:
-	/// Properties for user/game etc.
-	std::map<std::string, EXP_Value *> m_properties;
+	/** Value of a property. The replicated int, float and bool values are stored inline
+	 * and only allocated as a value when requested, the value is then kept as the callers
+	 * can modify it.
+	 */
+	struct Property
+	{
+		/// The value, nullptr while the value is inline.
+		EXP_Value *m_value;
+		/// Type of the inline value.
+		VALUE_DATA_TYPE m_type;
+		union {
+			long long m_int;
+			float m_float;
+			bool m_bool;
+		};
+
+		Property(EXP_Value *value);
+	};
+	typedef std::vector<std::string> PropertyNames;
+
+	/** Sorted property names, shared by the replicas until a property is added or removed.
+	 * nullptr for a value without properties.
+	 */
+	std::shared_ptr<PropertyNames> m_propertyNames;
+	/// Property values in the order of the names.
+	std::vector<Property> m_properties;
+
+	/// Return the index of the first property with a name not less than name.
+	unsigned int FindProperty(const std::string& name) const;
+	/// Return true if the index found for a name is a property of this name.
+	bool IsProperty(unsigned int index, const std::string& name) const;
+	/// Return the names owned only by this value, copied if they are shared.
+	PropertyNames& GetUniquePropertyNames();
+	/// Return the value of a property, allocating it if the property is inline.
+	static EXP_Value *GetPropertyValue(Property& prop);
+	/// Store inline the replicated value of a property if possible, return false otherwise.
+	static bool InlineProperty(Property& prop);
+
+	static std::atomic<unsigned int> m_nameRevision;
 };
 
 /** EXP_PropValue is a EXP_Value derived class, that implements the identification (String name)
@@ -185,6 +233,10 @@ public:
 
 	virtual void SetName(const std::string& name)
 	{
+		// The values are named at construction, only a rename can change an indexed name.
+		if (!m_strNewName.empty()) {
+			NameChanged();
+		}
 		m_strNewName = name;
 	}
 
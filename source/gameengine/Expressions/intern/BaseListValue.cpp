@@ -27,8 +27,22 @@
 
 #include "BLI_sys_types.h" // For intptr_t support.
 
+/// Minimum number of values to look up a name with the index instead of a linear search.
+static const unsigned int nameIndexMinSize = 16;
+
 EXP_BaseListValue::EXP_BaseListValue()
-	:m_bReleaseContents(true)
+	:m_bReleaseContents(true),
+	m_nameIndexValid(false),
+	m_nameIndexRevision(0)
+{
+}
+
+EXP_BaseListValue::EXP_BaseListValue(const EXP_BaseListValue& other)
+	:EXP_PropValue(other),
+	m_valueArray(other.m_valueArray),
+	m_bReleaseContents(other.m_bReleaseContents),
+	m_nameIndexValid(false),
+	m_nameIndexRevision(0)
 {
 }
 
@@ -41,9 +55,27 @@ EXP_BaseListValue::~EXP_BaseListValue()
 	}
 }
 
+void EXP_BaseListValue::InvalidateNameIndex()
+{
+	m_nameIndexValid = false;
+}
+
+void EXP_BaseListValue::BuildNameIndex() const
+{
+	m_nameIndexRevision = GetNameRevision();
+	m_nameIndex.clear();
+	m_nameIndex.reserve(m_valueArray.size());
+	for (unsigned int i = 0, size = m_valueArray.size(); i < size; ++i) {
+		// Keep the first value of a name as the linear search.
+		m_nameIndex.emplace(m_valueArray[i]->GetName(), i);
+	}
+	m_nameIndexValid = true;
+}
+
 void EXP_BaseListValue::SetValue(int i, EXP_Value *val)
 {
 	m_valueArray[i] = val;
+	InvalidateNameIndex();
 }
 
 EXP_Value *EXP_BaseListValue::GetValue(int i)
@@ -53,6 +85,23 @@ EXP_Value *EXP_BaseListValue::GetValue(int i)
 
 EXP_Value *EXP_BaseListValue::FindValue(const std::string& name) const
 {
+	if (m_valueArray.size() >= nameIndexMinSize) {
+		EXP_Value *value = nullptr;
+
+		m_nameIndexLock.Lock();
+		if (!m_nameIndexValid || m_nameIndexRevision != GetNameRevision()) {
+			BuildNameIndex();
+		}
+
+		const std::unordered_map<std::string, unsigned int>::const_iterator it = m_nameIndex.find(name);
+		if (it != m_nameIndex.end()) {
+			value = m_valueArray[it->second];
+		}
+		m_nameIndexLock.Unlock();
+
+		return value;
+	}
+
 	const VectorTypeConstIterator it = std::find_if(m_valueArray.begin(), m_valueArray.end(),
 	                                                [&name](EXP_Value *item) {
 		return item->GetName() == name;
@@ -72,11 +121,13 @@ bool EXP_BaseListValue::SearchValue(EXP_Value *val) const
 void EXP_BaseListValue::Add(EXP_Value *value)
 {
 	m_valueArray.push_back(value);
+	InvalidateNameIndex();
 }
 
 void EXP_BaseListValue::Insert(unsigned int i, EXP_Value *value)
 {
 	m_valueArray.insert(m_valueArray.begin() + i, value);
+	InvalidateNameIndex();
 }
 
 bool EXP_BaseListValue::RemoveValue(EXP_Value *val)
@@ -86,6 +137,7 @@ bool EXP_BaseListValue::RemoveValue(EXP_Value *val)
 		if (*it == val) {
 			it = m_valueArray.erase(it);
 			result = true;
+			InvalidateNameIndex();
 		}
 		else {
 			++it;
@@ -137,11 +189,13 @@ void EXP_BaseListValue::SetReleaseOnDestruct(bool bReleaseContents)
 void EXP_BaseListValue::Remove(int i)
 {
 	m_valueArray.erase(m_valueArray.begin() + i);
+	InvalidateNameIndex();
 }
 
 void EXP_BaseListValue::Resize(int num)
 {
 	m_valueArray.resize(num);
+	InvalidateNameIndex();
 }
 
 void EXP_BaseListValue::ReleaseAndRemoveAll()
@@ -150,6 +204,7 @@ void EXP_BaseListValue::ReleaseAndRemoveAll()
 		item->Release();
 	}
 	m_valueArray.clear();
+	InvalidateNameIndex();
 }
 
 int EXP_BaseListValue::GetCount() const
@@ -470,6 +525,7 @@ PyObject *EXP_BaseListValue::Pyreverse()
 	}
 
 	std::reverse(m_valueArray.begin(), m_valueArray.end());
+	InvalidateNameIndex();
 	Py_RETURN_NONE;
 }
 
@@ -24,6 +24,8 @@
 #include "EXP_ErrorValue.h"
 #include "EXP_ListValue.h"
 
+#include <algorithm>
+
 #ifdef WITH_PYTHON
 
 PyTypeObject EXP_Value::Type = {
@@ -57,6 +59,8 @@ PyMethodDef EXP_Value::Methods[] = {
 };
 #endif  // WITH_PYTHON
 
+std::atomic<unsigned int> EXP_Value::m_nameRevision(0);
+
 EXP_Value::EXP_Value()
 {
 }
@@ -143,6 +147,107 @@ std::string EXP_Value::op2str(VALUE_OPERATOR op)
 //	Property Management
 //---------------------------------------------------------------------------------------------------------------------
 
+EXP_Value::Property::Property(EXP_Value *value)
+	:m_value(value),
+	m_type(VALUE_NO_TYPE),
+	m_int(0)
+{
+}
+
+unsigned int EXP_Value::FindProperty(const std::string& name) const
+{
+	if (!m_propertyNames) {
+		return 0;
+	}
+
+	return std::lower_bound(m_propertyNames->begin(), m_propertyNames->end(), name) - m_propertyNames->begin();
+}
+
+bool EXP_Value::IsProperty(unsigned int index, const std::string& name) const
+{
+	return (index < m_properties.size() && (*m_propertyNames)[index] == name);
+}
+
+EXP_Value::PropertyNames& EXP_Value::GetUniquePropertyNames()
+{
+	if (!m_propertyNames) {
+		m_propertyNames.reset(new PropertyNames());
+	}
+	else if (m_propertyNames.use_count() > 1) {
+		m_propertyNames.reset(new PropertyNames(*m_propertyNames));
+	}
+
+	return *m_propertyNames;
+}
+
+EXP_Value *EXP_Value::GetPropertyValue(Property& prop)
+{
+	if (prop.m_value) {
+		return prop.m_value;
+	}
+
+	switch (prop.m_type) {
+		case VALUE_INT_TYPE:
+		{
+			prop.m_value = new EXP_IntValue(prop.m_int);
+			break;
+		}
+		case VALUE_FLOAT_TYPE:
+		{
+			prop.m_value = new EXP_FloatValue(prop.m_float);
+			break;
+		}
+		case VALUE_BOOL_TYPE:
+		{
+			prop.m_value = new EXP_BoolValue(prop.m_bool);
+			break;
+		}
+		default:
+		{
+			BLI_assert(false);
+			break;
+		}
+	}
+
+	return prop.m_value;
+}
+
+bool EXP_Value::InlineProperty(Property& prop)
+{
+	EXP_Value *value = prop.m_value;
+	// A named value or a value owning properties (e.g timers) is replicated.
+	if (value->GetPropertyCount() > 0 || !value->GetName().empty()) {
+		return false;
+	}
+
+	const VALUE_DATA_TYPE type = (VALUE_DATA_TYPE)value->GetValueType();
+	switch (type) {
+		case VALUE_INT_TYPE:
+		{
+			prop.m_int = static_cast<EXP_IntValue *>(value)->GetInt();
+			break;
+		}
+		case VALUE_FLOAT_TYPE:
+		{
+			prop.m_float = static_cast<EXP_FloatValue *>(value)->GetFloat();
+			break;
+		}
+		case VALUE_BOOL_TYPE:
+		{
+			prop.m_bool = static_cast<EXP_BoolValue *>(value)->GetBool();
+			break;
+		}
+		default:
+		{
+			return false;
+		}
+	}
+
+	prop.m_type = type;
+	prop.m_value = nullptr;
+	return true;
+}
+
 /// Set property <ioProperty>, overwrites and releases a previous property with the same name if needed.
 void EXP_Value::SetProperty(const std::string & name, EXP_Value *ioProperty)
 {
@@ -153,21 +258,29 @@ void EXP_Value::SetProperty(const std::string & name, EXP_Value *ioProperty)
 	}
 
 	// Try to replace property (if so -> exit as soon as we replaced it).
-	EXP_Value *oldval = m_properties[name];
-	if (oldval) {
-		oldval->Release();
+	const unsigned int index = FindProperty(name);
+	if (IsProperty(index, name)) {
+		Property& prop = m_properties[index];
+		EXP_Value *oldval = prop.m_value;
+		prop.m_value = ioProperty->AddRef();
+		if (oldval) {
+			oldval->Release();
+		}
+		return;
 	}
 
-	// Add property at end of array.
-	m_properties[name] = ioProperty->AddRef();
+	// Insert property keeping the names sorted.
+	PropertyNames& names = GetUniquePropertyNames();
+	names.insert(names.begin() + index, name);
+	m_properties.emplace(m_properties.begin() + index, ioProperty->AddRef());
 }
 
 /// Get pointer to a property with name <inName>, returns nullptr if there is no property named <inName>.
 EXP_Value *EXP_Value::GetProperty(const std::string & inName)
 {
-	std::map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
-	if (it != m_properties.end()) {
-		return it->second;
+	const unsigned int index = FindProperty(inName);
+	if (IsProperty(index, inName)) {
+		return GetPropertyValue(m_properties[index]);
 	}
 	return nullptr;
 }
@@ -186,22 +299,45 @@ const std::string EXP_Value::GetPropertyText(const std::string & inName)
 
 float EXP_Value::GetPropertyNumber(const std::string& inName, float defnumber)
 {
-	EXP_Value *property = GetProperty(inName);
-	if (property) {
-		return property->GetNumber();
-	}
-	else {
+	const unsigned int index = FindProperty(inName);
+	if (!IsProperty(index, inName)) {
 		return defnumber;
 	}
+
+	// Read the inline values without allocating them.
+	const Property& prop = m_properties[index];
+	if (prop.m_value) {
+		return prop.m_value->GetNumber();
+	}
+
+	switch (prop.m_type) {
+		case VALUE_INT_TYPE:
+		{
+			return (float)prop.m_int;
+		}
+		case VALUE_BOOL_TYPE:
+		{
+			return prop.m_bool ? 1.0f : 0.0f;
+		}
+		default:
+		{
+			return prop.m_float;
+		}
+	}
 }
 
 /// Remove the property named <inName>, returns true if the property was succesfully removed, false if property was not found or could not be removed.
 bool EXP_Value::RemoveProperty(const std::string& inName)
 {
-	std::map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
-	if (it != m_properties.end()) {
-		(*it).second->Release();
-		m_properties.erase(it);
+	const unsigned int index = FindProperty(inName);
+	if (IsProperty(index, inName)) {
+		EXP_Value *value = m_properties[index].m_value;
+		if (value) {
+			value->Release();
+		}
+		PropertyNames& names = GetUniquePropertyNames();
+		names.erase(names.begin() + index);
+		m_properties.erase(m_properties.begin() + index);
 		return true;
 	}
 
@@ -211,36 +347,40 @@ bool EXP_Value::RemoveProperty(const std::string& inName)
 /// Get Property Names.
 std::vector<std::string> EXP_Value::GetPropertyNames()
 {
-	const unsigned short size = m_properties.size();
-	std::vector<std::string> result(size);
-
-	unsigned short i = 0;
-	for (const auto& pair : m_properties) {
-		result[i++] = pair.first;
+	if (!m_propertyNames) {
+		return std::vector<std::string>();
 	}
-	return result;
+	return *m_propertyNames;
 }
 
 /// Clear all properties.
 void EXP_Value::ClearProperties()
 {
 	// Remove all properties.
-	for (const auto& pair : m_properties) {
-		pair.second->Release();
+	for (const Property& prop : m_properties) {
+		if (prop.m_value) {
+			prop.m_value->Release();
+		}
 	}
 	m_properties.clear();
+	m_propertyNames.reset();
 }
 
 /// Get property number <inIndex>.
 EXP_Value *EXP_Value::GetProperty(int inIndex)
 {
-	int count = 0;
-	for (const auto& pair : m_properties) {
-		if (count++ == inIndex) {
-			return pair.second;
-		}
+	if (inIndex < 0 || inIndex >= (int)m_properties.size()) {
+		return nullptr;
 	}
-	return nullptr;
+	return GetPropertyValue(m_properties[inIndex]);
+}
+
+EXP_Value *EXP_Value::GetStoredProperty(int inIndex)
+{
+	if (inIndex < 0 || inIndex >= (int)m_properties.size()) {
+		return nullptr;
+	}
+	return m_properties[inIndex].m_value;
 }
 
 /// Get the amount of properties assiocated with this value.
@@ -262,9 +402,11 @@ void EXP_Value::ProcessReplica()
 {
 	EXP_PyObjectPlus::ProcessReplica();
 
-	// Copy all props.
-	for (auto& pair : m_properties) {
-		pair.second = pair.second->GetReplica();
+	// The names are shared, the int, float and bool properties are copied inline without allocation.
+	for (Property& prop : m_properties) {
+		if (prop.m_value && !InlineProperty(prop)) {
+			prop.m_value = prop.m_value->GetReplica();
+		}
 	}
 }
 
@@ -362,9 +504,8 @@ PyObject *EXP_Value::ConvertKeysToPython(void)
 {
 	PyObject *pylist = PyList_New(m_properties.size());
 
-	Py_ssize_t i = 0;
-	for (const auto& pair : m_properties) {
-		PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString(pair.first));
+	for (unsigned int i = 0, size = m_properties.size(); i < size; ++i) {
+		PyList_SET_ITEM(pylist, i, PyUnicode_FromStdString((*m_propertyNames)[i]));
 	}
 
 	return pylist;
@@ -402,6 +543,16 @@ void EXP_Value::SetName(const std::string& name)
 {
 }
 
+unsigned int EXP_Value::GetNameRevision()
+{
+	return m_nameRevision;
+}
+
+void EXP_Value::NameChanged()
+{
+	++m_nameRevision;
+}
+
 EXP_Value *EXP_Value::GetReplica()
 {
 	return nullptr;
@@ -72,6 +72,12 @@ bool SCA_2DFilterActuator::Update()
 		return false; // do nothing on negative events
 
 	}
+
+	// Without rasterizer (headless mode) the filters are never rendered.
+	if (!m_rasterizer) {
+		return false;
+	}
+
 	RAS_2DFilter *filter = m_filterManager->GetFilterPass(m_int_arg);
 	switch (m_type) {
 		case RAS_2DFilterManager::FILTER_ENABLED:
@@ -24,6 +24,7 @@
 #include "SCA_IController.h"
 #include "SCA_IActuator.h"
 #include "SCA_ISensor.h"
+#include "SCA_LogicManager.h"
 #include "EXP_ListWrapper.h"
 
 #include "CM_Message.h"
@@ -34,12 +35,23 @@
 SCA_IController::SCA_IController(SCA_IObject *gameobj)
 	:SCA_ILogicBrick(gameobj),
 	m_statemask(0),
-	m_justActivated(false)
+	m_justActivated(false),
+	m_bookmark(false),
+	m_triggeredIndex(-1)
 {
 }
 
 SCA_IController::~SCA_IController()
 {
+	if (m_triggeredIndex != -1) {
+		m_logicManager->RemoveTriggeredController(this);
+	}
+}
+
+void SCA_IController::ProcessReplica()
+{
+	SCA_ILogicBrick::ProcessReplica();
+	m_triggeredIndex = -1;
 }
 
 std::vector<SCA_ISensor *>& SCA_IController::GetLinkedSensors()
@@ -150,12 +162,6 @@ void SCA_IController::ApplyState(unsigned int state)
 	}
 }
 
-void SCA_IController::Deactivate()
-{
-	// the controller can only be part of a sensor m_newControllers list
-	Delink();
-}
-
 bool SCA_IController::IsJustActivated()
 {
 	return m_justActivated;
@@ -171,20 +177,19 @@ void SCA_IController::SetBookmark(bool bookmark)
 	m_bookmark = bookmark;
 }
 
-void SCA_IController::Activate(SG_DList& head)
+bool SCA_IController::IsBookmarked() const
 {
-	if (QEmpty()) {
-		if (m_bookmark) {
-			SG_QList& list = SCA_IObject::GetActiveBookmarkedControllers();
-			list.QAddBack(this);
-			head.AddFront(&list);
-		}
-		else {
-			SG_QList& list = m_gameobj->GetActiveControllers();
-			InsertActiveQList(list);
-			head.AddBack(&list);
-		}
-	}
+	return m_bookmark;
+}
+
+int SCA_IController::GetTriggeredIndex() const
+{
+	return m_triggeredIndex;
+}
+
+void SCA_IController::SetTriggeredIndex(int index)
+{
+	m_triggeredIndex = index;
 }
 
 #ifdef WITH_PYTHON
@@ -28,8 +28,7 @@
 
 /**
  * Use of SG_DList element: none
- * Use of SG_QList element: build ordered list of activated controller on the owner object
- *                          Head: SCA_IObject::m_activeControllers
+ * Use of SG_QList element: none, the triggered controllers are stored in SCA_LogicManager::m_triggeredControllers
  */
 class SCA_IController : public SCA_ILogicBrick
 {
@@ -41,11 +40,15 @@ protected:
 	unsigned int m_statemask;
 	bool m_justActivated;
 	bool m_bookmark;
+	/// Index in the triggered controllers of the logic manager, -1 when not triggered.
+	int m_triggeredIndex;
 
 public:
 	SCA_IController(SCA_IObject *gameobj);
 	virtual ~SCA_IController();
 
+	virtual void ProcessReplica();
+
 	virtual void Trigger(SCA_LogicManager *logicmgr) = 0;
 
 	void LinkToSensor(SCA_ISensor *sensor);
@@ -58,11 +61,12 @@ public:
 	void UnlinkSensor(SCA_ISensor *sensor);
 	void SetState(unsigned int state);
 	void ApplyState(unsigned int state);
-	void Deactivate();
 	bool IsJustActivated();
 	void ClrJustActivated();
 	void SetBookmark(bool bookmark);
-	void Activate(SG_DList& head);
+	bool IsBookmarked() const;
+	int GetTriggeredIndex() const;
+	void SetTriggeredIndex(int index);
 
 #ifdef WITH_PYTHON
 	static PyObject *pyattr_get_state(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
@@ -136,6 +136,17 @@ void SCA_IInputDevice::ClearInputs()
 	m_text.clear();
 }
 
+void SCA_IInputDevice::DiscardInputs()
+{
+	for (int i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+		SCA_InputEvent& event = m_inputsTable[i];
+		event.m_status.resize(1);
+		event.m_values.resize(1);
+		event.m_queue.clear();
+	}
+	m_text.clear();
+}
+
 void SCA_IInputDevice::ReleaseMoveEvent()
 {
 	/* We raise the release mouse move event if:
@@ -166,6 +177,11 @@ const std::wstring& SCA_IInputDevice::GetText() const
 	return m_text;
 }
 
+void SCA_IInputDevice::SetText(const std::wstring& text)
+{
+	m_text = text;
+}
+
 const char SCA_IInputDevice::ConvertKeyToChar(SCA_IInputDevice::SCA_EnumInputs input, bool shifted)
 {
 	std::map<SCA_EnumInputs, std::pair<char, char> >::iterator it = m_keyToChar.find(input);
@@ -222,6 +222,13 @@ public:
 	 */
 	virtual void ClearInputs();
 
+	/** Discard the events received since the last call to ClearInputs():
+	 *     - Keep only the first status and value.
+	 *     - Clear queue and text.
+	 * Used to replace the inputs of a frame by recorded inputs.
+	 */
+	void DiscardInputs();
+
 	/** Manage move event like mouse by releasing if possible.
 	 * These kind of events are precise of one frame.
 	 */
@@ -229,6 +236,8 @@ public:
 
 	/// Return typed unicode text during a frame.
 	const std::wstring& GetText() const;
+	/// Set typed unicode text during a frame.
+	void SetText(const std::wstring& text);
 
 	static const char ConvertKeyToChar(SCA_EnumInputs input, bool shifted);
 };
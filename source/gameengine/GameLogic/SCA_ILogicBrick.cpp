@@ -53,6 +53,11 @@ void SCA_ILogicBrick::SetExecutePriority(int execute_Priority)
 	m_Execute_Priority = execute_Priority;
 }
 
+int SCA_ILogicBrick::GetExecutePriority() const
+{
+	return m_Execute_Priority;
+}
+
 
 
 void SCA_ILogicBrick::SetUeberExecutePriority(int execute_Priority)
@@ -80,6 +85,7 @@ std::string SCA_ILogicBrick::GetName()
 void SCA_ILogicBrick::SetName(const std::string& name)
 {
 	m_name = name;
+	NameChanged();
 }
 
 void SCA_ILogicBrick::SetLogicManager(SCA_LogicManager *logicmgr)
@@ -28,6 +28,8 @@
 #include "SCA_IObject.h"
 #include "EXP_BoolValue.h"
 
+#include <map>
+
 class KX_NetworkMessageScene;
 class SCA_IScene;
 class SCA_LogicManager;
@@ -52,6 +54,7 @@ public:
 	virtual ~SCA_ILogicBrick();
 
 	void SetExecutePriority(int execute_Priority);
+	int GetExecutePriority() const;
 	void SetUeberExecutePriority(int execute_Priority);
 
 	SCA_IObject*	GetParent() { return m_gameobj; }
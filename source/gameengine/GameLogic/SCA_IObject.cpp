@@ -32,10 +32,10 @@
 
 #include "CM_List.h"
 
-SG_QList SCA_IObject::m_activeBookmarkedControllers;
-
 SCA_IObject::SCA_IObject()
-	:m_suspended(false),
+	:m_triggerStamp(0),
+	m_triggerGroup(0),
+	m_suspended(false),
 	m_initState(0),
 	m_state(0),
 	m_firstState(nullptr)
@@ -47,6 +47,8 @@ SCA_IObject::SCA_IObject(const SCA_IObject& other)
 	m_sensors(other.m_sensors),
 	m_controllers(other.m_controllers),
 	m_actuators(other.m_actuators),
+	m_triggerStamp(0),
+	m_triggerGroup(0),
 	m_suspended(other.m_suspended),
 	m_initState(other.m_initState),
 	m_state(0),
@@ -95,14 +97,20 @@ SG_QList& SCA_IObject::GetActiveActuators()
 	return m_activeActuators;
 }
 
-SG_QList& SCA_IObject::GetActiveControllers()
+unsigned int SCA_IObject::GetTriggerStamp() const
+{
+	return m_triggerStamp;
+}
+
+unsigned int SCA_IObject::GetTriggerGroup() const
 {
-	return m_activeControllers;
+	return m_triggerGroup;
 }
 
-SG_QList& SCA_IObject::GetActiveBookmarkedControllers()
+void SCA_IObject::SetTriggerGroup(unsigned int stamp, unsigned int group)
 {
-	return m_activeBookmarkedControllers;
+	m_triggerStamp = stamp;
+	m_triggerGroup = group;
 }
 
 void SCA_IObject::AddSensor(SCA_ISensor *act)
@@ -61,19 +61,10 @@ protected:
 	 */
 	SG_QList m_activeActuators;
 
-	/** SG_Dlist: element of list os lists with active controllers
-	 *            Head: SCA_LogicManager::m_activeControllers
-	 *  SG_QList: Head of active controller list on this object
-	 *            Elements: SCA_IController
-	 */
-	SG_QList m_activeControllers;
-
-	/** SG_Dlist: element of list of lists of active controllers
-	 *            Head: SCA_LogicManager::m_activeControllers
-	 *  SG_QList: Head of active bookmarked controller list globally
-	 *            Elements: SCA_IController with bookmark option
-	 */
-	static SG_QList m_activeBookmarkedControllers;
+	/// Trigger stamp of the logic manager when m_triggerGroup was set.
+	unsigned int m_triggerStamp;
+	/// Execution group of the triggered controllers of this object, see SCA_LogicManager::AddTriggeredController.
+	unsigned int m_triggerGroup;
 
 	/// Ignore updates?
 	bool m_suspended;
@@ -96,8 +87,9 @@ public:
 	SCA_SensorList& GetSensors();
 	SCA_ActuatorList& GetActuators();
 	SG_QList& GetActiveActuators();
-	SG_QList& GetActiveControllers();
-	static SG_QList& GetActiveBookmarkedControllers();
+	unsigned int GetTriggerStamp() const;
+	unsigned int GetTriggerGroup() const;
+	void SetTriggerGroup(unsigned int stamp, unsigned int group);
 
 	void AddSensor(SCA_ISensor *act);
 	void ReserveSensor(int num);
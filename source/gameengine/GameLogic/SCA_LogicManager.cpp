@@ -32,7 +32,24 @@
 
 #include "CM_Map.h"
 
+#include <algorithm>
+
+bool SCA_LogicManager::TriggeredController::operator<(const TriggeredController& other) const
+{
+	if (m_group != other.m_group) {
+		return m_group < other.m_group;
+	}
+	if (m_priority != other.m_priority) {
+		return m_priority < other.m_priority;
+	}
+	// The bookmarked controllers are executed in trigger order, the last triggered first for the others.
+	return (m_group == 0) ? (m_order < other.m_order) : (m_order > other.m_order);
+}
+
 SCA_LogicManager::SCA_LogicManager()
+	:m_triggerStamp(0),
+	m_numTriggerGroups(0),
+	m_lastTriggerStamp(0)
 {
 }
 
@@ -41,6 +58,13 @@ SCA_LogicManager::SCA_LogicManager()
 SCA_LogicManager::~SCA_LogicManager()
 {
 	BLI_assert(m_activeActuators.Empty());
+
+	// The controllers can be freed after the manager.
+	for (const TriggeredController& triggered : m_triggeredControllers) {
+		if (triggered.m_controller) {
+			triggered.m_controller->SetTriggeredIndex(-1);
+		}
+	}
 }
 
 void SCA_LogicManager::RegisterEventManager(SCA_EventManager *eventmgr)
@@ -116,7 +140,9 @@ void SCA_LogicManager::RemoveController(SCA_IController *controller)
 {
 	controller->UnlinkAllSensors();
 	controller->UnlinkAllActuators();
-	controller->Deactivate();
+	if (controller->GetTriggeredIndex() != -1) {
+		RemoveTriggeredController(controller);
+	}
 }
 
 
@@ -151,17 +177,38 @@ void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 		mgr->NextFrame(curtime, fixedtime);
 	}
 
-	for (SG_QList *obj = (SG_QList *)m_triggeredControllerSet.Remove();
-	     obj != nullptr;
-	     obj = (SG_QList *)m_triggeredControllerSet.Remove())
-	{
-		for (SCA_IController *contr = (SCA_IController *)obj->QRemove();
-		     contr != nullptr;
-		     contr = (SCA_IController *)obj->QRemove())
-		{
+	/* The controllers triggered by an other controller are appended
+	 * to the array and dispatched in the next loop. */
+	while (!m_triggeredControllers.empty()) {
+		std::sort(m_triggeredControllers.begin(), m_triggeredControllers.end());
+		const unsigned int size = m_triggeredControllers.size();
+		for (unsigned int i = 0; i < size; ++i) {
+			SCA_IController *contr = m_triggeredControllers[i].m_controller;
+			if (contr) {
+				contr->SetTriggeredIndex(i);
+			}
+		}
+
+		for (unsigned int i = 0; i < size; ++i) {
+			// The array can be reallocated by a trigger.
+			SCA_IController *contr = m_triggeredControllers[i].m_controller;
+			// Removed during the dispatch.
+			if (!contr) {
+				continue;
+			}
+
+			contr->SetTriggeredIndex(-1);
 			contr->Trigger(this);
 			contr->ClrJustActivated();
 		}
+
+		m_triggeredControllers.erase(m_triggeredControllers.begin(), m_triggeredControllers.begin() + size);
+		for (unsigned int i = 0, newsize = m_triggeredControllers.size(); i < newsize; ++i) {
+			SCA_IController *contr = m_triggeredControllers[i].m_controller;
+			if (contr) {
+				contr->SetTriggeredIndex(i);
+			}
+		}
 	}
 }
 
@@ -266,7 +313,32 @@ void SCA_LogicManager::EndFrame()
 
 void SCA_LogicManager::AddTriggeredController(SCA_IController *controller, SCA_ISensor *sensor)
 {
-	controller->Activate(m_triggeredControllerSet);
+	if (controller->GetTriggeredIndex() == -1) {
+		if (m_triggeredControllers.empty()) {
+			m_triggerStamp = ++m_lastTriggerStamp;
+			m_numTriggerGroups = 1;
+		}
+
+		TriggeredController triggered;
+		triggered.m_controller = controller;
+		triggered.m_order = m_triggeredControllers.size();
+		// The bookmarked controllers are executed before all the others.
+		if (controller->IsBookmarked()) {
+			triggered.m_group = 0;
+			triggered.m_priority = 0;
+		}
+		else {
+			SCA_IObject *gameobj = controller->GetParent();
+			if (gameobj->GetTriggerStamp() != m_triggerStamp) {
+				gameobj->SetTriggerGroup(m_triggerStamp, m_numTriggerGroups++);
+			}
+			triggered.m_group = gameobj->GetTriggerGroup();
+			triggered.m_priority = controller->GetExecutePriority();
+		}
+
+		controller->SetTriggeredIndex(m_triggeredControllers.size());
+		m_triggeredControllers.push_back(triggered);
+	}
 
 #ifdef WITH_PYTHON
 
@@ -280,6 +352,17 @@ void SCA_LogicManager::AddTriggeredController(SCA_IController *controller, SCA_I
 #endif
 }
 
+void SCA_LogicManager::RemoveTriggeredController(SCA_IController *controller)
+{
+	const int index = controller->GetTriggeredIndex();
+	BLI_assert(index != -1 && m_triggeredControllers[index].m_controller == controller);
+
+	/* Keep the entry to not invalidate the indices of the other
+	 * controllers, it's skipped at dispatch. */
+	m_triggeredControllers[index].m_controller = nullptr;
+	controller->SetTriggeredIndex(-1);
+}
+
 SCA_EventManager *SCA_LogicManager::FindEventManager(int eventmgrtype)
 {
 	// find an eventmanager of a certain type
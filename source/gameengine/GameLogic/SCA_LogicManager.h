@@ -35,9 +35,6 @@
 #include "EXP_Value.h"
 #include "SG_QList.h"
 
-typedef std::list<class SCA_IController*> controllerlist;
-typedef std::map<class SCA_ISensor*,controllerlist > sensormap_t;
-
 /**
  * This manager handles sensor, controllers and actuators.
  * logic executes each frame the following way:
@@ -59,14 +56,36 @@ typedef std::map<class SCA_ISensor*,controllerlist > sensormap_t;
 
 class SCA_LogicManager
 {
+	/// A controller triggered since the last dispatch.
+	struct TriggeredController
+	{
+		/// The controller, nullptr if it was removed.
+		SCA_IController *m_controller;
+		/// Execution group, 0 for the bookmarked controllers then one per object in trigger order.
+		unsigned int m_group;
+		/// Execution priority in the object group.
+		int m_priority;
+		/// Trigger order.
+		unsigned int m_order;
+
+		bool operator<(const TriggeredController& other) const;
+	};
+
 	std::vector<std::unique_ptr<SCA_EventManager> > m_eventmanagers;
 	
 	// SG_DList: Head of objects having activated actuators
 	//           element: SCA_IObject::m_activeActuators
 	SG_DList							m_activeActuators;
-	// SG_DList: Head of objects having activated controllers
-	//           element: SCA_IObject::m_activeControllers
-	SG_DList							m_triggeredControllerSet;
+	/** Controllers to trigger in the next BeginFrame, a flat array sorted in execution order
+	 * at dispatch instead of a linked list per object.
+	 */
+	std::vector<TriggeredController> m_triggeredControllers;
+	/// Trigger stamp of the current triggered controllers, used to assign the object groups.
+	unsigned int m_triggerStamp;
+	/// Number of execution groups of the current triggered controllers.
+	unsigned int m_numTriggerGroups;
+	/// Last trigger stamp used by this manager.
+	unsigned int m_lastTriggerStamp;
 
 	// need to find better way for this
 	// also known as FactoryManager...
@@ -98,6 +117,8 @@ public:
 	}
 
 	void	AddTriggeredController(SCA_IController* controller, SCA_ISensor* sensor);
+	/// Remove a controller from the controllers to trigger.
+	void	RemoveTriggeredController(SCA_IController *controller);
 	SCA_EventManager*	FindEventManager(int eventmgrtype);
 
 	/**
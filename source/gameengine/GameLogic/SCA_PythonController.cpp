@@ -55,6 +55,7 @@ SCA_PythonController::SCA_PythonController(SCA_IObject *gameobj, int mode)
 #ifdef WITH_PYTHON
 	, m_pythondictionary(nullptr)
 #endif
+	, m_profileEntry(nullptr)
 
 {
 
@@ -123,6 +124,7 @@ void SCA_PythonController::SetScriptText(const std::string& text)
 void SCA_PythonController::SetScriptName(const std::string& name)
 {
 	m_scriptName = name;
+	m_profileEntry = nullptr;
 }
 
 bool SCA_PythonController::IsTriggered(class SCA_ISensor *sensor)
@@ -330,6 +332,11 @@ bool SCA_PythonController::Import()
 
 void SCA_PythonController::Trigger(SCA_LogicManager *logicmgr)
 {
+	if (!m_profileEntry) {
+		m_profileEntry = SCA_PythonProfiler::GetEntry(SCA_PythonProfiler::CONTROLLER, m_scriptName);
+	}
+	SCA_PythonProfileScope profileScope(m_profileEntry, "PythonController", m_scriptName.c_str());
+
 	m_sCurrentController = this;
 
 	PyObject *excdict =      nullptr;
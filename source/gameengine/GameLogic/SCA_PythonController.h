@@ -28,6 +28,7 @@
 #include "SCA_IController.h"
 #include "SCA_LogicManager.h"
 #include "EXP_BoolValue.h"
+#include "SCA_PythonProfiler.h"
 
 #include <vector>
 
@@ -53,6 +54,8 @@ class SCA_PythonController : public SCA_IController
 	PyObject*				m_pythonfunction;	/* for SCA_PYEXEC_MODULE only */
 #endif
 	std::vector<class SCA_ISensor*>		m_triggeredSensors;
+	/// Cost accounting of the script, resolved at the first trigger.
+	SCA_PythonProfiler::Entry *m_profileEntry;
  
  public:
 	enum SCA_PyExecMode
@@ -0,0 +1,115 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/GameLogic/SCA_PythonProfiler.cpp
+ *  \ingroup gamelogic
+ */
+
+#include "SCA_PythonProfiler.h"
+
+#include <algorithm>
+
+/// Weight of the last frame in the average, close to an average over the last 25 frames.
+static const double averageFactor = 1.0 / 25.0;
+
+SCA_PythonProfiler::EntryMap SCA_PythonProfiler::m_entries[NUM_CATEGORIES];
+CM_Clock SCA_PythonProfiler::m_clock;
+bool SCA_PythonProfiler::m_enabled = false;
+bool SCA_PythonProfiler::m_shown = false;
+
+SCA_PythonProfiler::Entry *SCA_PythonProfiler::GetEntry(Category category, const std::string& name)
+{
+	return &GetNamedEntry(category, name).second;
+}
+
+SCA_PythonProfiler::EntryMap::value_type& SCA_PythonProfiler::GetNamedEntry(Category category, const std::string& name)
+{
+	return *m_entries[category].emplace(name, Entry{0, 0.0, 0.0, 0.0}).first;
+}
+
+const SCA_PythonProfiler::EntryMap& SCA_PythonProfiler::GetEntries(Category category)
+{
+	return m_entries[category];
+}
+
+const char *SCA_PythonProfiler::GetCategoryName(Category category)
+{
+	static const char *names[NUM_CATEGORIES] = {
+		"Controllers",
+		"Components",
+		"Draw Callbacks"
+	};
+
+	return names[category];
+}
+
+void SCA_PythonProfiler::SetEnabled(bool enabled)
+{
+	m_enabled = enabled;
+}
+
+bool SCA_PythonProfiler::GetEnabled()
+{
+	return m_enabled;
+}
+
+void SCA_PythonProfiler::SetShown(bool shown)
+{
+	m_shown = shown;
+}
+
+void SCA_PythonProfiler::GetSortedEntries(std::vector<EntryPair>& entries)
+{
+	for (const EntryMap& map : m_entries) {
+		for (const EntryMap::value_type& pair : map) {
+			if (pair.second.calls > 0) {
+				entries.emplace_back(&pair.first, &pair.second);
+			}
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const EntryPair& a, const EntryPair& b) {
+		return a.second->averageTime > b.second->averageTime;
+	});
+}
+
+void SCA_PythonProfiler::NextFrame()
+{
+	if (!IsRecording()) {
+		return;
+	}
+
+	for (EntryMap& map : m_entries) {
+		for (EntryMap::value_type& pair : map) {
+			Entry& entry = pair.second;
+			entry.averageTime += (entry.frameTime - entry.averageTime) * averageFactor;
+			entry.frameTime = 0.0;
+		}
+	}
+}
+
+void SCA_PythonProfiler::Reset()
+{
+	for (EntryMap& map : m_entries) {
+		for (EntryMap::value_type& pair : map) {
+			pair.second = Entry{0, 0.0, 0.0, 0.0};
+		}
+	}
+}
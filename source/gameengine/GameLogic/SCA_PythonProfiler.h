@@ -0,0 +1,138 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SCA_PythonProfiler.h
+ *  \ingroup gamelogic
+ */
+
+#ifndef __SCA_PYTHONPROFILER_H__
+#define __SCA_PYTHONPROFILER_H__
+
+#include "CM_Clock.h"
+#include "CM_Profiler.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/** Accounting of the calls and time spent in each Python script, component
+ * class or draw callback. The entries are shared by all the scenes and are
+ * only used from the main thread. The calls are only accounted when enabled
+ * from Python or while the profile is shown on screen.
+ */
+class SCA_PythonProfiler
+{
+public:
+	enum Category {
+		CONTROLLER = 0,
+		COMPONENT,
+		DRAW_CALLBACK,
+		NUM_CATEGORIES
+	};
+
+	struct Entry
+	{
+		/// Calls and time in seconds since the start or the last reset.
+		unsigned long long calls;
+		double time;
+		/// Time of the current frame.
+		double frameTime;
+		/// Average of the frame times.
+		double averageTime;
+	};
+
+	/// Entries by name, an entry is never removed so a pointer to it can be kept.
+	using EntryMap = std::map<std::string, Entry>;
+
+	/// Entry and its name, e.g. for sorting.
+	using EntryPair = std::pair<const std::string *, const Entry *>;
+
+private:
+	static EntryMap m_entries[NUM_CATEGORIES];
+	static CM_Clock m_clock;
+	/// Accounting enabled from Python.
+	static bool m_enabled;
+	/// Accounting enabled by the on screen profile.
+	static bool m_shown;
+
+public:
+	/// Return the entry of a name, created if needed.
+	static Entry *GetEntry(Category category, const std::string& name);
+	/// Return the entry of a name and its name kept by the profiler, created if needed.
+	static EntryMap::value_type& GetNamedEntry(Category category, const std::string& name);
+	static const EntryMap& GetEntries(Category category);
+	static const char *GetCategoryName(Category category);
+
+	/// Return the entries of all categories called at least once, sorted by decreasing average frame time.
+	static void GetSortedEntries(std::vector<EntryPair>& entries);
+
+	inline static double GetTime()
+	{
+		return m_clock.GetTimeSecond();
+	}
+
+	static void SetEnabled(bool enabled);
+	static bool GetEnabled();
+	static void SetShown(bool shown);
+	/// Return true if the calls are accounted.
+	inline static bool IsRecording()
+	{
+		return (m_enabled || m_shown);
+	}
+
+	/// Update the averages of the frame times and start a new frame.
+	static void NextFrame();
+	/// Reset the calls and times of all the entries.
+	static void Reset();
+};
+
+/// Account the call of a Python entry for the lifetime of the scope, also recorded in the profile trace.
+class SCA_PythonProfileScope
+{
+private:
+	SCA_PythonProfiler::Entry *m_entry;
+	double m_start;
+	CM_ProfileScope m_traceScope;
+
+public:
+	/** \param traceName Static name of the event in the profile trace.
+	 * \param detail Detail of the trace event, must be valid until the end of the scope.
+	 */
+	inline SCA_PythonProfileScope(SCA_PythonProfiler::Entry *entry, const char *traceName, const char *detail)
+		:m_entry(SCA_PythonProfiler::IsRecording() ? entry : nullptr),
+		m_start(m_entry ? SCA_PythonProfiler::GetTime() : 0.0),
+		m_traceScope(traceName, detail)
+	{
+	}
+
+	inline ~SCA_PythonProfileScope()
+	{
+		if (!m_entry) {
+			return;
+		}
+
+		const double time = SCA_PythonProfiler::GetTime() - m_start;
+		++m_entry->calls;
+		m_entry->time += time;
+		m_entry->frameTime += time;
+	}
+};
+
+#endif  // __SCA_PYTHONPROFILER_H__
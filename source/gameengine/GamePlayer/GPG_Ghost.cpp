@@ -498,13 +498,24 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	CM_Message("       show_armatures                 0         Show debug armatures");
 	CM_Message("       show_camera_frustum            0         Show debug camera frustum volume");
 	CM_Message("       show_shadow_frustum            0         Show debug light shadow frustum volume");
-	CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings" << std::endl);
+	CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings");
+	CM_Message("       deterministic                  0         Fixed time step, single threaded physics and seeded randoms");
+	CM_Message("       record_input                             Record the inputs of each frame to a file (deterministic)");
+	CM_Message("       replay_input                             Replay the inputs of a file and exit at its end (deterministic)");
+	CM_Message("       profile_trace                            Write a Chrome trace of the engine stages to a file at exit");
+	CM_Message("       profile_trace_threshold        0.0       Instead write a trace of each frame longer than this duration in seconds" << std::endl);
 	CM_Message("  -p: override python main loop script");
+	CM_Message("  -H: headless mode, run the logic, physics and animations without render at the tic rate");
+	CM_Message("      as fast as possible and report the frame rate");
+	CM_Message("       --Optional parameters--");
+	CM_Message("       frames = number of frames to run before exiting (default: until the game ends)");
+	CM_Message("       Example: -H  or  -H 10000" << std::endl);
 	CM_Message(std::endl);
 	CM_Message("  - : all arguments after this are ignored, allowing python to access them from sys.argv");
 	CM_Message(std::endl);
 	CM_Message("example: " << program << " -w 320 200 10 10 -g noaudio " << example_pathname << example_filename);
 	CM_Message("example: " << program << " -g show_framerate = 0 " << example_pathname << example_filename);
+	CM_Message("example: " << program << " -H -g replay_input = session.bgei " << example_pathname << example_filename);
 	CM_Message("example: " << program << " -i 232421 -m 16 " << example_pathname << example_filename);
 }
 
@@ -814,6 +825,8 @@ int main(int argc,
 	int validArguments = 0;
 	bool samplesParFound = false;
 	std::string pythonControllerFile;
+	bool headless = false;
+	unsigned int headlessFrames = 0;
 	GHOST_TUns16 aasamples = 0;
 	int alphaBackground = 0;
 
@@ -1233,6 +1246,15 @@ int main(int argc,
 					pythonControllerFile = argv[i++];
 					break;
 				}
+				case 'H': // headless mode
+				{
+					++i;
+					headless = true;
+					if ((i + 1) <= validArguments && argv[i][0] != '-') {
+						headlessFrames = atoi(argv[i++]);
+					}
+					break;
+				}
 				default: //not recognized
 				{
 					CM_Warning("unknown argument: " << argv[i++]);
@@ -1451,7 +1473,10 @@ int main(int argc,
 						if (firstTimeRunning) {
 							firstTimeRunning = false;
 
-							if (fullScreen) {
+							if (headless) {
+								// No window, OpenGL context nor GPU module, the engine runs without rasterizer.
+							}
+							else if (fullScreen) {
 #ifdef WIN32
 								if (scr_saver_mode == SCREEN_SAVER_MODE_SAVER) {
 									window = startScreenSaverFullScreen(system, fullScreenWidth, fullScreenHeight,
@@ -1515,15 +1540,17 @@ int main(int argc,
 								}
 							}
 
-							GPU_init();
+							if (!headless) {
+								GPU_init();
 
-							if (SYS_GetCommandLineInt(syshandle, "nomipmap", 0)) {
-								GPU_set_mipmap(G.main, 0);
-							}
+								if (SYS_GetCommandLineInt(syshandle, "nomipmap", 0)) {
+									GPU_set_mipmap(G.main, 0);
+								}
 
-							GPU_set_anisotropic(G.main, U.anisotropic_filter);
-							GPU_set_gpu_mipmapping(G.main, U.use_gpu_mipmap);
-							GPU_set_linear_mipmap(true);
+								GPU_set_anisotropic(G.main, U.anisotropic_filter);
+								GPU_set_gpu_mipmapping(G.main, U.use_gpu_mipmap);
+								GPU_set_linear_mipmap(true);
+							}
 						}
 
 						// This argc cant be argc_py_clamped, since python uses it.
@@ -1534,6 +1561,8 @@ int main(int argc,
 						launcher.SetPythonGlobalDict(globalDict);
 #endif  // WITH_PYTHON
 
+						launcher.SetHeadless(headless, headlessFrames);
+
 						launcher.InitEngine();
 
 						// Enter main loop
@@ -1550,7 +1579,9 @@ int main(int argc,
 				} while (ELEM(exitInfo.m_code, KX_ExitInfo::RESTART_GAME, KX_ExitInfo::START_OTHER_GAME));
 			}
 
-			GPU_exit();
+			if (!headless) {
+				GPU_exit();
+			}
 
 #ifdef WITH_PYTHON
 			PyDict_Clear(globalDict);
@@ -1561,10 +1592,10 @@ int main(int argc,
 			// Seg Fault; icon.c gIcons == 0
 			BKE_icons_free();
 
-			window->setCursorShape(GHOST_kStandardCursorDefault);
-			window->setCursorVisibility(true);
-
 			if (window) {
+				window->setCursorShape(GHOST_kStandardCursorDefault);
+				window->setCursorVisibility(true);
+
 				system->disposeWindow(window);
 			}
 
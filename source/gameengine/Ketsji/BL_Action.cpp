@@ -307,6 +307,22 @@ void BL_Action::ResetStartTime(float curtime)
 	SetLocalTime(curtime);
 }
 
+float BL_Action::GetQuantizedFrame() const
+{
+	KX_KetsjiEngine *engine = KX_GetActiveEngine();
+	/* Without restricted animation the animations are updated at each render with
+	 * the exact elapsed time, any rounding would be visible. */
+	if (m_speed == 0.0f || !engine->GetFlag(KX_KetsjiEngine::RESTRICT_ANIMATION) || engine->GetTicRate() <= 0.0) {
+		return m_localframe;
+	}
+
+	// Each logic frame moves the action by this number of frames.
+	const float step = fabsf(m_speed) * (float)(engine->GetAnimFrameRate() / engine->GetTicRate());
+	const float frame = m_startframe + roundf((m_localframe - m_startframe) / step) * step;
+
+	return std::min(std::max(frame, std::min(m_startframe, m_endframe)), std::max(m_startframe, m_endframe));
+}
+
 void BL_Action::IncrementBlending(float curtime)
 {
 	// Setup m_blendstart if we need to
@@ -339,13 +355,33 @@ void BL_Action::BlendShape(Key *key, float srcweight, std::vector<float>& blends
 	}
 }
 
+bool BL_Action::GetPoseKey(std::vector<bAction *>& actions, std::vector<float>& values) const
+{
+	// The blend in depends on the pose of the previous action.
+	if (m_blendin && m_blendframe < m_blendin) {
+		return false;
+	}
+
+	actions.push_back(m_tmpaction);
+	values.insert(values.end(), {GetQuantizedFrame(), m_layer_weight, (float)m_blendmode});
+
+	return true;
+}
+
 void BL_Action::Update(float curtime, bool applyToObject)
+{
+	if (UpdateFrame(curtime, applyToObject)) {
+		Apply(curtime, true);
+	}
+}
+
+bool BL_Action::UpdateFrame(float curtime, bool applyToObject)
 {
 	/* Don't bother if we're done with the animation and if the animation was already applied to the object.
 	 * of if the animation made a double update for the same time and that it was applied to the object.
 	 */
 	if ((m_done || m_prevUpdate == curtime) && m_appliedToObject) {
-		return;
+		return false;
 	}
 	m_prevUpdate = curtime;
 
@@ -399,9 +435,12 @@ void BL_Action::Update(float curtime, bool applyToObject)
 
 	m_appliedToObject = applyToObject;
 	// In case of culled armatures (doesn't requesting to transform the object) we only manages time.
-	if (!applyToObject) {
-		return;
-	}
+	return applyToObject;
+}
+
+void BL_Action::Apply(float curtime, bool applyPose)
+{
+	curtime -= (float)m_obj->GetScene()->GetSuspendedDelta();
 
 	m_requestIpo = true;
 
@@ -415,28 +454,32 @@ void BL_Action::Update(float curtime, bool applyToObject)
 	if (m_obj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
 		BL_ArmatureObject *obj = (BL_ArmatureObject *)m_obj;
 
-		if (m_layer_weight >= 0) {
-			obj->GetPose(&m_blendpose);
-		}
+		// The pose is not evaluated when it was copied from an other instance.
+		if (applyPose) {
+			if (m_layer_weight >= 0) {
+				obj->GetPose(&m_blendpose);
+			}
 
-		// Extract the pose from the action
-		obj->SetPoseByAction(m_tmpaction, m_localframe);
+			/* Extract the pose from the action, with restricted animation the frame is quantized for
+			 * the armatures sharing their poses to increase the chance of identical poses between instances. */
+			obj->SetPoseByAction(m_tmpaction, obj->GetUsePoseCache() ? GetQuantizedFrame() : m_localframe);
 
-		// Handle blending between armature actions
-		if (m_blendin && m_blendframe < m_blendin) {
-			IncrementBlending(curtime);
+			// Handle blending between armature actions
+			if (m_blendin && m_blendframe < m_blendin) {
+				IncrementBlending(curtime);
 
-			// Calculate weight
-			float weight = 1.f - (m_blendframe / m_blendin);
+				// Calculate weight
+				float weight = 1.f - (m_blendframe / m_blendin);
 
-			// Blend the poses
-			obj->BlendInPose(m_blendinpose, weight, ACT_BLEND_BLEND);
-		}
+				// Blend the poses
+				obj->BlendInPose(m_blendinpose, weight, ACT_BLEND_BLEND);
+			}
 
 
-		// Handle layer blending
-		if (m_layer_weight >= 0) {
-			obj->BlendInPose(m_blendpose, m_layer_weight, m_blendmode);
+			// Handle layer blending
+			if (m_layer_weight >= 0) {
+				obj->BlendInPose(m_blendpose, m_layer_weight, m_blendmode);
+			}
 		}
 
 		obj->UpdateTimestep(curtime);
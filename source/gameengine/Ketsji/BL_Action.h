@@ -81,6 +81,8 @@ private:
 	void InitIPO();
 	void SetLocalTime(float curtime);
 	void ResetStartTime(float curtime);
+	/// Return the local frame rounded to the frames reached at each logic frame when the animations are restricted.
+	float GetQuantizedFrame() const;
 	void IncrementBlending(float curtime);
 	void BlendShape(struct Key* key, float srcweight, std::vector<float>& blendshape);
 public:
@@ -111,6 +113,19 @@ public:
 	 * else it only manages action's' time/end.
 	 */
 	void Update(float curtime, bool applyToObject);
+	/** Update the action's frame without applying it.
+	 * \return True if the action must be applied to the object with Apply.
+	 */
+	bool UpdateFrame(float curtime, bool applyToObject);
+	/** Apply the action at its current frame to the object.
+	 * \param applyPose Set to false when the armature pose was already copied from an instance playing
+	 * the same actions, only the IPOs and the time step are then updated.
+	 */
+	void Apply(float curtime, bool applyPose);
+	/** Append the state defining the armature pose set by the action to a pose cache key.
+	 * \return False if the pose can't be shared because of a blend in.
+	 */
+	bool GetPoseKey(std::vector<bAction *>& actions, std::vector<float>& values) const;
 	/**
 	 * Update object IPOs (note: not thread-safe!)
 	 */
@@ -21,6 +21,9 @@
 #include "BL_Action.h"
 #include "BL_ActionData.h"
 #include "BL_ActionManager.h"
+#include "BL_ArmatureObject.h"
+#include "BL_PoseCache.h"
+#include "KX_Scene.h"
 
 BL_ActionManager::BL_ActionManager(class KX_GameObject *obj) :
 	m_obj(obj),
@@ -167,11 +170,51 @@ bool BL_ActionManager::IsSuspended() const
 
 void BL_ActionManager::Update(float curtime, bool applyToObject)
 {
-	for (const auto& pair : m_layers) {
-		pair.second->Update(curtime, applyToObject);
+	if (applyToObject && m_obj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE &&
+	    static_cast<BL_ArmatureObject *>(m_obj)->GetUsePoseCache())
+	{
+		UpdateSharedPose(curtime);
+	}
+	else {
+		for (const auto& pair : m_layers) {
+			pair.second->Update(curtime, applyToObject);
+		}
 	}
 
 	for (const auto& pair : m_layers) {
 		pair.second->UpdateIPOs();
 	}
 }
+
+void BL_ActionManager::UpdateSharedPose(float curtime)
+{
+	// Update the frames first, they identify the pose set by the actions.
+	std::vector<BL_Action *> actions;
+	BL_PoseCache::Key key;
+	bool shared = true;
+	for (const auto& pair : m_layers) {
+		BL_Action *action = pair.second;
+		if (action->UpdateFrame(curtime, true)) {
+			actions.push_back(action);
+			shared = shared && action->GetPoseKey(key.m_actions, key.m_transforms);
+		}
+	}
+
+	if (actions.empty()) {
+		return;
+	}
+
+	BL_ArmatureObject *armature = static_cast<BL_ArmatureObject *>(m_obj);
+	BL_PoseCache& poseCache = m_obj->GetScene()->GetPoseCache();
+	BL_PoseCache::ActionEntry *entry = nullptr;
+	const bool cached = shared && poseCache.GetActionPose(std::move(key), armature->GetOrigArmatureObject(),
+	                                                      armature->GetArmatureObject(), entry);
+
+	for (BL_Action *action : actions) {
+		action->Apply(curtime, !cached);
+	}
+
+	if (entry) {
+		poseCache.StoreActionPose(entry, armature->GetArmatureObject());
+	}
+}
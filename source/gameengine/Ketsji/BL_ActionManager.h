@@ -49,6 +49,11 @@ private:
 	 */
 	BL_Action* GetAction(short layer) const;
 
+	/** Update the actions of an armature sharing its poses, the local transforms set by the actions
+	 * are copied from an instance playing the same actions at the same frames when possible.
+	 */
+	void UpdateSharedPose(float curtime);
+
 public:
 	BL_ActionManager(class KX_GameObject* obj);
 	~BL_ActionManager();
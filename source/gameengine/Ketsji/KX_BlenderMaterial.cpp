@@ -20,6 +20,8 @@
 
 #include "KX_BlenderMaterial.h"
 #include "KX_Scene.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 #include "KX_PyMath.h"
 
 #include "BL_Shader.h"
@@ -898,6 +900,11 @@ EXP_PYMETHODDEF_DOC(KX_BlenderMaterial, getShader, "getShader()")
 	// returns Py_None on error
 	// the calling script will need to check
 
+	// Without rasterizer (headless mode) no shaders can be compiled.
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		Py_RETURN_NONE;
+	}
+
 	if (!m_shader) {
 		m_shader = new BL_Shader(this);
 	}
@@ -3,27 +3,24 @@
 
 #include "SG_Node.h"
 
+#include "BLI_utildefines.h"
+
 #include "tbb/tbb.h"
 
-class CullTask
+/// Update the bounding volume of the renderable objects and collect them.
+class BoundsTask
 {
 public:
-	std::vector<KX_GameObject *> m_activeObjects;
+	std::vector<KX_GameObject *> m_renderableObjects;
 	EXP_ListValue<KX_GameObject> *m_objects;
-	KX_CullingHandler& m_handler;
-	int m_layer;
 
-	CullTask(EXP_ListValue<KX_GameObject> *objects, KX_CullingHandler& handler, int layer)
-		:m_objects(objects),
-		m_handler(handler),
-		m_layer(layer)
+	BoundsTask(EXP_ListValue<KX_GameObject> *objects)
+		:m_objects(objects)
 	{
 	}
 
-	CullTask(const CullTask& other, tbb::split)
-		:m_objects(other.m_objects),
-		m_handler(other.m_handler),
-		m_layer(other.m_layer)
+	BoundsTask(const BoundsTask& other, tbb::split)
+		:m_objects(other.m_objects)
 	{
 	}
 
@@ -31,55 +28,87 @@ public:
 	{
 		for (unsigned int i = r.begin(), end = r.end(); i < end; ++i) {
 			KX_GameObject *obj = m_objects->GetValue(i);
-			if (obj->Renderable(m_layer)) {
+			// Layer 0 accepts objects of any layer, the layer of each view is checked later.
+			if (obj->Renderable(0)) {
 				// Update the object bounding volume box.
 				obj->UpdateBounds(false);
-
-				const bool culled = m_handler.Test(obj->NodeGetWorldTransform(), obj->NodeGetWorldScaling(), obj->GetAabb());
-
-				obj->SetCulled(culled);
-				if (!culled) {
-					m_activeObjects.push_back(obj);
-				}
+				m_renderableObjects.push_back(obj);
 			}
 		}
 	}
 
-	void join(const CullTask& other)
+	void join(const BoundsTask& other)
 	{
-		m_activeObjects.insert(m_activeObjects.end(), other.m_activeObjects.begin(), other.m_activeObjects.end());
+		m_renderableObjects.insert(m_renderableObjects.end(), other.m_renderableObjects.begin(), other.m_renderableObjects.end());
 	}
 };
 
+KX_CullingHandler::KX_CullingHandler(EXP_ListValue<KX_GameObject> *objects)
+	:m_objects(objects)
+{
+}
+
 KX_CullingHandler::KX_CullingHandler(EXP_ListValue<KX_GameObject> *objects, const SG_Frustum& frustum, int layer)
-	:m_objects(objects),
-	m_frustum(frustum),
-	m_layer(layer)
+	:m_objects(objects)
 {
+	AddView(frustum, layer);
 }
 
-bool KX_CullingHandler::Test(const mt::mat3x4& trans, const mt::vec3& scale, const SG_BBox& aabb) const
+void KX_CullingHandler::AddView(const SG_Frustum& frustum, int layer)
 {
-	bool culled = true;
-	const float maxscale = std::max(std::max(fabs(scale.x), fabs(scale.y)), fabs(scale.z));
-	const SG_Frustum::TestType sphereTest = m_frustum.SphereInsideFrustum(trans * aabb.GetCenter(), maxscale * aabb.GetRadius());
+	m_views.push_back({&frustum, layer});
+}
+
+std::vector<std::vector<KX_GameObject *> > KX_CullingHandler::ProcessViews()
+{
+	BoundsTask task(m_objects);
+	tbb::parallel_reduce(tbb::blocked_range<size_t>(0, m_objects->GetCount()), task);
+
+	const std::vector<KX_GameObject *>& renderableObjects = task.m_renderableObjects;
+	const unsigned int size = renderableObjects.size();
 
-	// First test if the sphere is in the frustum as it is faster to test than box.
-	if (sphereTest == SG_Frustum::INSIDE) {
-		culled = false;
+	m_batch.Clear();
+	for (KX_GameObject *obj : renderableObjects) {
+		m_batch.Add(obj->NodeGetWorldTransform(), obj->NodeGetWorldScaling(), obj->GetAabb());
 	}
-	// If the sphere intersects we made a box test because the box could be not homogeneous.
-	else if (sphereTest == SG_Frustum::INTERSECT) {
-		const mt::mat4 mat = mt::mat4::FromAffineTransform(trans);
-		culled = (m_frustum.AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) == SG_Frustum::OUTSIDE);
+
+	std::vector<std::vector<KX_GameObject *> > activeObjects(m_views.size());
+	// Objects tested by at least one view, objects of no view layer keep their culling state.
+	std::vector<bool> testedObjects(size, false);
+	// Objects visible in at least one view.
+	std::vector<bool> visibleObjects(size, false);
+
+	SG_CullingBatch::VisibilityMask mask;
+	for (unsigned short i = 0, numviews = m_views.size(); i < numviews; ++i) {
+		const View& view = m_views[i];
+		m_batch.Test(*view.m_frustum, mask);
+
+		std::vector<KX_GameObject *>& viewObjects = activeObjects[i];
+		for (unsigned int j = 0; j < size; ++j) {
+			KX_GameObject *obj = renderableObjects[j];
+			if (!obj->Renderable(view.m_layer)) {
+				continue;
+			}
+
+			testedObjects[j] = true;
+			if (SG_CullingBatch::IsVisible(mask, j)) {
+				viewObjects.push_back(obj);
+				visibleObjects[j] = true;
+			}
+		}
 	}
 
-	return culled;
+	for (unsigned int i = 0; i < size; ++i) {
+		if (testedObjects[i]) {
+			renderableObjects[i]->SetCulled(!visibleObjects[i]);
+		}
+	}
+
+	return activeObjects;
 }
 
 std::vector<KX_GameObject *> KX_CullingHandler::Process()
 {
-	CullTask task(m_objects, *this, m_layer);
-	tbb::parallel_reduce(tbb::blocked_range<size_t>(0, m_objects->GetCount()), task);
-	return task.m_activeObjects;
+	BLI_assert(m_views.size() == 1);
+	return ProcessViews().front();
 }
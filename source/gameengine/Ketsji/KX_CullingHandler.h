@@ -3,6 +3,7 @@
 
 #include "SG_Frustum.h"
 #include "SG_BBox.h"
+#include "SG_CullingBatch.h"
 
 #include "EXP_ListValue.h"
 
@@ -16,22 +17,39 @@ class KX_GameObject;
 
 class KX_CullingHandler
 {
+public:
+	/// Frustum and layer of a view to cull.
+	struct View
+	{
+		const SG_Frustum *m_frustum;
+		/// Layer to ignore some objects.
+		int m_layer;
+	};
+
 private:
 	/// List of all objects to test.
 	EXP_ListValue<KX_GameObject> *m_objects;
-	/// The camera frustum data.
-	const SG_Frustum& m_frustum;
-	/// Layer to ignore some objects.
-	int m_layer;
-
+	/// Views to cull the objects for.
+	std::vector<View> m_views;
+	/// Packed bounding volumes of the renderable objects.
+	SG_CullingBatch m_batch;
 
 public:
+	KX_CullingHandler(EXP_ListValue<KX_GameObject> *objects);
 	KX_CullingHandler(EXP_ListValue<KX_GameObject> *objects, const SG_Frustum& frustum, int layer);
 	~KX_CullingHandler() = default;
 
-	bool Test(const mt::mat3x4& trans, const mt::vec3& scale, const SG_BBox& aabb) const;
+	/// Add a view to cull, the frustum must be kept alive until the processing.
+	void AddView(const SG_Frustum& frustum, int layer);
+
+	/** Process the culling of all objects for all views in a single pass over the objects.
+	 * The bounding volumes are updated and packed once and then tested against each view.
+	 * An object is tagged culled when it is culled in all the views using its layer.
+	 * \return A list of non-culled objects per view.
+	 */
+	std::vector<std::vector<KX_GameObject *> > ProcessViews();
 
-	/// Process the culling of all object and return a list of non-culled objects.
+	/// Process the culling of all object for the only view and return a list of non-culled objects.
 	std::vector<KX_GameObject *> Process();
 };
 
@@ -36,6 +36,7 @@
 #include "RAS_Mesh.h"
 #include "RAS_MeshUser.h"
 #include "RAS_BoundingBoxManager.h"
+#include "RAS_BoundingVolumeTree.h"
 #include "RAS_Deformer.h"
 #include "KX_NavMeshObject.h"
 #include "KX_Mesh.h"
@@ -109,6 +110,7 @@ KX_GameObject::KX_GameObject()
 	m_bVisible(true),
 	m_bOccluder(false),
 	m_autoUpdateBounds(false),
+	m_boundingVolumeProxy(RAS_BoundingVolumeTree::NULL_NODE),
 	m_physicsController(nullptr),
 	m_graphicController(nullptr),
 	m_components(nullptr),
@@ -139,6 +141,7 @@ KX_GameObject::KX_GameObject(const KX_GameObject& other)
 	m_bOccluder(other.m_bOccluder),
 	m_activityCullingInfo(other.m_activityCullingInfo),
 	m_autoUpdateBounds(other.m_autoUpdateBounds),
+	m_boundingVolumeProxy(RAS_BoundingVolumeTree::NULL_NODE),
 	m_physicsController(nullptr),
 	m_graphicController(nullptr),
 	m_components(nullptr),
@@ -222,6 +225,7 @@ std::string KX_GameObject::GetName()
 void KX_GameObject::SetName(const std::string& name)
 {
 	m_name = name;
+	NameChanged();
 }
 
 RAS_Deformer *KX_GameObject::GetDeformer()
@@ -799,6 +803,11 @@ KX_LodManager *KX_GameObject::GetLodManager() const
 	return m_lodManager;
 }
 
+short KX_GameObject::GetCurrentLodLevel() const
+{
+	return m_currentLodLevel;
+}
+
 void KX_GameObject::UpdateLod(KX_Scene *scene, const mt::vec3& cam_pos, float lodfactor)
 {
 	if (!m_lodManager) {
@@ -859,7 +868,13 @@ void KX_GameObject::UpdateTransform()
 
 void KX_GameObject::UpdateTransformFunc(SG_Node *node, SG_Object *gameobj, SG_Scene *scene)
 {
-	((KX_GameObject *)gameobj)->UpdateTransform();
+	KX_GameObject *obj = (KX_GameObject *)gameobj;
+	obj->UpdateTransform();
+
+	// Refit the object in the scene bounding volume tree, the new objects are scheduled by the scene.
+	if (obj->m_boundingVolumeProxy != RAS_BoundingVolumeTree::NULL_NODE) {
+		static_cast<KX_Scene *>(scene)->ScheduleBoundingVolumeUpdate(obj);
+	}
 }
 
 void KX_GameObject::SynchronizeTransform()
@@ -1401,6 +1416,11 @@ void KX_GameObject::UpdateBounds(bool force)
 
 	m_aabb.Set(aabbMin, aabbMax);
 	UpdateGraphicController();
+
+	// Notify the scene bounding volume tree.
+	if (m_boundingVolumeProxy != RAS_BoundingVolumeTree::NULL_NODE) {
+		GetScene()->ScheduleBoundingVolumeUpdate(this);
+	}
 }
 
 void KX_GameObject::UpdateGraphicController()
@@ -1410,6 +1430,32 @@ void KX_GameObject::UpdateGraphicController()
 	}
 }
 
+void KX_GameObject::GetWorldAabb(mt::vec3& min, mt::vec3& max) const
+{
+	const mt::mat3x4& trans = m_node->GetWorldTransform();
+	const mt::vec3 center = trans * ((m_aabb.GetMin() + m_aabb.GetMax()) * 0.5f);
+	const mt::vec3 halfExtents = (m_aabb.GetMax() - m_aabb.GetMin()) * 0.5f;
+	mt::vec3 extents = mt::zero3;
+	for (unsigned short i = 0; i < 3; ++i) {
+		for (unsigned short j = 0; j < 3; ++j) {
+			extents[i] += fabs(trans(i, j)) * halfExtents[j];
+		}
+	}
+
+	min = center - extents;
+	max = center + extents;
+}
+
+int KX_GameObject::GetBoundingVolumeProxy() const
+{
+	return m_boundingVolumeProxy;
+}
+
+void KX_GameObject::SetBoundingVolumeProxy(int proxy)
+{
+	m_boundingVolumeProxy = proxy;
+}
+
 KX_GameObject::ActivityCullingInfo& KX_GameObject::GetActivityCullingInfo()
 {
 	return m_activityCullingInfo;
@@ -1452,6 +1498,48 @@ void KX_GameObject::RestorePhysics()
 	}
 }
 
+bool KX_GameObject::IsReusableReplica(KX_GameObject *original) const
+{
+	if (m_meshes != original->m_meshes || m_actionManager || m_instanceObjects || m_dupliGroupObject) {
+		return false;
+	}
+
+#ifdef WITH_PYTHON
+	// Collision callbacks set on the replica are registered in the physics environment.
+	if (m_collisionCallbacks != original->m_collisionCallbacks) {
+		return false;
+	}
+#endif  // WITH_PYTHON
+
+	return true;
+}
+
+void KX_GameObject::ResetReplica(KX_GameObject *original)
+{
+	ClearProperties();
+	for (const std::string& name : original->GetPropertyNames()) {
+		EXP_Value *prop = original->GetProperty(name)->GetReplica();
+		SetProperty(name, prop);
+		prop->Release();
+	}
+
+#ifdef WITH_PYTHON
+	if (m_attr_dict) {
+		PyDict_Clear(m_attr_dict);
+		Py_CLEAR(m_attr_dict);
+	}
+	if (original->m_attr_dict) {
+		m_attr_dict = PyDict_Copy(original->m_attr_dict);
+	}
+#endif  // WITH_PYTHON
+
+	m_objectColor = original->m_objectColor;
+	m_passIndex = original->m_passIndex;
+	m_bOccluder = original->m_bOccluder;
+	// Also activate the graphic controller.
+	SetVisible(original->m_bVisible, false);
+}
+
 void KX_GameObject::UnregisterCollisionCallbacks()
 {
 	if (!m_physicsController) {
@@ -3903,12 +3991,10 @@ KX_GameObject::RayCastData::RayCastData(const std::string& prop, bool xray, unsi
 {
 }
 
-static bool CheckRayCastObject(KX_GameObject *obj, KX_GameObject::RayCastData *rayData)
+bool KX_GameObject::RayCastData::CheckObject(KX_GameObject *obj) const
 {
-	const std::string& prop = rayData->m_prop;
-	const unsigned int mask = rayData->m_mask;
 	// Check if the object had a given property (if this one is non empty) and have the correct group mask (if this one is different from 0xFFFF).
-	return ((prop.empty() || obj->GetProperty(prop)) && (mask == ((1u << OB_MAX_COL_MASKS) - 1) || obj->GetCollisionGroup() & mask));
+	return ((m_prop.empty() || obj->GetProperty(m_prop)) && (m_mask == ((1u << OB_MAX_COL_MASKS) - 1) || obj->GetCollisionGroup() & m_mask));
 }
 
 bool KX_GameObject::RayHit(KX_ClientObjectInfo *client, KX_RayCast *result, RayCastData *rayData)
@@ -3917,7 +4003,7 @@ bool KX_GameObject::RayHit(KX_ClientObjectInfo *client, KX_RayCast *result, RayC
 
 	// if X-ray option is selected, the unwanted objects were not tested, so get here only with true hit
 	// if not, all objects were tested and the front one may not be the correct one.
-	if (rayData->m_xray || CheckRayCastObject(obj, rayData)) {
+	if (rayData->m_xray || rayData->CheckObject(obj)) {
 		rayData->m_hitObject = obj;
 	}
 	// return true to stop RayCast::RayTest from looping, the above test was decisive
@@ -3934,7 +4020,7 @@ bool KX_GameObject::NeedRayCast(KX_ClientObjectInfo *client, RayCastData *rayDat
 
 	// if X-Ray option is selected, skip object that don't match the criteria as we see through them
 	// if not, test all objects because we don't know yet which one will be on front
-	return (!rayData->m_xray || CheckRayCastObject(obj, rayData));
+	return (!rayData->m_xray || rayData->CheckObject(obj));
 }
 
 EXP_PYMETHODDEF_DOC(KX_GameObject, rayCastTo,
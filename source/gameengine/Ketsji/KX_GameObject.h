@@ -118,6 +118,9 @@ protected:
 
 	bool								m_autoUpdateBounds;
 
+	/// Leaf of the object in the scene bounding volume tree.
+	int m_boundingVolumeProxy;
+
 	std::unique_ptr<PHY_IPhysicsController> m_physicsController;
 	std::unique_ptr<PHY_IGraphicController> m_graphicController;
 
@@ -142,6 +145,9 @@ public:
 	{
 		RayCastData(const std::string& prop, bool xray, unsigned int mask);
 
+		/// Return true if the object has the property and matches the collision mask.
+		bool CheckObject(KX_GameObject *obj) const;
+
 		std::string m_prop;
 		bool m_xray;
 		unsigned int m_mask;
@@ -639,6 +645,8 @@ public:
 	void SetLodManager(KX_LodManager *lodManager);
 	/// Get current lod manager.
 	KX_LodManager *GetLodManager() const;
+	/// Get the lod level computed by the last call to UpdateLod.
+	short GetCurrentLodLevel() const;
 
 	/**
 	 * Updates the current lod level based on distance from camera.
@@ -735,6 +743,12 @@ public:
 	/// Update the graphic controller bounding box with the scene graph one.
 	void UpdateGraphicController();
 
+	/// Compute the world axis aligned box of the oriented object box.
+	void GetWorldAabb(mt::vec3& min, mt::vec3& max) const;
+
+	int GetBoundingVolumeProxy() const;
+	void SetBoundingVolumeProxy(int proxy);
+
 	ActivityCullingInfo& GetActivityCullingInfo();
 	void SetActivityCullingInfo(const ActivityCullingInfo& cullingInfo);
 	/// Enable or disable a category of object activity culling.
@@ -743,6 +757,13 @@ public:
 	void SuspendPhysics(bool freeConstraints);
 	void RestorePhysics();
 
+	/** Return true if this replica of original can be parked by the scene object pool:
+	 * it must still use the meshes of original and not play any action.
+	 */
+	bool IsReusableReplica(KX_GameObject *original) const;
+	/// Restore the properties, color and visibility of original before the reuse of this replica.
+	void ResetReplica(KX_GameObject *original);
+
 	/**
 	 * Get the negative scaling state
 	 */
@@ -27,6 +27,7 @@
 #endif
 
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 
 #include <boost/format.hpp>
 #include <thread>
@@ -47,6 +48,7 @@
 #include "RAS_Query.h"
 #include "RAS_ILightObject.h"
 #include "SCA_IInputDevice.h"
+#include "SCA_PythonProfiler.h"
 #include "KX_Camera.h"
 #include "KX_LightObject.h"
 #include "KX_Globals.h"
@@ -57,12 +59,14 @@
 #include "KX_NetworkMessageScene.h"
 
 #include "DEV_Joystick.h" // for DEV_Joystick::HandleEvents
+#include "DEV_InputRecorder.h"
 #include "KX_PythonInit.h" // for updatePythonJoysticks
 
 #include "KX_WorldInfo.h"
 
 #include "BL_Converter.h"
 #include "BL_SceneConverter.h"
+#include "BL_PoseCache.h"
 
 #include "RAS_FramingManager.h"
 #include "DNA_world_types.h"
@@ -108,6 +112,7 @@ KX_KetsjiEngine::KX_KetsjiEngine()
 	m_pyprofiledict(PyDict_New()),
 #endif
 	m_inputDevice(nullptr),
+	m_inputRecorder(nullptr),
 	m_scenes(new EXP_ListValue<KX_Scene>()),
 	m_bInitialized(false),
 	m_flags(AUTO_ADD_DEBUG_PROPERTIES),
@@ -120,6 +125,9 @@ KX_KetsjiEngine::KX_KetsjiEngine()
 	m_ticrate(DEFAULT_LOGIC_TIC_RATE),
 	m_anim_framerate(25.0),
 	m_doRender(true),
+	m_traceThreshold(0.0),
+	m_traceFrameStart(0),
+	m_traceFrame(0),
 	m_exitKey(SCA_IInputDevice::ENDKEY),
 	m_logger(KX_TimeCategoryLogger(m_clock, 25)),
 	m_average_framerate(0.0),
@@ -130,8 +138,10 @@ KX_KetsjiEngine::KX_KetsjiEngine()
 	m_globalsettings({0}),
 	m_taskscheduler(BLI_task_scheduler_create(TASK_SCHEDULER_AUTO_THREADS))
 {
+	m_scenePool = BLI_task_pool_create(m_taskscheduler, &m_scenePoolData);
+
 	for (int i = tc_first; i < tc_numCategories; i++) {
-		m_logger.AddCategory((KX_TimeCategory)i);
+		m_logger.AddCategory((KX_TimeCategory)i, m_profileLabels[i].c_str());
 	}
 
 	m_renderQueries.emplace_back(RAS_Query::SAMPLES);
@@ -148,6 +158,10 @@ KX_KetsjiEngine::~KX_KetsjiEngine()
 	Py_CLEAR(m_pyprofiledict);
 #endif
 
+	if (m_scenePool) {
+		BLI_task_pool_free(m_scenePool);
+	}
+
 	if (m_taskscheduler) {
 		BLI_task_scheduler_free(m_taskscheduler);
 	}
@@ -161,6 +175,11 @@ void KX_KetsjiEngine::SetInputDevice(SCA_IInputDevice *inputDevice)
 	m_inputDevice = inputDevice;
 }
 
+void KX_KetsjiEngine::SetInputRecorder(DEV_InputRecorder *recorder)
+{
+	m_inputRecorder = recorder;
+}
+
 void KX_KetsjiEngine::SetCanvas(RAS_ICanvas *canvas)
 {
 	BLI_assert(canvas);
@@ -197,6 +216,9 @@ void KX_KetsjiEngine::StartEngine()
 	// Reset the clock to start at 0.0.
 	m_clock.Reset();
 
+	SCA_PythonProfiler::Reset();
+	SCA_PythonProfiler::SetEnabled(false);
+
 	m_bInitialized = true;
 }
 
@@ -249,8 +271,56 @@ void KX_KetsjiEngine::EndFrame()
 		PyDict_SetItemString(m_pyprofiledict, m_profileLabels[i].c_str(), val);
 		Py_DECREF(val);
 	}
+
+	// Per scene stage times of the last measurement.
+	PyObject *scenesDict = PyDict_New();
+	for (KX_Scene *scene : m_scenes) {
+		const KX_Scene::ProfileTimes& profileTimes = scene->GetProfileTimes();
+		const std::pair<const char *, double> stages[] = {
+			{"Logic:", profileTimes.logic},
+			{"Physics:", profileTimes.physics},
+			{"Scenegraph:", profileTimes.scenegraph}
+		};
+
+		PyObject *sceneDict = PyDict_New();
+		for (const std::pair<const char *, double>& stage : stages) {
+			PyObject *val = PyTuple_New(2);
+			PyTuple_SetItem(val, 0, PyFloat_FromDouble(stage.second * 1000.0));
+			PyTuple_SetItem(val, 1, PyFloat_FromDouble(stage.second / tottime * 100.0));
+
+			PyDict_SetItemString(sceneDict, stage.first, val);
+			Py_DECREF(val);
+		}
+
+		// Number of armature poses shared and evaluated.
+		const BL_PoseCache& poseCache = scene->GetPoseCache();
+		PyObject *poseCacheVal = Py_BuildValue("(II)", poseCache.GetHits(), poseCache.GetMisses());
+		PyDict_SetItemString(sceneDict, "Pose Cache:", poseCacheVal);
+		Py_DECREF(poseCacheVal);
+
+		// Number of armature actions poses shared and evaluated.
+		PyObject *actionCacheVal = Py_BuildValue("(II)", poseCache.GetActionHits(), poseCache.GetActionMisses());
+		PyDict_SetItemString(sceneDict, "Action Cache:", actionCacheVal);
+		Py_DECREF(actionCacheVal);
+
+		// Time spent and number of objects added by replication.
+		PyObject *replicationVal = Py_BuildValue("(dI)", profileTimes.replication * 1000.0, profileTimes.replicas);
+		PyDict_SetItemString(sceneDict, "Replication:", replicationVal);
+		Py_DECREF(replicationVal);
+
+		PyDict_SetItemString(scenesDict, scene->GetName().c_str(), sceneDict);
+		Py_DECREF(sceneDict);
+	}
+
+	PyDict_SetItemString(m_pyprofiledict, "Scenes", scenesDict);
+	Py_DECREF(scenesDict);
 #endif
 
+	for (KX_Scene *scene : m_scenes) {
+		scene->GetProfileTimes() = {0.0, 0.0, 0.0, 0.0, 0};
+		scene->GetPoseCache().ResetStats();
+	}
+
 	m_average_framerate = 1.0 / tottime;
 
 	// Go to next profiling measurement, time spent after this call is shown in the next frame.
@@ -299,9 +369,28 @@ KX_KetsjiEngine::FrameTimes KX_KetsjiEngine::GetFrameTimes()
 	// Get elapsed time.
 	const double dt = m_clockTime - m_previousRealTime;
 
+	/* Unthrottled frames don't depend on the elapsed time, the game time
+	 * advances of one tic each call, e.g. for simulations in a server. */
+	if (m_flags & UNTHROTTLED_FRAMERATE) {
+		m_previousRealTime = m_clockTime;
+
+		FrameTimes times;
+		times.frames = 1;
+		times.timestep = 1.0 / m_ticrate;
+		times.framestep = times.timestep * m_timescale;
+
+		return times;
+	}
+
+	/* Deterministic frames use the fixed time step like fixed framerate but never
+	 * catch up the elapsed time with several frames, the game time is then only
+	 * function of the number of frames proceeded.
+	 */
+	const bool fixedTimestep = (m_flags & (FIXED_FRAMERATE | DETERMINISTIC));
+
 	// Time of a frame (without scale).
 	double timestep;
-	if (m_flags & FIXED_FRAMERATE) {
+	if (fixedTimestep) {
 		// Normal time step for fixed frame.
 		timestep = 1.0 / m_ticrate;
 	}
@@ -312,7 +401,11 @@ KX_KetsjiEngine::FrameTimes KX_KetsjiEngine::GetFrameTimes()
 
 	// Number of frames to proceed.
 	int frames;
-	if (m_flags & FIXED_FRAMERATE) {
+	if (m_flags & DETERMINISTIC) {
+		// At most one for the elapsed time.
+		frames = (dt >= timestep) ? 1 : 0;
+	}
+	else if (m_flags & FIXED_FRAMERATE) {
 		// As many as possible for the elapsed time.
 		frames = int(dt * m_ticrate);
 	}
@@ -336,7 +429,7 @@ KX_KetsjiEngine::FrameTimes KX_KetsjiEngine::GetFrameTimes()
 		m_previousRealTime = m_clockTime;
 	}
 	// Else in case of fixed framerate, try to sleep until the next frame.
-	else if (m_flags & FIXED_FRAMERATE) {
+	else if (fixedTimestep) {
 		const double sleeptime = timestep - dt - 1.0e-3;
 		/* If the remaining time is greather than 1ms (sleep resolution) sleep this thread.
 		 * The other 1ms will be busy wait.
@@ -371,6 +464,17 @@ bool KX_KetsjiEngine::NextFrame()
 		return false;
 	}
 
+	UpdateProfileTrace();
+	SCA_PythonProfiler::SetShown(GetFlag(SHOW_PROFILE));
+	SCA_PythonProfiler::NextFrame();
+
+	CM_ProfileScope profileScope("NextFrame");
+
+	// Record the inputs of the frame or replace them by the recorded ones.
+	if (m_inputRecorder) {
+		m_inputRecorder->ProceedInputs(m_inputDevice);
+	}
+
 	// Fake release events for mouse movements only once.
 	m_inputDevice->ReleaseMoveEvent();
 
@@ -387,53 +491,86 @@ bool KX_KetsjiEngine::NextFrame()
 		}
 #endif  // WITH_SDL
 
-		// for each scene, call the proceed functions
-		for (KX_Scene *scene : m_scenes) {
-			/* Suspension holds the physics and logic processing for an
-			 * entire scene. Objects can be suspended individually, and
-			 * the settings for that precede the logic and physics
-			 * update. */
-			m_logger.StartLog(tc_logic);
+		if (m_inputRecorder) {
+			m_inputRecorder->ProceedJoysticks();
+		}
 
-			scene->UpdateObjectActivity();
+		if (m_flags & PARALLEL_SCENES) {
+			// Proceed the logic of all the scenes first as it runs python.
+			for (KX_Scene *scene : m_scenes) {
+				m_logger.StartLog(tc_logic);
+				scene->UpdateObjectActivity();
 
-			if (!scene->IsSuspended()) {
-				m_logger.StartLog(tc_physics);
-				// set Python hooks for each scene
-				KX_SetActiveScene(scene);
+				if (!scene->IsSuspended()) {
+					UpdateSceneLogic(scene, times);
+				}
+			}
 
-				// Process sensors, and controllers
-				m_logger.StartLog(tc_logic);
-				scene->LogicBeginFrame(m_frameTime, times.framestep);
+			// Then proceed the physics and scene graph of all the scenes in parallel.
+			m_logger.StartLog(tc_physics);
+			m_scenePoolData.clock = &m_clock;
+			m_scenePoolData.frameTime = m_frameTime;
+			m_scenePoolData.timestep = times.timestep;
+			m_scenePoolData.framestep = times.framestep;
+
+			std::vector<KX_Scene *> activeScenes;
+			for (KX_Scene *scene : m_scenes) {
+				if (!scene->IsSuspended()) {
+					activeScenes.push_back(scene);
+				}
+			}
 
-				// Scenegraph needs to be updated again, because Logic Controllers
-				// can affect the local matrices.
-				m_logger.StartLog(tc_scenegraph);
-				scene->UpdateParents();
+			/* The physics engine globals are set on the main thread, scenes
+			 * using different global settings are proceeded serially. */
+			bool sameSettings = true;
+			for (unsigned short i = 0; i < activeScenes.size() && sameSettings; ++i) {
+				PHY_IPhysicsEnvironment *env = activeScenes[i]->GetPhysicsEnvironment();
+				for (unsigned short j = i + 1; j < activeScenes.size() && sameSettings; ++j) {
+					sameSettings = env->HasSameGlobalSettings(activeScenes[j]->GetPhysicsEnvironment());
+				}
+			}
 
-				// Process actuators
+			if (sameSettings) {
+				for (KX_Scene *scene : activeScenes) {
+					scene->GetPhysicsEnvironment()->ApplyGlobalSettings();
+				}
 
-				// Do some cleanup work for this logic frame
-				m_logger.StartLog(tc_logic);
-				scene->LogicUpdateFrame(m_frameTime);
+				for (KX_Scene *scene : activeScenes) {
+					BLI_task_pool_push(m_scenePool, UpdateScenePhysicsTask, scene, false, TASK_PRIORITY_HIGH);
+				}
+
+				BLI_task_pool_work_and_wait(m_scenePool);
+			}
+			else {
+				for (KX_Scene *scene : activeScenes) {
+					scene->GetPhysicsEnvironment()->ApplyGlobalSettings();
+					UpdateScenePhysics(scene, m_clock, m_frameTime, times.timestep, times.framestep);
+				}
+			}
 
-				scene->LogicEndFrame();
+			m_logger.StartLog(tc_services);
+		}
+		else {
+			// for each scene, call the proceed functions
+			for (KX_Scene *scene : m_scenes) {
+				/* Suspension holds the physics and logic processing for an
+				 * entire scene. Objects can be suspended individually, and
+				 * the settings for that precede the logic and physics
+				 * update. */
+				m_logger.StartLog(tc_logic);
 
-				// Actuators can affect the scenegraph
-				m_logger.StartLog(tc_scenegraph);
-				scene->UpdateParents();
+				scene->UpdateObjectActivity();
 
-				m_logger.StartLog(tc_physics);
+				if (!scene->IsSuspended()) {
+					UpdateSceneLogic(scene, times);
 
-				// Perform physics calculations on the scene. This can involve
-				// many iterations of the physics solver.
-				scene->GetPhysicsEnvironment()->ProceedDeltaTime(m_frameTime, times.timestep, times.framestep);//m_deltatimerealDeltaTime);
+					m_logger.StartLog(tc_physics);
+					scene->GetPhysicsEnvironment()->ApplyGlobalSettings();
+					UpdateScenePhysics(scene, m_clock, m_frameTime, times.timestep, times.framestep);
+				}
 
-				m_logger.StartLog(tc_scenegraph);
-				scene->UpdateParents();
+				m_logger.StartLog(tc_services);
 			}
-
-			m_logger.StartLog(tc_services);
 		}
 
 		m_logger.StartLog(tc_network);
@@ -450,12 +587,127 @@ bool KX_KetsjiEngine::NextFrame()
 		ProcessScheduledScenes();
 	}
 
+	// The animations are updated by the cameras render, without render they are updated here.
+	if (!m_doRender) {
+		m_logger.StartLog(tc_animations);
+		for (KX_Scene *scene : m_scenes) {
+			UpdateAnimations(scene);
+		}
+	}
+
 	// Start logging time spent outside main loop
 	m_logger.StartLog(tc_outside);
 
 	return m_doRender;
 }
 
+void KX_KetsjiEngine::UpdateProfileTrace()
+{
+	if (!CM_Profiler::IsEnabled()) {
+		return;
+	}
+
+	const CM_Clock::Rep now = CM_Profiler::GetTime();
+	// The previous frame contains the logic and the render following it.
+	if (m_traceThreshold > 0.0 && m_traceFrameStart > 0 && (now - m_traceFrameStart) * 1.0e-9 > m_traceThreshold) {
+		std::string path = m_tracePath;
+		const std::string extension = ".json";
+		if (path.size() > extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+			path.erase(path.size() - extension.size());
+		}
+		path += "_" + std::to_string(m_traceFrame) + extension;
+
+		if (CM_Profiler::WriteTrace(path, m_traceFrameStart, now)) {
+			CM_Message("frame " << m_traceFrame << " took " << (now - m_traceFrameStart) * 1.0e-6
+			                    << " ms, profile trace written to \"" << path << "\"");
+		}
+	}
+
+	m_traceFrameStart = now;
+	++m_traceFrame;
+}
+
+/// Copy the scene name for a profile event only when the events are recorded.
+static std::string GetProfileSceneName(KX_Scene *scene)
+{
+	return CM_Profiler::IsEnabled() ? scene->GetName() : std::string();
+}
+
+void KX_KetsjiEngine::UpdateSceneLogic(KX_Scene *scene, const FrameTimes& times)
+{
+	const std::string sceneName = GetProfileSceneName(scene);
+	CM_ProfileScope profileScope("Logic", sceneName.c_str());
+
+	KX_Scene::ProfileTimes& profileTimes = scene->GetProfileTimes();
+	const double startTime = m_clock.GetTimeSecond();
+
+	m_logger.StartLog(tc_physics);
+	// set Python hooks for each scene
+	KX_SetActiveScene(scene);
+
+	// Process sensors, and controllers
+	m_logger.StartLog(tc_logic);
+	scene->LogicBeginFrame(m_frameTime, times.framestep);
+
+	const double logicBeginTime = m_clock.GetTimeSecond();
+	profileTimes.logic += logicBeginTime - startTime;
+
+	// Scenegraph needs to be updated again, because Logic Controllers
+	// can affect the local matrices.
+	m_logger.StartLog(tc_scenegraph);
+	scene->UpdateParents();
+
+	const double scenegraphTime = m_clock.GetTimeSecond();
+	profileTimes.scenegraph += scenegraphTime - logicBeginTime;
+
+	// Process actuators
+
+	// Do some cleanup work for this logic frame
+	m_logger.StartLog(tc_logic);
+	scene->LogicUpdateFrame(m_frameTime);
+
+	scene->LogicEndFrame();
+
+	const double logicEndTime = m_clock.GetTimeSecond();
+	profileTimes.logic += logicEndTime - scenegraphTime;
+
+	// Actuators can affect the scenegraph
+	m_logger.StartLog(tc_scenegraph);
+	scene->UpdateParents();
+	// Refit the moved objects even if the scene is not rendered.
+	scene->RefitBoundingVolumeTree();
+
+	profileTimes.scenegraph += m_clock.GetTimeSecond() - logicEndTime;
+}
+
+void KX_KetsjiEngine::UpdateScenePhysics(KX_Scene *scene, const CM_Clock& clock, double frameTime, double timestep, double framestep)
+{
+	const std::string sceneName = GetProfileSceneName(scene);
+	CM_ProfileScope profileScope("Physics", sceneName.c_str());
+
+	KX_Scene::ProfileTimes& profileTimes = scene->GetProfileTimes();
+	const double startTime = clock.GetTimeSecond();
+
+	// Perform physics calculations on the scene. This can involve
+	// many iterations of the physics solver.
+	scene->GetPhysicsEnvironment()->ProceedDeltaTime(frameTime, timestep, framestep);
+
+	const double physicsTime = clock.GetTimeSecond();
+	profileTimes.physics += physicsTime - startTime;
+
+	scene->UpdateParents();
+
+	profileTimes.scenegraph += clock.GetTimeSecond() - physicsTime;
+}
+
+void KX_KetsjiEngine::UpdateScenePhysicsTask(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+	const ScenePoolData *data = (ScenePoolData *)BLI_task_pool_userdata(pool);
+	KX_Scene *scene = (KX_Scene *)taskdata;
+
+	UpdateScenePhysics(scene, *data->clock, data->frameTime, data->timestep, data->framestep);
+}
+
 void KX_KetsjiEngine::UpdateSuspendedScenes(double framestep)
 {
 	for (KX_Scene *scene : m_scenes) {
@@ -601,6 +853,22 @@ KX_RenderSchedule KX_KetsjiEngine::ScheduleRender()
 			sceneSchedule.m_textureSchedules.insert(sceneSchedule.m_textureSchedules.end(), textureSchedule.begin(), textureSchedule.end());
 		}
 
+		// DBVT culling depends on the viewport of each view and is done while rendering the views.
+		if (!scene->GetDbvtCulling()) {
+			/* Update the animations before culling to use the deformed bounding boxes of this frame,
+			 * the armatures use the culling state of the previous frame. */
+			m_logger.StartLog(tc_animations);
+			UpdateAnimations(scene);
+
+			// Cull the objects for all the views of the scene at once.
+			m_logger.StartLog(tc_scenegraph);
+			sceneSchedule.m_culled = scene->CalculateVisibleMeshes(sceneSchedule);
+		}
+		else {
+			sceneSchedule.m_culled = false;
+		}
+		m_logger.StartLog(tc_rasterizer);
+
 		renderSchedule.m_sceneSchedules.push_back(sceneSchedule);
 	}
 
@@ -609,6 +877,8 @@ KX_RenderSchedule KX_KetsjiEngine::ScheduleRender()
 
 void KX_KetsjiEngine::Render()
 {
+	CM_ProfileScope profileScope("Render");
+
 	m_logger.StartLog(tc_rasterizer);
 
 	BeginFrame();
@@ -619,7 +889,7 @@ void KX_KetsjiEngine::Render()
 	// Render textures (shadows and renderers).
 	for (const KX_SceneRenderSchedule& sceneSchedule : renderSchedule.m_sceneSchedules) {
 		for (const KX_TextureRenderSchedule& textureSchedule : sceneSchedule.m_textureSchedules) {
-			RenderTexture(sceneSchedule.m_scene, textureSchedule);
+			RenderTexture(sceneSchedule.m_scene, textureSchedule, sceneSchedule.m_culled);
 		}
 	}
 
@@ -663,7 +933,7 @@ void KX_KetsjiEngine::Render()
 				// Draw the scene once for each camera with an enabled viewport or an active camera.
 				for (const KX_CameraRenderSchedule& cameraSchedule : sceneSchedule.m_cameraSchedules[eye]) {
 					// do the rendering
-					RenderCamera(scene, cameraSchedule, offScreen, pass++, isfirstscene);
+					RenderCamera(scene, cameraSchedule, offScreen, pass++, isfirstscene, sceneSchedule.m_culled);
 				}
 			}
 
@@ -744,21 +1014,29 @@ void KX_KetsjiEngine::UpdateAnimations(KX_Scene *scene)
 	scene->UpdateAnimations(m_frameTime, (m_flags & RESTRICT_ANIMATION) != 0);
 }
 
-void KX_KetsjiEngine::RenderTexture(KX_Scene *scene, const KX_TextureRenderSchedule& textureSchedule)
+void KX_KetsjiEngine::RenderTexture(KX_Scene *scene, const KX_TextureRenderSchedule& textureSchedule, bool culled)
 {
+	CM_ProfileScope profileScope("RenderTexture");
+
 	m_logger.StartLog(tc_scenegraph);
 
-	// Obtain visible renderable objects.
-	const std::vector<KX_GameObject *> objects = scene->CalculateVisibleMeshes(textureSchedule.m_frustum, textureSchedule.m_visibleLayers);
+	// Obtain visible renderable objects, if not already computed while scheduling.
+	std::vector<KX_GameObject *> culledObjects;
+	if (!culled) {
+		culledObjects = scene->CalculateVisibleMeshes(textureSchedule.m_frustum, textureSchedule.m_visibleLayers);
+	}
+	const std::vector<KX_GameObject *>& objects = (culled) ? textureSchedule.m_objects : culledObjects;
 
 	// Update levels of detail.
 	if (textureSchedule.m_mode & KX_TextureRenderSchedule::MODE_UPDATE_LOD) {
 		scene->UpdateObjectLods(textureSchedule.m_position, textureSchedule.m_lodFactor, objects);
 	}
 
-	m_logger.StartLog(tc_animations);
-
-	UpdateAnimations(scene);
+	// The animations were already updated before the culling while scheduling.
+	if (!culled) {
+		m_logger.StartLog(tc_animations);
+		UpdateAnimations(scene);
+	}
 
 	m_logger.StartLog(tc_rasterizer);
 
@@ -791,21 +1069,29 @@ void KX_KetsjiEngine::RenderTexture(KX_Scene *scene, const KX_TextureRenderSched
 }
 
 void KX_KetsjiEngine::RenderCamera(KX_Scene *scene, const KX_CameraRenderSchedule& cameraSchedule, RAS_OffScreen *offScreen,
-                                   unsigned short pass, bool isFirstScene)
+                                   unsigned short pass, bool isFirstScene, bool culled)
 {
+	const std::string sceneName = GetProfileSceneName(scene);
+	CM_ProfileScope profileScope("RenderCamera", sceneName.c_str());
 
 	KX_SetActiveScene(scene);
 
 	m_logger.StartLog(tc_scenegraph);
 
-	const std::vector<KX_GameObject *> objects = scene->CalculateVisibleMeshes(cameraSchedule.m_culling, cameraSchedule.m_frustum, 0);
+	std::vector<KX_GameObject *> culledObjects;
+	if (!culled) {
+		culledObjects = scene->CalculateVisibleMeshes(cameraSchedule.m_culling, cameraSchedule.m_frustum, 0);
+	}
+	const std::vector<KX_GameObject *>& objects = (culled) ? cameraSchedule.m_objects : culledObjects;
 
 	// update levels of detail
 	scene->UpdateObjectLods(cameraSchedule.m_position, cameraSchedule.m_lodFactor, objects);
 
-	m_logger.StartLog(tc_animations);
-
-	UpdateAnimations(scene);
+	// The animations were already updated before the culling while scheduling.
+	if (!culled) {
+		m_logger.StartLog(tc_animations);
+		UpdateAnimations(scene);
+	}
 
 	m_logger.StartLog(tc_rasterizer);
 
@@ -915,7 +1201,9 @@ void KX_KetsjiEngine::StopEngine()
 		}
 
 		// cleanup all the stuff
-		m_rasterizer->Exit();
+		if (m_rasterizer) {
+			m_rasterizer->Exit();
+		}
 	}
 }
 
@@ -1021,6 +1309,22 @@ void KX_KetsjiEngine::RenderDebugProperties()
 			m_debugDraw.RenderBox2d(mt::vec2(xcoord + (int)(2.2 * profile_indent), ycoord), boxSize, white);
 			ycoord += const_ysize;
 		}
+
+		// The most expensive Python scripts, components and draw callbacks.
+		std::vector<SCA_PythonProfiler::EntryPair> pythonEntries;
+		SCA_PythonProfiler::GetSortedEntries(pythonEntries);
+		if (!pythonEntries.empty()) {
+			m_debugDraw.RenderText2d("Python :", mt::vec2(xcoord + const_xindent + title_xmargin, ycoord), white);
+			ycoord += const_ysize;
+
+			for (unsigned short i = 0, size = std::min<unsigned short>(pythonEntries.size(), 5); i < size; ++i) {
+				const double time = pythonEntries[i].second->averageTime;
+				debugtxt = (boost::format("%5.2fms | %d%%") % (time * 1000.f) % (int)(time / tottime * 100.f)).str();
+				m_debugDraw.RenderText2d(debugtxt, mt::vec2(xcoord + const_xindent, ycoord), white);
+				m_debugDraw.RenderText2d(*pythonEntries[i].first, mt::vec2(xcoord + const_xindent + profile_indent, ycoord), white);
+				ycoord += const_ysize;
+			}
+		}
 	}
 
 	if (m_flags & SHOW_RENDER_QUERIES) {
@@ -1402,6 +1706,17 @@ bool KX_KetsjiEngine::GetRender()
 	return m_doRender;
 }
 
+void KX_KetsjiEngine::SetProfileTraceThreshold(double threshold, const std::string& path)
+{
+	m_traceThreshold = threshold;
+	m_tracePath = path;
+}
+
+double KX_KetsjiEngine::GetProfileTraceThreshold() const
+{
+	return m_traceThreshold;
+}
+
 void KX_KetsjiEngine::ProcessScheduledScenes()
 {
 	// Check whether there will be changes to the list of scenes
@@ -38,6 +38,7 @@
 #include <string>
 
 struct TaskScheduler;
+struct TaskPool;
 class KX_Scene;
 class KX_Camera;
 class BL_Converter;
@@ -46,6 +47,7 @@ class RAS_ICanvas;
 class RAS_OffScreen;
 class RAS_Query;
 class SCA_IInputDevice;
+class DEV_InputRecorder;
 template <class T>
 class EXP_ListValue;
 
@@ -107,7 +109,13 @@ public:
 		/// Automatic add debug properties to the debug list.
 		AUTO_ADD_DEBUG_PROPERTIES = (1 << 7),
 		/// Use override camera?
-		CAMERA_OVERRIDE = (1 << 8)
+		CAMERA_OVERRIDE = (1 << 8),
+		/// Proceed physics and scene graph of independent scenes in parallel?
+		PARALLEL_SCENES = (1 << 9),
+		/// Proceed one frame of fixed time step per call as fast as possible without waiting for the clock?
+		UNTHROTTLED_FRAMERATE = (1 << 10),
+		/// Proceed at most one frame of fixed time step per call to get reproducible simulations?
+		DETERMINISTIC = (1 << 11)
 	};
 
 private:
@@ -121,6 +129,15 @@ private:
 		double framestep;
 	};
 
+	/// Data shared by all the scene tasks of a logic frame.
+	struct ScenePoolData
+	{
+		const CM_Clock *clock;
+		double frameTime;
+		double timestep;
+		double framestep;
+	};
+
 	CM_Clock m_clock;
 	/// 2D Canvas (2D Rendering Device Context)
 	RAS_ICanvas *m_canvas;
@@ -134,6 +151,8 @@ private:
 	PyObject *m_pyprofiledict;
 #endif
 	SCA_IInputDevice *m_inputDevice;
+	/// Optional recorder or replayer of the inputs of each frame.
+	DEV_InputRecorder *m_inputRecorder;
 
 	/// Lists of scenes scheduled to be removed at the end of the frame.
 	std::vector<std::string> m_removingScenes;
@@ -169,6 +188,18 @@ private:
 
 	bool m_doRender;  /* whether or not the scene should be rendered after the logic frame */
 
+	/// Duration of a frame above which the profile trace is written, 0 to disable.
+	double m_traceThreshold;
+	/// Trace file path, suffixed by the frame number.
+	std::string m_tracePath;
+	/// Start time of the last frame in profiler time.
+	CM_Clock::Rep m_traceFrameStart;
+	/// Number of frames proceeded.
+	unsigned int m_traceFrame;
+
+	/// Write the events of the last frame when it exceeded the trace threshold.
+	void UpdateProfileTrace();
+
 	/// Key used to exit the BGE
 	SCA_IInputDevice::SCA_EnumInputs m_exitKey;
 
@@ -227,6 +258,9 @@ private:
 
 	/// Task scheduler for multi-threading
 	TaskScheduler *m_taskscheduler;
+	/// Task pool used to proceed scenes in parallel, see PARALLEL_SCENES.
+	TaskPool *m_scenePool;
+	ScenePoolData m_scenePoolData;
 
 	/** Set scene's total pause duration for animations process.
 	 * This is done in a separate loop to get the proper state of each scenes.
@@ -250,9 +284,11 @@ private:
 	/// Compute frame render data per eyes (in case of stereo), scenes and camera.
 	KX_RenderSchedule ScheduleRender();
 
-	/// Render scene along main off screen.
+	/** Render scene along main off screen.
+	 * \param culled True if the non-culled objects of the schedule were computed while scheduling.
+	 */
 	void RenderCamera(KX_Scene *scene, const KX_CameraRenderSchedule& cameraSchedule,
-			RAS_OffScreen *offScreen, unsigned short pass, bool isFirstScene);
+			RAS_OffScreen *offScreen, unsigned short pass, bool isFirstScene, bool culled);
 	/// Post render scene with filters and post draw call.
 	RAS_OffScreen *PostRenderScene(KX_Scene *scene, RAS_OffScreen *inputofs,
 			const KX_FrameRenderSchedule& frameSchedule, bool islastscene);
@@ -284,12 +320,25 @@ private:
 
 	FrameTimes GetFrameTimes();
 
+	/** Proceed the logic of a scene: sensors, controllers and actuators.
+	 * Python is run in this stage, it must always be called from the main thread.
+	 */
+	void UpdateSceneLogic(KX_Scene *scene, const FrameTimes& times);
+	/** Proceed the physics of a scene and the scene graph update following it.
+	 * This stage doesn't touch python and can be run in parallel for independent scenes.
+	 */
+	static void UpdateScenePhysics(KX_Scene *scene, const CM_Clock& clock, double frameTime, double timestep, double framestep);
+	/// Task function proceeding the physics of a scene, see PARALLEL_SCENES.
+	static void UpdateScenePhysicsTask(TaskPool *pool, void *taskdata, int threadid);
+
 public:
 	KX_KetsjiEngine();
 	virtual ~KX_KetsjiEngine();
 
 	/// set the devices and stuff. the client must take care of creating these
 	void SetInputDevice(SCA_IInputDevice *inputDevice);
+	/// Set the recorder of the inputs, the client must take care of deleting it.
+	void SetInputRecorder(DEV_InputRecorder *recorder);
 	void SetCanvas(RAS_ICanvas *canvas);
 	void SetRasterizer(RAS_Rasterizer *rasterizer);
 	void SetNetworkMessageManager(KX_NetworkMessageManager *manager);
@@ -356,8 +405,10 @@ public:
 	// Update animations for object in this scene
 	void UpdateAnimations(KX_Scene *scene);
 
-	/// Render scene along texture off screen.
-	void RenderTexture(KX_Scene *scene, const KX_TextureRenderSchedule& textureSchedule);
+	/** Render scene along texture off screen.
+	 * \param culled True if the non-culled objects of the schedule were computed while scheduling.
+	 */
+	void RenderTexture(KX_Scene *scene, const KX_TextureRenderSchedule& textureSchedule, bool culled = false);
 
 	bool GetFlag(FlagType flag) const;
 	/// Enable or disable a set of flags.
@@ -446,6 +497,12 @@ public:
 	 */
 	bool GetRender();
 
+	/** Write a profile trace of the frames longer than threshold, the frame number is appended to
+	 * the file path. A threshold of 0 disables it. The profiler must be enabled to record events.
+	 */
+	void SetProfileTraceThreshold(double threshold, const std::string& path);
+	double GetProfileTraceThreshold() const;
+
 	/// Allow debug bounding box debug.
 	void SetShowBoundingBox(KX_DebugOption mode);
 	/// Returns the current setting for bounding box debug.
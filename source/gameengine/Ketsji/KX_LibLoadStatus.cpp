@@ -88,6 +88,11 @@ KX_Scene *KX_LibLoadStatus::GetMergeScene() const
 	return m_mergescene;
 }
 
+const std::string& KX_LibLoadStatus::GetLibraryName() const
+{
+	return m_libname;
+}
+
 std::vector<BL_SceneConverter>& KX_LibLoadStatus::GetSceneConverters()
 {
 	return m_sceneConvertes;
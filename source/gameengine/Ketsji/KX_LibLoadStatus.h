@@ -67,6 +67,7 @@ public:
 	BL_Converter *GetConverter() const;
 	KX_KetsjiEngine *GetEngine() const;
 	KX_Scene *GetMergeScene() const;
+	const std::string& GetLibraryName() const;
 
 	std::vector<BL_SceneConverter>& GetSceneConverters();
 	void AddSceneConverter(KX_Scene *scene, const BL_Resource::Library& libraryId);
@@ -31,6 +31,7 @@
 #include "PHY_IPhysicsEnvironment.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IMotionState.h"
+#include "RAS_BoundingVolumeTree.h"
 
 KX_NearSensor::KX_NearSensor(SCA_EventManager *eventmgr,
                              KX_GameObject *gameobj,
@@ -73,6 +74,49 @@ void KX_NearSensor::SynchronizeTransform()
 		motionState->SetWorldOrientation(parent->NodeGetWorldOrientation());
 		m_physCtrl->WriteMotionStateToDynamics(true);
 	}
+	// Without sphere controller from the physics engine, the scene bounding volume tree is used.
+	else if (m_links && !m_suspended) {
+		TestBoundingVolumeTree();
+	}
+}
+
+void KX_NearSensor::TestBoundingVolumeTree()
+{
+	KX_GameObject *parent = static_cast<KX_GameObject *>(GetParent());
+	KX_Scene *scene = parent->GetScene();
+	scene->UpdateBoundingVolumeTree();
+
+	// Same radius as set to the physics controller by the last evaluation.
+	const float radius = m_bLastTriggered ? m_ResetMargin : m_Margin;
+	const mt::vec3& center = parent->NodeGetWorldPosition();
+	const mt::vec3 extents(radius, radius, radius);
+
+	scene->GetBoundingVolumeTree()->Query(center - extents, center + extents, [this, parent, &center, radius](void *userData) {
+		KX_GameObject *gameobj = static_cast<KX_GameObject *>(userData);
+		if (gameobj == parent || (!m_touchedpropname.empty() && !gameobj->GetProperty(m_touchedpropname))) {
+			return;
+		}
+
+		// Distance from the sphere center to the object world box.
+		mt::vec3 min;
+		mt::vec3 max;
+		gameobj->GetWorldAabb(min, max);
+		float distance2 = 0.0f;
+		for (unsigned short i = 0; i < 3; ++i) {
+			const float delta = std::max(std::max(min[i] - center[i], center[i] - max[i]), 0.0f);
+			distance2 += delta * delta;
+		}
+
+		if (distance2 > (radius * radius)) {
+			return;
+		}
+
+		if (!m_colliders->SearchValue(gameobj)) {
+			m_colliders->Add(CM_AddRef(gameobj));
+		}
+		m_bTriggered = true;
+		m_hitObject = gameobj;
+	});
 }
 
 EXP_Value *KX_NearSensor::GetReplica()
@@ -39,6 +39,10 @@ protected:
 	float  m_ResetMargin;
 
 	KX_ClientObjectInfo*	m_client_info;
+
+	/// Find the objects near the parent in the scene bounding volume tree.
+	void TestBoundingVolumeTree();
+
 public:
 	KX_NearSensor(class SCA_EventManager* eventmgr,
 	              class KX_GameObject* gameobj,
@@ -33,6 +33,8 @@
 
 #include "KX_PyMath.h"
 
+#include "BLI_utildefines.h"
+
 bool PyOrientationTo(PyObject *pyval, mt::mat3 &rot, const char *error_prefix)
 {
 	int size = PySequence_Size(pyval);
@@ -96,4 +98,67 @@ PyObject *PyColorFromVector(const mt::vec3 &vec)
 #endif
 }
 
+bool PyBufferToFloats(PyObject *pyval, unsigned int width, std::vector<float>& values, const char *error_prefix)
+{
+	Py_buffer view;
+	if (PyObject_GetBuffer(pyval, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1) {
+		PyErr_Format(PyExc_TypeError, "%s, expected a contiguous buffer of floats", error_prefix);
+		return false;
+	}
+
+	// Skip the native byte order prefix.
+	const char *format = view.format ? view.format : "B";
+	if (ELEM(format[0], '@', '=', '<')) {
+		++format;
+	}
+
+	const bool isFloat = (STREQ(format, "f") && view.itemsize == sizeof(float));
+	const bool isDouble = (STREQ(format, "d") && view.itemsize == sizeof(double));
+	const unsigned int count = view.len / view.itemsize;
+
+	if (!isFloat && !isDouble) {
+		PyErr_Format(PyExc_TypeError, "%s, expected a buffer of floats or doubles, not of format \"%s\"", error_prefix, view.format);
+		PyBuffer_Release(&view);
+		return false;
+	}
+	if ((count % width) != 0) {
+		PyErr_Format(PyExc_ValueError, "%s, expected a buffer size multiple of %u, not %u", error_prefix, width, count);
+		PyBuffer_Release(&view);
+		return false;
+	}
+
+	if (isFloat) {
+		const float *data = (const float *)view.buf;
+		values.assign(data, data + count);
+	}
+	else {
+		const double *data = (const double *)view.buf;
+		values.assign(data, data + count);
+	}
+
+	PyBuffer_Release(&view);
+	return true;
+}
+
+PyObject *PyBufferFromFloats(const float *values, unsigned int count, unsigned int width)
+{
+	PyObject *bytes = PyByteArray_FromStringAndSize((const char *)values, count * sizeof(float));
+	if (!bytes) {
+		return nullptr;
+	}
+
+	PyObject *view = PyMemoryView_FromObject(bytes);
+	Py_DECREF(bytes);
+	if (!view) {
+		return nullptr;
+	}
+
+	// The memory view keeps a reference to the byte array, a shape can't contain a null dimension.
+	PyObject *shaped = (count == 0) ? PyObject_CallMethod(view, "cast", "s", "f") :
+	                   PyObject_CallMethod(view, "cast", "s(II)", "f", count / width, width);
+	Py_DECREF(view);
+
+	return shaped;
+}
+
 #endif // WITH_PYTHON
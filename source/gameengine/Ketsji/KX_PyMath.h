@@ -30,6 +30,8 @@
 #include "EXP_Python.h"
 #include "EXP_PyObjectPlus.h"
 
+#include <vector>
+
 #ifdef WITH_PYTHON
 #ifdef USE_MATHUTILS
 extern "C" {
@@ -303,6 +305,18 @@ PyObject *PyObjectFrom(const float (&vec)[Size])
 #endif
 }
 
+/** Read a C contiguous buffer of floats or doubles, as a numpy array, into a list of floats.
+ * \param width The number of floats of an element, the buffer size must be a multiple of it.
+ * \param values The converted floats.
+ */
+bool PyBufferToFloats(PyObject *pyval, unsigned int width, std::vector<float>& values, const char *error_prefix);
+
+/** Create a memory view of a copy of floats with a shape (count / width, width).
+ * \param count The number of floats.
+ * \param width The number of floats of an element.
+ */
+PyObject *PyBufferFromFloats(const float *values, unsigned int count, unsigned int width);
+
 #endif  // WITH_PYTHON
 
 #endif  // __KX_PYMATH_H__
@@ -35,7 +35,8 @@ KX_PythonComponent::KX_PythonComponent(const std::string& name)
 	:m_pc(nullptr),
 	m_gameobj(nullptr),
 	m_name(name),
-	m_init(false)
+	m_init(false),
+	m_profileEntry(SCA_PythonProfiler::GetEntry(SCA_PythonProfiler::COMPONENT, name))
 {
 }
 
@@ -102,6 +103,8 @@ void KX_PythonComponent::Start()
 
 void KX_PythonComponent::Update()
 {
+	SCA_PythonProfileScope profileScope(m_profileEntry, "PythonComponent", m_name.c_str());
+
 	if (!m_init) {
 		Start();
 		m_init = true;
@@ -26,6 +26,7 @@
 #ifdef WITH_PYTHON
 
 #include "EXP_Value.h"
+#include "SCA_PythonProfiler.h"
 
 class KX_GameObject;
 struct PythonComponent;
@@ -39,6 +40,8 @@ private:
 	KX_GameObject *m_gameobj;
 	std::string m_name;
 	bool m_init;
+	/// Cost accounting of the component class.
+	SCA_PythonProfiler::Entry *m_profileEntry;
 
 public:
 	KX_PythonComponent(const std::string& name);
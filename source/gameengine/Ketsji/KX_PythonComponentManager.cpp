@@ -3,6 +3,7 @@
 #include "KX_GameObject.h"
 
 #include "CM_List.h"
+#include "CM_Profiler.h"
 
 KX_PythonComponentManager::KX_PythonComponentManager()
 {
@@ -25,6 +26,8 @@ void KX_PythonComponentManager::UnregisterObject(KX_GameObject *gameobj)
 
 void KX_PythonComponentManager::UpdateComponents()
 {
+	CM_ProfileScope profileScope("Components");
+
 	/* Update object components, we copy the object pointer in a second list to make
 	 * sure that we iterate on a list which will not be modified, indeed components
 	 * can add objects in theirs update.
@@ -86,6 +86,7 @@ extern "C" {
 #include "SCA_PythonJoystick.h"
 #include "SCA_PythonKeyboard.h"
 #include "SCA_PythonMouse.h"
+#include "SCA_PythonProfiler.h"
 #include "SCA_2DFilterActuator.h"
 #include "KX_ConstraintActuator.h"
 #include "KX_SoundActuator.h"
@@ -113,6 +114,7 @@ extern "C" {
 #include "KX_PythonInitTypes.h"
 
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 
 /* we only need this to get a list of libraries from the main struct */
 #include "DNA_ID.h"
@@ -293,6 +295,145 @@ static PyObject *gPyGetProfileInfo(PyObject *)
 	return KX_GetActiveEngine()->GetPyProfileDict();
 }
 
+PyDoc_STRVAR(gPyGetPythonProfileInfo_doc,
+             "getPythonProfileInfo()\n"
+             "returns a dictionary with the calls and time spent in each python script, component and draw callback"
+             );
+static PyObject *gPyGetPythonProfileInfo(PyObject *)
+{
+	PyObject *dict = PyDict_New();
+
+	for (unsigned short i = 0; i < SCA_PythonProfiler::NUM_CATEGORIES; ++i) {
+		const SCA_PythonProfiler::Category category = (SCA_PythonProfiler::Category)i;
+		PyObject *categoryDict = PyDict_New();
+
+		for (const SCA_PythonProfiler::EntryMap::value_type& pair : SCA_PythonProfiler::GetEntries(category)) {
+			const SCA_PythonProfiler::Entry& entry = pair.second;
+			// Entries of a previous game or before a reset.
+			if (entry.calls == 0) {
+				continue;
+			}
+
+			PyObject *val = Py_BuildValue("(Kdd)", entry.calls, entry.time * 1000.0, entry.averageTime * 1000.0);
+			PyDict_SetItemString(categoryDict, pair.first.c_str(), val);
+			Py_DECREF(val);
+		}
+
+		PyDict_SetItemString(dict, SCA_PythonProfiler::GetCategoryName(category), categoryDict);
+		Py_DECREF(categoryDict);
+	}
+
+	return dict;
+}
+
+PyDoc_STRVAR(gPyResetPythonProfileInfo_doc,
+             "resetPythonProfileInfo()\n"
+             "resets the calls and time spent in each python script, component and draw callback"
+             );
+static PyObject *gPyResetPythonProfileInfo(PyObject *)
+{
+	SCA_PythonProfiler::Reset();
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPySetPythonProfile_doc,
+             "setPythonProfile(enable)\n"
+             "enables the accounting of the calls and time spent in each python script, component and draw callback"
+             );
+static PyObject *gPySetPythonProfile(PyObject *, PyObject *args)
+{
+	int enable;
+	if (!PyArg_ParseTuple(args, "i:setPythonProfile", &enable)) {
+		return nullptr;
+	}
+
+	SCA_PythonProfiler::SetEnabled(enable);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyGetPythonProfile_doc,
+             "getPythonProfile()\n"
+             "returns True if the calls and time spent in each python script, component and draw callback are accounted"
+             );
+static PyObject *gPyGetPythonProfile(PyObject *)
+{
+	return PyBool_FromLong(SCA_PythonProfiler::GetEnabled());
+}
+
+PyDoc_STRVAR(gPySetProfileTrace_doc,
+             "setProfileTrace(enable)\n"
+             "enables the recording of the profile trace events"
+             );
+static PyObject *gPySetProfileTrace(PyObject *, PyObject *args)
+{
+	int enable;
+	if (!PyArg_ParseTuple(args, "i:setProfileTrace", &enable)) {
+		return nullptr;
+	}
+
+	CM_Profiler::SetEnabled(enable);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyGetProfileTrace_doc,
+             "getProfileTrace()\n"
+             "returns True if the profile trace events are recorded"
+             );
+static PyObject *gPyGetProfileTrace(PyObject *)
+{
+	return PyBool_FromLong(CM_Profiler::IsEnabled());
+}
+
+PyDoc_STRVAR(gPySaveProfileTrace_doc,
+             "saveProfileTrace(filepath)\n"
+             "writes the recorded profile trace events to a Chrome trace file"
+             );
+static PyObject *gPySaveProfileTrace(PyObject *, PyObject *args)
+{
+	char *filepath;
+	if (!PyArg_ParseTuple(args, "s:saveProfileTrace", &filepath)) {
+		return nullptr;
+	}
+
+	if (!CM_Profiler::WriteTrace(filepath)) {
+		PyErr_Format(PyExc_IOError, "saveProfileTrace(filepath): cannot write file \"%s\"", filepath);
+		return nullptr;
+	}
+
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPySetProfileTraceThreshold_doc,
+             "setProfileTraceThreshold(threshold, filepath)\n"
+             "writes a Chrome trace file of each frame longer than threshold seconds, 0 disables it"
+             );
+static PyObject *gPySetProfileTraceThreshold(PyObject *, PyObject *args)
+{
+	float threshold;
+	char *filepath = (char *)"";
+	if (!PyArg_ParseTuple(args, "f|s:setProfileTraceThreshold", &threshold, &filepath)) {
+		return nullptr;
+	}
+
+	if (threshold < 0.0f) {
+		PyErr_SetString(PyExc_ValueError, "setProfileTraceThreshold(threshold, filepath): threshold must be positive or null");
+		return nullptr;
+	}
+
+	if (threshold > 0.0f && filepath[0] == '\0') {
+		PyErr_SetString(PyExc_ValueError, "setProfileTraceThreshold(threshold, filepath): expected a file path");
+		return nullptr;
+	}
+
+	KX_GetActiveEngine()->SetProfileTraceThreshold(threshold, filepath);
+	Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetProfileTraceThreshold(PyObject *)
+{
+	return PyFloat_FromDouble(KX_GetActiveEngine()->GetProfileTraceThreshold());
+}
+
 PyDoc_STRVAR(gPySendMessage_doc,
              "sendMessage(subject, [body, to, from])\n"
              "sends a message in same manner as a message actuator"
@@ -373,6 +514,11 @@ static PyObject *gPySetRender(PyObject *, PyObject *args)
 	if (!PyArg_ParseTuple(args, "i:setRender", &render)) {
 		return nullptr;
 	}
+	// The headless mode doesn't create any rasterizer to render with.
+	if (render && !KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "setRender(render), Rasterizer not available");
+		return nullptr;
+	}
 	KX_GetActiveEngine()->SetRender(render);
 	Py_RETURN_NONE;
 }
@@ -466,6 +612,23 @@ static PyObject *gPySetUseExternalClock(PyObject *, PyObject *args)
 	Py_RETURN_NONE;
 }
 
+static PyObject *gPyGetUseParallelScenes(PyObject *)
+{
+	return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PARALLEL_SCENES));
+}
+
+static PyObject *gPySetUseParallelScenes(PyObject *, PyObject *args)
+{
+	int useParallelScenes;
+
+	if (!PyArg_ParseTuple(args, "p:setUseParallelScenes", &useParallelScenes)) {
+		return nullptr;
+	}
+
+	KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PARALLEL_SCENES, (bool)useParallelScenes);
+	Py_RETURN_NONE;
+}
+
 static PyObject *gPyGetClockTime(PyObject *)
 {
 	return PyFloat_FromDouble(KX_GetActiveEngine()->GetClockTime());
@@ -775,6 +938,27 @@ static PyObject *gLibList(PyObject *, PyObject *args)
 	return list;
 }
 
+static PyObject *gLibSetMergeTime(PyObject *, PyObject *args)
+{
+	float time;
+	if (!PyArg_ParseTuple(args, "f:setLibLoadMergeTime", &time)) {
+		return nullptr;
+	}
+
+	if (time < 0.0f) {
+		PyErr_SetString(PyExc_ValueError, "setLibLoadMergeTime(time): expected a positive or null time");
+		return nullptr;
+	}
+
+	KX_GetActiveEngine()->GetConverter()->SetMergeTime(time);
+	Py_RETURN_NONE;
+}
+
+static PyObject *gLibGetMergeTime(PyObject *)
+{
+	return PyFloat_FromDouble(KX_GetActiveEngine()->GetConverter()->GetMergeTime());
+}
+
 struct PyNextFrameState pynextframestate;
 static PyObject *gPyNextFrame(PyObject *)
 {
@@ -824,6 +1008,8 @@ static struct PyMethodDef game_methods[] = {
 	{"getRender", (PyCFunction)gPyGetRender, METH_NOARGS, (const char *)"get the global render flag value"},
 	{"getUseExternalClock", (PyCFunction)gPyGetUseExternalClock, METH_NOARGS, (const char *)"Get if we use the time provided by an external clock"},
 	{"setUseExternalClock", (PyCFunction)gPySetUseExternalClock, METH_VARARGS, (const char *)"Set if we use the time provided by an external clock"},
+	{"getUseParallelScenes", (PyCFunction)gPyGetUseParallelScenes, METH_NOARGS, (const char *)"Get if the physics of the scenes is proceeded in parallel"},
+	{"setUseParallelScenes", (PyCFunction)gPySetUseParallelScenes, METH_VARARGS, (const char *)"Set if the physics of the scenes is proceeded in parallel"},
 	{"getClockTime", (PyCFunction)gPyGetClockTime, METH_NOARGS, (const char *)"Get the last BGE render time. "
 	 "The BGE render time is the simulated time corresponding to the next scene that will be renderered"},
 	{"setClockTime", (PyCFunction)gPySetClockTime, METH_VARARGS, (const char *)"Set the BGE render time. "
@@ -840,11 +1026,22 @@ static struct PyMethodDef game_methods[] = {
 	{"PrintMemInfo", (PyCFunction)pyPrintStats, METH_NOARGS, (const char *)"Print engine statistics"},
 	{"NextFrame", (PyCFunction)gPyNextFrame, METH_NOARGS, (const char *)"Render next frame (if Python has control)"},
 	{"getProfileInfo", (PyCFunction)gPyGetProfileInfo, METH_NOARGS, gPyGetProfileInfo_doc},
+	{"getPythonProfileInfo", (PyCFunction)gPyGetPythonProfileInfo, METH_NOARGS, gPyGetPythonProfileInfo_doc},
+	{"resetPythonProfileInfo", (PyCFunction)gPyResetPythonProfileInfo, METH_NOARGS, gPyResetPythonProfileInfo_doc},
+	{"setPythonProfile", (PyCFunction)gPySetPythonProfile, METH_VARARGS, gPySetPythonProfile_doc},
+	{"getPythonProfile", (PyCFunction)gPyGetPythonProfile, METH_NOARGS, gPyGetPythonProfile_doc},
+	{"setProfileTrace", (PyCFunction)gPySetProfileTrace, METH_VARARGS, gPySetProfileTrace_doc},
+	{"getProfileTrace", (PyCFunction)gPyGetProfileTrace, METH_NOARGS, gPyGetProfileTrace_doc},
+	{"saveProfileTrace", (PyCFunction)gPySaveProfileTrace, METH_VARARGS, gPySaveProfileTrace_doc},
+	{"setProfileTraceThreshold", (PyCFunction)gPySetProfileTraceThreshold, METH_VARARGS, gPySetProfileTraceThreshold_doc},
+	{"getProfileTraceThreshold", (PyCFunction)gPyGetProfileTraceThreshold, METH_NOARGS, (const char *)"Gets the frame time threshold of the profile trace"},
 	/* library functions */
 	{"LibLoad", (PyCFunction)gLibLoad, METH_VARARGS | METH_KEYWORDS, (const char *)""},
 	{"LibNew", (PyCFunction)gLibNew, METH_VARARGS, (const char *)""},
 	{"LibFree", (PyCFunction)gLibFree, METH_VARARGS, (const char *)""},
 	{"LibList", (PyCFunction)gLibList, METH_VARARGS, (const char *)""},
+	{"getLibLoadMergeTime", (PyCFunction)gLibGetMergeTime, METH_NOARGS, (const char *)"Gets the time spent per frame to merge loaded libraries"},
+	{"setLibLoadMergeTime", (PyCFunction)gLibSetMergeTime, METH_VARARGS, (const char *)"Sets the time spent per frame to merge loaded libraries"},
 
 	{nullptr, (PyCFunction)nullptr, 0, nullptr }
 };
@@ -1103,8 +1300,8 @@ static PyObject *gPySetGLSLMaterialSetting(PyObject *,
 		gs->glslflag |= flag;
 	}
 
-	/* display lists and GLSL materials need to be remade */
-	if (sceneflag != gs->glslflag) {
+	/* display lists and GLSL materials need to be remade, without rasterizer no materials were created */
+	if (sceneflag != gs->glslflag && KX_GetActiveEngine()->GetRasterizer()) {
 		GPU_materials_free(G.main);
 		if (KX_GetActiveEngine()) {
 			EXP_ListValue<KX_Scene> *scenes = KX_GetActiveEngine()->CurrentScenes();
@@ -1181,6 +1378,11 @@ static PyObject *gPySetAnisotropicFiltering(PyObject *, PyObject *args)
 		return nullptr;
 	}
 
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "Rasterizer.setAnisotropicFiltering(level), Rasterizer not available");
+		return nullptr;
+	}
+
 	KX_KetsjiEngine *engine = KX_GetActiveEngine();
 	engine->GetRasterizer()->SetAnisotropicFiltering(level);
 
@@ -1193,6 +1395,10 @@ static PyObject *gPySetAnisotropicFiltering(PyObject *, PyObject *args)
 
 static PyObject *gPyGetAnisotropicFiltering(PyObject *, PyObject *args)
 {
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "Rasterizer.getAnisotropicFiltering(), Rasterizer not available");
+		return nullptr;
+	}
 	return PyLong_FromLong(KX_GetActiveEngine()->GetRasterizer()->GetAnisotropicFiltering());
 }
 
@@ -1209,6 +1415,11 @@ static PyObject *gPySetAntiAliasing(PyObject *, PyObject *args)
 		return nullptr;
 	}
 
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "Rasterizer.setAntiAliasing(level), Rasterizer not available");
+		return nullptr;
+	}
+
 	RAS_ICanvas *canvas = KX_GetActiveEngine()->GetCanvas();
 	canvas->SetSamples(level);
 
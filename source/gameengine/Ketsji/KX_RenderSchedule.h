@@ -7,9 +7,11 @@
 #include "SG_Frustum.h"
 
 #include <functional>
+#include <vector>
 
 class KX_Scene;
 class KX_Camera;
+class KX_GameObject;
 
 /** \brief This file contains all the scheduling data describing the rendering proceeded in a frame.
  * KX_RenderSchedule is the main scheduler which for each eye (in case of stereo) contains a frame
@@ -48,6 +50,8 @@ struct KX_TextureRenderSchedule
 	SG_Frustum m_frustum;
 	/// Visible layers to render.
 	unsigned int m_visibleLayers;
+	/// Non-culled objects, computed for all the views of the scene at once.
+	std::vector<KX_GameObject *> m_objects;
 
 	/// Distance factor used when computing lod.
 	float m_lodFactor;
@@ -90,6 +94,8 @@ struct KX_CameraRenderSchedule
 	SG_Frustum m_frustum;
 	/// True if testing object culling.
 	bool m_culling;
+	/// Non-culled objects, computed for all the views of the scene at once.
+	std::vector<KX_GameObject *> m_objects;
 
 	/// Display area.
 	RAS_Rect m_area;
@@ -117,6 +123,8 @@ using KX_CameraRenderScheduleList = std::vector<KX_CameraRenderSchedule>;
 struct KX_SceneRenderSchedule
 {
 	KX_Scene *m_scene;
+	/// True if the non-culled objects of each view were computed while scheduling.
+	bool m_culled;
 	KX_TextureRenderScheduleList m_textureSchedules;
 	// Use multiple list of cameras in case of per eye stereo.
 	KX_CameraRenderScheduleList m_cameraSchedules[RAS_Rasterizer::RAS_STEREO_MAXEYE];
@@ -59,6 +59,7 @@
 #include "RAS_2DFilterData.h"
 #include "KX_2DFilterManager.h"
 #include "RAS_BoundingBoxManager.h"
+#include "RAS_BoundingVolumeTree.h"
 #include "RAS_BucketManager.h"
 #include "RAS_Deformer.h"
 #include "RAS_ILightObject.h"
@@ -72,6 +73,7 @@
 #include "DNA_group_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_property_types.h"
+#include "DNA_object_types.h"
 
 #include "KX_NodeRelationships.h"
 
@@ -79,10 +81,14 @@
 #include "PHY_IPhysicsEnvironment.h"
 #include "PHY_IGraphicController.h"
 #include "PHY_IPhysicsController.h"
+#include "KX_ClientObjectInfo.h"
 #include "BL_Converter.h"
 #include "BL_ArmatureObject.h"
+#include "BL_PoseCache.h"
+#include "BL_ConvertObjectInfo.h"
 #include "KX_MotionState.h"
 #include "KX_ObstacleSimulation.h"
+#include "SCA_PythonProfiler.h"
 
 #ifdef WITH_PYTHON
 #  include "EXP_PythonCallBack.h"
@@ -92,11 +98,19 @@
 
 #include "BLI_task.h"
 
+#include "PIL_time.h"
+
 #include "CM_Message.h"
 #include "CM_List.h"
+#include "CM_Profiler.h"
+
+#include <climits>
 
 SG_Callbacks KX_Scene::m_callbacks = SG_Callbacks(KX_GameObject::UpdateTransformFunc);
 
+/// Margin of the object boxes in the bounding volume tree, avoid reinserting slightly moving objects.
+static const float boundingVolumeMargin = 0.1f;
+
 KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
                    const std::string& sceneName,
                    Scene *scene,
@@ -115,6 +129,7 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 	m_dbvtOcclusionRes(0),
 	m_blenderScene(scene),
 	m_previousAnimTime(0.0f),
+	m_profileTimes({0.0, 0.0, 0.0, 0.0, 0}),
 	m_isActivedHysteresis(false),
 	m_lodHysteresisValue(0)
 {
@@ -149,8 +164,11 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 	m_rendererManager = new KX_TextureRendererManager();
 	m_bucketmanager = new RAS_BucketManager(KX_TextMaterial::GetSingleton());
 	m_boundingBoxManager = new RAS_BoundingBoxManager();
+	m_boundingVolumeTree = new RAS_BoundingVolumeTree(boundingVolumeMargin);
+	m_useBoundingVolumeTree = false;
 
 	m_animationPool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), &m_animationPoolData);
+	m_poseCache = new BL_PoseCache();
 
 #ifdef WITH_PYTHON
 	m_attrDict = nullptr;
@@ -170,6 +188,9 @@ KX_Scene::~KX_Scene()
 	 */
 	RemoveAllDebugProperties();
 
+	// The parked replicas are not in the object list.
+	ClearObjectPools();
+
 	DestructRootNodes();
 
 	if (m_obstacleSimulation) {
@@ -180,6 +201,8 @@ KX_Scene::~KX_Scene()
 		BLI_task_pool_free(m_animationPool);
 	}
 
+	delete m_poseCache;
+
 	if (m_objectlist) {
 		m_objectlist->Release();
 	}
@@ -228,6 +251,10 @@ KX_Scene::~KX_Scene()
 		delete m_boundingBoxManager;
 	}
 
+	if (m_boundingVolumeTree) {
+		delete m_boundingVolumeTree;
+	}
+
 	if (m_worldinfo) {
 		delete m_worldinfo;
 	}
@@ -243,6 +270,7 @@ KX_Scene::~KX_Scene()
 	for (unsigned short i = 0; i < MAX_DRAW_CALLBACK; ++i) {
 		Py_CLEAR(m_drawCallbacks[i]);
 	}
+	ClearDrawCallbackInfos();
 #endif
 }
 
@@ -254,6 +282,7 @@ std::string KX_Scene::GetName()
 void KX_Scene::SetName(const std::string& name)
 {
 	m_sceneName = name;
+	NameChanged();
 }
 
 RAS_BucketManager *KX_Scene::GetBucketManager() const
@@ -271,6 +300,50 @@ RAS_BoundingBoxManager *KX_Scene::GetBoundingBoxManager() const
 	return m_boundingBoxManager;
 }
 
+RAS_BoundingVolumeTree *KX_Scene::GetBoundingVolumeTree() const
+{
+	return m_boundingVolumeTree;
+}
+
+void KX_Scene::ScheduleBoundingVolumeUpdate(KX_GameObject *gameobj)
+{
+	if (!m_useBoundingVolumeTree) {
+		return;
+	}
+
+	// The node is flagged while scheduled, an object is queued once between two tree updates.
+	SG_Node *node = gameobj->GetNode();
+	if (node->IsDirty(SG_Node::DIRTY_CULLING)) {
+		return;
+	}
+
+	node->SetDirty(SG_Node::DIRTY_CULLING);
+	m_boundingVolumeMutex.Lock();
+	m_boundingVolumeUpdates.push_back(gameobj);
+	m_boundingVolumeMutex.Unlock();
+}
+
+void KX_Scene::UnscheduleBoundingVolumeUpdate(KX_GameObject *gameobj)
+{
+	const int proxy = gameobj->GetBoundingVolumeProxy();
+	if (proxy != RAS_BoundingVolumeTree::NULL_NODE) {
+		m_boundingVolumeTree->Remove(proxy);
+		gameobj->SetBoundingVolumeProxy(RAS_BoundingVolumeTree::NULL_NODE);
+	}
+
+	SG_Node *node = gameobj->GetNode();
+	if (!node->IsDirty(SG_Node::DIRTY_CULLING)) {
+		return;
+	}
+
+	std::vector<KX_GameObject *>::iterator it = std::find(m_boundingVolumeUpdates.begin(), m_boundingVolumeUpdates.end(), gameobj);
+	if (it != m_boundingVolumeUpdates.end()) {
+		*it = m_boundingVolumeUpdates.back();
+		m_boundingVolumeUpdates.pop_back();
+	}
+	node->ClearDirty(SG_Node::DIRTY_CULLING);
+}
+
 EXP_ListValue<KX_GameObject> *KX_Scene::GetObjectList() const
 {
 	return m_objectlist;
@@ -351,6 +424,16 @@ bool KX_Scene::IsSuspended() const
 	return m_suspend;
 }
 
+KX_Scene::ProfileTimes& KX_Scene::GetProfileTimes()
+{
+	return m_profileTimes;
+}
+
+BL_PoseCache& KX_Scene::GetPoseCache()
+{
+	return *m_poseCache;
+}
+
 void KX_Scene::SetDbvtCulling(bool b)
 {
 	m_dbvtCulling = b;
@@ -423,9 +506,9 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
 
 	// Also register 'timers' (time properties) of the replica.
 	for (unsigned short i = 0, numprops = newobj->GetPropertyCount(); i < numprops; ++i) {
-		EXP_Value *prop = newobj->GetProperty(i);
+		EXP_Value *prop = newobj->GetStoredProperty(i);
 
-		if (prop->GetProperty("timer")) {
+		if (prop && prop->GetProperty("timer")) {
 			m_timemgr->AddTimeProperty(prop);
 		}
 	}
@@ -448,6 +531,7 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
 
 	// This is the list of object that are send to the graphics pipeline.
 	m_objectlist->Add(CM_AddRef(newobj));
+	ScheduleBoundingVolumeUpdate(newobj);
 
 	switch (newobj->GetGameObjectType()) {
 		case SCA_IObject::OBJ_LIGHT:
@@ -737,16 +821,28 @@ bool KX_Scene::IsObjectInGroup(KX_GameObject *gameobj) const
 
 KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObject *referenceobj, float lifespan)
 {
+	const double startTime = PIL_check_seconds_timer();
+
 	m_logicHierarchicalGameObjects.clear();
 	m_map_gameobject_to_replica.clear();
 	m_groupGameObjects.clear();
 
 	m_ueberExecutionPriority++;
 
-	// Lets create a replica.
+	// Lets reuse a parked replica or create a new one.
+	KX_GameObject *replica = ReuseReplicaObject(originalobj);
+	const bool reused = (replica != nullptr);
+	if (reused) {
+		m_logicHierarchicalGameObjects.push_back(replica);
+	}
+	else {
+		SG_Node *replicaNode = originalobj->GetNode()->GetReplica();
+		replica = static_cast<KX_GameObject *>(replicaNode->GetObject());
 
-	SG_Node *replicaNode = originalobj->GetNode()->GetReplica();
-	KX_GameObject *replica = static_cast<KX_GameObject *>(replicaNode->GetObject());
+		if (m_objectPools.find(originalobj) != m_objectPools.end()) {
+			m_pooledReplicas[replica] = originalobj;
+		}
+	}
 
 	/* Add a timebomb to this object
 	 * lifespan of zero means 'this object lives forever'. */
@@ -788,7 +884,10 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObj
 	for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
 		// This will also relink the actuators in the hierarchy.
 		gameobj->Relink(m_map_gameobject_to_replica);
-		gameobj->AddMeshUser();
+		// The mesh user of a reused replica is kept.
+		if (!reused) {
+			gameobj->AddMeshUser();
+		}
 		// Always make sure that the bounding box is valid.
 		gameobj->UpdateBounds(true);
 
@@ -819,11 +918,18 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObj
 		DupliGroupRecurse(gameobj, 0);
 	}
 
+	m_profileTimes.replication += PIL_check_seconds_timer() - startTime;
+	++m_profileTimes.replicas;
+
 	return replica;
 }
 
 void KX_Scene::RemoveObject(KX_GameObject *gameobj)
 {
+	if (ParkReplicaObject(gameobj)) {
+		return;
+	}
+
 	// Disconnect child from parent.
 	SG_Node *node = gameobj->GetNode();
 
@@ -907,8 +1013,8 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 
 	// Now remove the timer properties from the time manager.
 	for (unsigned short i = 0, numprops = gameobj->GetPropertyCount(); i < numprops; ++i) {
-		EXP_Value *propval = gameobj->GetProperty(i);
-		if (propval->GetProperty("timer")) {
+		EXP_Value *propval = gameobj->GetStoredProperty(i);
+		if (propval && propval->GetProperty("timer")) {
 			m_timemgr->RemoveTimeProperty(propval);
 		}
 	}
@@ -937,6 +1043,8 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 
 	m_rendererManager->InvalidateViewpoint(gameobj);
 
+	UnscheduleBoundingVolumeUpdate(gameobj);
+
 	bool ret = true;
 	if (m_lightlist->RemoveValue(gameobj)) {
 		ret = (gameobj->Release() != nullptr);
@@ -958,6 +1066,7 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 	CM_ListRemoveIfFound(m_animatedlist, gameobj);
 	CM_ListRemoveIfFound(m_euthanasyobjects, gameobj);
 	CM_ListRemoveIfFound(m_tempObjectList, gameobj);
+	m_pooledReplicas.erase(gameobj);
 
 	if (gameobj == m_activeCamera) {
 		m_activeCamera = nullptr;
@@ -971,6 +1080,224 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 	return ret;
 }
 
+KX_GameObject *KX_Scene::ReuseReplicaObject(KX_GameObject *original)
+{
+	std::map<KX_GameObject *, ObjectPool>::iterator it = m_objectPools.find(original);
+	if (it == m_objectPools.end() || it->second.m_objects.empty()) {
+		return nullptr;
+	}
+
+	std::vector<KX_GameObject *>& objects = it->second.m_objects;
+	KX_GameObject *replica = objects.back();
+	objects.pop_back();
+
+	// The reference kept by the pool is given back to the object list.
+	m_objectlist->Add(replica);
+	ScheduleBoundingVolumeUpdate(replica);
+	m_pooledReplicas[replica] = original;
+
+	replica->ResetReplica(original);
+
+	PHY_IPhysicsController *ctrl = replica->GetPhysicsController();
+	if (ctrl) {
+		ctrl->RestorePhysics();
+		if (ctrl->IsDynamicsSuspended()) {
+			ctrl->RestoreDynamics();
+		}
+	}
+
+	// Start from the transform and the rest state of the original, as a new replica.
+	replica->NodeSetLocalPosition(original->NodeGetLocalPosition());
+	replica->NodeSetLocalOrientation(original->NodeGetLocalOrientation());
+	replica->NodeSetLocalScale(original->NodeGetLocalScaling());
+	replica->SetLinearVelocity(mt::zero3, false);
+	replica->SetAngularVelocity(mt::zero3, false);
+
+	// Register the timer properties as AddNodeReplicaObject.
+	for (unsigned short i = 0, numprops = replica->GetPropertyCount(); i < numprops; ++i) {
+		EXP_Value *prop = replica->GetStoredProperty(i);
+		if (prop && prop->GetProperty("timer")) {
+			m_timemgr->AddTimeProperty(prop);
+		}
+	}
+
+	if (m_obstacleSimulation && original->GetBlenderObject()->gameflag & OB_HASOBSTACLE) {
+		m_obstacleSimulation->AddObstacleForObj(replica);
+	}
+
+	return replica;
+}
+
+bool KX_Scene::ParkReplicaObject(KX_GameObject *gameobj)
+{
+	std::map<KX_GameObject *, KX_GameObject *>::iterator it = m_pooledReplicas.find(gameobj);
+	if (it == m_pooledReplicas.end()) {
+		return false;
+	}
+
+	KX_GameObject *original = it->second;
+	m_pooledReplicas.erase(it);
+
+	std::map<KX_GameObject *, ObjectPool>::iterator poolit = m_objectPools.find(original);
+	if (poolit == m_objectPools.end()) {
+		return false;
+	}
+
+	ObjectPool& pool = poolit->second;
+	SG_Node *node = gameobj->GetNode();
+	// The replica could have been parented or modified since its creation.
+	if (pool.m_objects.size() >= pool.m_size || node->GetParent() || !node->GetChildren().empty() ||
+	    !gameobj->IsReusableReplica(original))
+	{
+		return false;
+	}
+
+	// Deactivate the object as NewRemoveObject does but keep its node, mesh user and controllers.
+	RemoveObjectDebugProperties(gameobj);
+	gameobj->InvalidateProxy();
+
+	for (unsigned short i = 0, numprops = gameobj->GetPropertyCount(); i < numprops; ++i) {
+		EXP_Value *propval = gameobj->GetStoredProperty(i);
+		if (propval && propval->GetProperty("timer")) {
+			m_timemgr->RemoveTimeProperty(propval);
+		}
+	}
+
+	if (m_obstacleSimulation) {
+		m_obstacleSimulation->DestroyObstacleForObj(gameobj);
+	}
+
+	m_rendererManager->InvalidateViewpoint(gameobj);
+
+	UnscheduleBoundingVolumeUpdate(gameobj);
+
+	PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+	if (ctrl && !ctrl->IsPhysicsSuspended()) {
+		ctrl->SuspendPhysics(true);
+	}
+
+	gameobj->SetVisible(false, false);
+	// An occluder keeps its graphic controller active.
+	PHY_IGraphicController *graphicctrl = gameobj->GetGraphicController();
+	if (graphicctrl) {
+		graphicctrl->Activate(false);
+	}
+
+	// The reference of the object list is kept by the pool.
+	m_objectlist->RemoveValue(gameobj);
+	CM_ListRemoveIfFound(m_euthanasyobjects, gameobj);
+	CM_ListRemoveIfFound(m_tempObjectList, gameobj);
+
+	pool.m_objects.push_back(gameobj);
+
+	return true;
+}
+
+void KX_Scene::DestructParkedObject(KX_GameObject *gameobj)
+{
+	// Give back the reference of the pool to the object list, it is released by NewRemoveObject.
+	m_objectlist->Add(gameobj);
+	RemoveObject(gameobj);
+}
+
+bool KX_Scene::CanPoolObject(KX_GameObject *original) const
+{
+	// A plain mesh or empty object doesn't have any object type.
+	return (original->GetGameObjectType() == -1 && original->GetSensors().empty() &&
+	        original->GetControllers().empty() && original->GetActuators().empty() && !original->GetComponents() &&
+	        !original->IsDupliGroup() && original->GetNode()->GetChildren().empty());
+}
+
+void KX_Scene::SetObjectPoolSize(KX_GameObject *original, unsigned int size, bool prewarm)
+{
+	BLI_assert(CanPoolObject(original));
+
+	if (size == 0) {
+		std::map<KX_GameObject *, ObjectPool>::iterator it = m_objectPools.find(original);
+		if (it != m_objectPools.end()) {
+			const std::vector<KX_GameObject *> objects = it->second.m_objects;
+			m_objectPools.erase(it);
+			for (KX_GameObject *gameobj : objects) {
+				DestructParkedObject(gameobj);
+			}
+		}
+		return;
+	}
+
+	ObjectPool& pool = m_objectPools[original];
+	pool.m_size = size;
+
+	while (pool.m_objects.size() > size) {
+		KX_GameObject *gameobj = pool.m_objects.back();
+		pool.m_objects.pop_back();
+		DestructParkedObject(gameobj);
+	}
+
+	if (prewarm) {
+		// Move the parked replicas away to not reuse them.
+		std::vector<KX_GameObject *> parked;
+		parked.swap(pool.m_objects);
+
+		std::vector<KX_GameObject *> replicas;
+		for (unsigned int i = parked.size(); i < size; ++i) {
+			replicas.push_back(AddReplicaObject(original, nullptr));
+		}
+
+		pool.m_objects.swap(parked);
+		for (KX_GameObject *replica : replicas) {
+			if (!ParkReplicaObject(replica)) {
+				RemoveObject(replica);
+			}
+		}
+	}
+}
+
+void KX_Scene::ClearObjectPools()
+{
+	std::map<KX_GameObject *, ObjectPool> pools;
+	pools.swap(m_objectPools);
+	m_pooledReplicas.clear();
+
+	for (const std::pair<KX_GameObject * const, ObjectPool>& pair : pools) {
+		for (KX_GameObject *gameobj : pair.second.m_objects) {
+			DestructParkedObject(gameobj);
+		}
+	}
+}
+
+void KX_Scene::RemoveObjectPoolsRessources(const BL_Resource::Library& libraryId)
+{
+	std::vector<KX_GameObject *> removedObjects;
+	for (std::map<KX_GameObject *, ObjectPool>::iterator it = m_objectPools.begin(); it != m_objectPools.end(); ) {
+		KX_GameObject *original = it->first;
+		BL_ConvertObjectInfo *info = original->GetConvertObjectInfo();
+		if (info && info->Belong(libraryId)) {
+			removedObjects.insert(removedObjects.end(), it->second.m_objects.begin(), it->second.m_objects.end());
+			it = m_objectPools.erase(it);
+		}
+		else {
+			for (KX_GameObject *gameobj : it->second.m_objects) {
+				gameobj->RemoveRessources(libraryId);
+			}
+			++it;
+		}
+	}
+
+	// The active replicas of a removed pool can't be parked anymore.
+	for (std::map<KX_GameObject *, KX_GameObject *>::iterator it = m_pooledReplicas.begin(); it != m_pooledReplicas.end(); ) {
+		if (m_objectPools.find(it->second) == m_objectPools.end()) {
+			it = m_pooledReplicas.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
+	for (KX_GameObject *gameobj : removedObjects) {
+		DestructParkedObject(gameobj);
+	}
+}
+
 KX_Camera *KX_Scene::GetActiveCamera()
 {
 	// nullptr if not defined.
@@ -1013,6 +1340,59 @@ void KX_Scene::PhysicsCullingCallback(KX_ClientObjectInfo *objectInfo, void *cul
 	info->m_objects.push_back(gameobj);
 }
 
+void KX_Scene::UpdateBoundingVolumeTree()
+{
+	// Insert all the objects at the first use, the new objects are scheduled after.
+	if (!m_useBoundingVolumeTree) {
+		m_useBoundingVolumeTree = true;
+		for (KX_GameObject *gameobj : m_objectlist) {
+			ScheduleBoundingVolumeUpdate(gameobj);
+		}
+	}
+
+	// All the active objects are inserted, the queries check if they are renderable.
+	for (KX_GameObject *gameobj : m_boundingVolumeUpdates) {
+		mt::vec3 min;
+		mt::vec3 max;
+		gameobj->GetWorldAabb(min, max);
+
+		const int proxy = gameobj->GetBoundingVolumeProxy();
+		if (proxy == RAS_BoundingVolumeTree::NULL_NODE) {
+			gameobj->SetBoundingVolumeProxy(m_boundingVolumeTree->Insert(min, max, gameobj));
+		}
+		else {
+			m_boundingVolumeTree->Update(proxy, min, max);
+		}
+
+		gameobj->GetNode()->ClearDirty(SG_Node::DIRTY_CULLING);
+	}
+
+	m_boundingVolumeUpdates.clear();
+
+	// Rebuild the tree if too many objects moved out of their enlarged boxes.
+	m_boundingVolumeTree->Optimize();
+}
+
+void KX_Scene::RefitBoundingVolumeTree()
+{
+	if (m_useBoundingVolumeTree) {
+		UpdateBoundingVolumeTree();
+	}
+}
+
+void KX_Scene::ResetBoundingVolumeTree()
+{
+	m_boundingVolumeTree->Clear();
+	for (KX_GameObject *gameobj : m_objectlist) {
+		gameobj->SetBoundingVolumeProxy(RAS_BoundingVolumeTree::NULL_NODE);
+	}
+	for (KX_GameObject *gameobj : m_boundingVolumeUpdates) {
+		gameobj->GetNode()->ClearDirty(SG_Node::DIRTY_CULLING);
+	}
+	m_boundingVolumeUpdates.clear();
+	m_useBoundingVolumeTree = false;
+}
+
 std::vector<KX_GameObject *> KX_Scene::CalculateVisibleMeshes(KX_Camera *cam, RAS_Rasterizer::StereoEye eye, int layer)
 {
 	return CalculateVisibleMeshes(cam->GetFrustumCulling(), cam->GetFrustum(eye), layer);
@@ -1034,6 +1414,8 @@ std::vector<KX_GameObject *> KX_Scene::CalculateVisibleMeshes(bool frustumCullin
 
 std::vector<KX_GameObject *> KX_Scene::CalculateVisibleMeshes(const SG_Frustum& frustum, int layer)
 {
+	CM_ProfileScope profileScope("Culling", m_sceneName.c_str());
+
 	std::vector<KX_GameObject *> objects;
 	m_boundingBoxManager->Update(false);
 
@@ -1055,6 +1437,20 @@ std::vector<KX_GameObject *> KX_Scene::CalculateVisibleMeshes(const SG_Frustum&
 		CullingInfo info(layer, objects);
 
 		dbvt_culling = m_physicsEnvironment->CullingTest(PhysicsCullingCallback, &info, planes, m_dbvtOcclusionRes, viewport, matrix);
+
+		// The physics engine doesn't support culling, use the scene bounding volume tree.
+		if (!dbvt_culling) {
+			UpdateBoundingVolumeTree();
+
+			m_boundingVolumeTree->QueryFrustum(planes, [&objects, layer](void *userData) {
+				KX_GameObject *gameobj = static_cast<KX_GameObject *>(userData);
+				if (gameobj->Renderable(layer)) {
+					gameobj->SetCulled(false);
+					objects.push_back(gameobj);
+				}
+			});
+			dbvt_culling = true;
+		}
 	}
 
 	if (!dbvt_culling) {
@@ -1067,6 +1463,57 @@ std::vector<KX_GameObject *> KX_Scene::CalculateVisibleMeshes(const SG_Frustum&
 	return objects;
 }
 
+bool KX_Scene::CalculateVisibleMeshes(KX_SceneRenderSchedule& sceneSchedule)
+{
+	if (m_dbvtCulling) {
+		return false;
+	}
+
+	CM_ProfileScope profileScope("Culling", m_sceneName.c_str());
+
+	m_boundingBoxManager->Update(false);
+
+	KX_CullingHandler handler(m_objectlist);
+	std::vector<std::vector<KX_GameObject *> *> viewObjects;
+
+	for (KX_TextureRenderSchedule& textureSchedule : sceneSchedule.m_textureSchedules) {
+		handler.AddView(textureSchedule.m_frustum, textureSchedule.m_visibleLayers);
+		viewObjects.push_back(&textureSchedule.m_objects);
+	}
+
+	bool culling = true;
+	for (KX_CameraRenderScheduleList& cameraSchedules : sceneSchedule.m_cameraSchedules) {
+		for (KX_CameraRenderSchedule& cameraSchedule : cameraSchedules) {
+			if (cameraSchedule.m_culling) {
+				handler.AddView(cameraSchedule.m_frustum, 0);
+				viewObjects.push_back(&cameraSchedule.m_objects);
+			}
+			else {
+				culling = false;
+				for (KX_GameObject *gameobj : m_objectlist) {
+					cameraSchedule.m_objects.push_back(gameobj);
+				}
+			}
+		}
+	}
+
+	std::vector<std::vector<KX_GameObject *> > objects = handler.ProcessViews();
+	for (unsigned short i = 0, size = objects.size(); i < size; ++i) {
+		viewObjects[i]->swap(objects[i]);
+	}
+
+	// A camera without culling renders all the objects.
+	if (!culling) {
+		for (KX_GameObject *gameobj : m_objectlist) {
+			gameobj->SetCulled(false);
+		}
+	}
+
+	m_boundingBoxManager->ClearModified();
+
+	return true;
+}
+
 RAS_DebugDraw& KX_Scene::GetDebugDraw()
 {
 	return m_debugDraw;
@@ -1190,8 +1637,16 @@ void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
 	CM_ListAddIfNotFound(m_animatedlist, gameobj);
 }
 
-static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+static void update_deformer_thread_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
 {
+	RAS_Deformer *deformer = (RAS_Deformer *)taskdata;
+	deformer->Update();
+}
+
+static void update_anim_thread_func(TaskPool *pool, void *taskdata, int threadid)
+{
+	CM_ProfileScope profileScope("Animation");
+
 	KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_userdata(pool);
 	double curtime = data->curtime;
 
@@ -1230,9 +1685,23 @@ static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(t
 		}
 	}
 
-	// If the object is a culled armature, then we manage only the animation time and end of its animations.
+	// Armatures of distant meshes are evaluated less often according to the meshes lod levels.
+	BL_ArmatureObject *lodArmature = nullptr;
+	if (needs_update && gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+		lodArmature = static_cast<BL_ArmatureObject *>(gameobj);
+		needs_update = lodArmature->NeedAnimationLodUpdate(curtime);
+	}
+
+	/* If the object is a culled or skipped armature, then we manage only the animation time
+	 * and end of its animations. */
 	gameobj->UpdateActionManager(curtime, needs_update);
 
+	// The armatures skipped by the lod interpolate their pose and still update their deformers.
+	if (lodArmature) {
+		lodArmature->UpdateAnimationLodPose(curtime, needs_update);
+		needs_update = true;
+	}
+
 	if (needs_update) {
 		const std::vector<KX_GameObject *> children = gameobj->GetChildren();
 		KX_GameObject *parent = gameobj->GetParent();
@@ -1243,11 +1712,30 @@ static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(t
 			gameobj->GetDeformer()->Update();
 		}
 
+		std::vector<RAS_Deformer *> deformers;
 		for (KX_GameObject *child : children) {
-			if (child->GetDeformer()) {
-				child->GetDeformer()->Update();
+			RAS_Deformer *deformer = child->GetDeformer();
+			if (deformer) {
+				deformers.push_back(deformer);
 			}
 		}
+
+		if (deformers.empty()) {
+			return;
+		}
+
+		/* The children deformers only read the pose once it is evaluated, evaluate it here
+		 * to let them deform in parallel. */
+		if (deformers.size() > 1 && gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+			static_cast<BL_ArmatureObject *>(gameobj)->ApplyPose();
+		}
+
+		/* Let other threads steal the remaining deformers while this thread updates the first one,
+		 * the tasks are pushed to the queue of this thread without locking the scheduler. */
+		for (unsigned int i = 1, size = deformers.size(); i < size; ++i) {
+			BLI_task_pool_push_from_thread(pool, update_deformer_thread_func, deformers[i], false, TASK_PRIORITY_HIGH, threadid);
+		}
+		deformers.front()->Update();
 	}
 }
 
@@ -1267,7 +1755,10 @@ void KX_Scene::UpdateAnimations(double curtime, bool restrict)
 		m_previousAnimTime = curtime;
 	}
 
+	CM_ProfileScope profileScope("Animations", m_sceneName.c_str());
+
 	m_animationPoolData.curtime = curtime;
+	m_poseCache->Clear();
 
 	for (KX_GameObject *gameobj : m_animatedlist) {
 		if (!gameobj->IsActionsSuspended()) {
@@ -1414,20 +1905,48 @@ void KX_Scene::UpdateObjectActivity()
 		return;
 	}
 
-	for (KX_GameObject *gameobj : m_objectlist) {
-		// If the object doesn't manage activity culling we don't compute distance.
-		if (gameobj->GetActivityCullingInfo().m_flags == KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE) {
-			continue;
+	SG_TransformStore *store = GetTransformStore();
+	// Without transform store, read the world position of each node.
+	if (!store) {
+		for (KX_GameObject *gameobj : m_objectlist) {
+			// If the object doesn't manage activity culling we don't compute distance.
+			if (gameobj->GetActivityCullingInfo().m_flags == KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE) {
+				continue;
+			}
+
+			// For each camera compute the distance to objects and keep the minimum distance.
+			const mt::vec3& obpos = gameobj->NodeGetWorldPosition();
+			float dist = FLT_MAX;
+			for (const mt::vec3& campos : camPositions) {
+				// Keep the minimum distance.
+				dist = std::min((obpos - campos).LengthSquared(), dist);
+			}
+			gameobj->UpdateActivity(dist);
 		}
+		return;
+	}
 
-		// For each camera compute the distance to objects and keep the minimum distance.
-		const mt::vec3& obpos = gameobj->NodeGetWorldPosition();
+	// For each node compute the distance to cameras and keep the minimum distance, in a linear pass over positions.
+	const SG_TransformStore::PositionList& positions = store->GetPositions();
+	const unsigned int size = positions.size();
+	m_activityDistances.resize(size);
+	for (unsigned int i = 0; i < size; ++i) {
+		const mt::vec3& obpos = positions[i];
 		float dist = FLT_MAX;
 		for (const mt::vec3& campos : camPositions) {
 			// Keep the minimum distance.
 			dist = std::min((obpos - campos).LengthSquared(), dist);
 		}
-		gameobj->UpdateActivity(dist);
+		m_activityDistances[i] = dist;
+	}
+
+	for (KX_GameObject *gameobj : m_objectlist) {
+		// If the object doesn't manage activity culling we don't use distance.
+		if (gameobj->GetActivityCullingInfo().m_flags == KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE) {
+			continue;
+		}
+
+		gameobj->UpdateActivity(m_activityDistances[gameobj->GetNode()->GetTransformIndex()]);
 	}
 }
 
@@ -1520,23 +2039,18 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
 		MergeScene_LogicBrick(controller, from, to);
 	}
 
-	// Graphics controller.
-	PHY_IGraphicController *graphicCtrl = gameobj->GetGraphicController();
-	if (graphicCtrl) {
-		// Should update the m_cullingTree.
-		graphicCtrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
-	}
-
-	PHY_IPhysicsController *physicsCtrl = gameobj->GetPhysicsController();
-	if (physicsCtrl) {
-		physicsCtrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
-	}
-
 	switch (gameobj->GetGameObjectType()) {
 		// If the object is a light, update it's scene.
 		case SCA_IObject::OBJ_LIGHT:
 		{
-			static_cast<KX_LightObject *>(gameobj)->UpdateScene(to);
+			KX_LightObject *light = static_cast<KX_LightObject *>(gameobj);
+			light->UpdateScene(to);
+			to->GetLightList()->Add(CM_AddRef(light));
+			break;
+		}
+		case SCA_IObject::OBJ_CAMERA:
+		{
+			to->GetCameraList()->Add(CM_AddRef(static_cast<KX_Camera *>(gameobj)));
 			break;
 		}
 		// All armatures should be in the animated object list to be umpdated.
@@ -1550,10 +2064,14 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
 		{
 			gameobj->RemoveMeshes();
 			gameobj->AddMeshUser();
+			to->GetFontList()->Add(CM_AddRef(static_cast<KX_FontObject *>(gameobj)));
 			break;
 		}
 	}
 
+	// The trigger stamps are specific to each logic manager.
+	gameobj->SetTriggerGroup(0, 0);
+
 	// Add the object to the scene's logic manager.
 	to->GetLogicManager()->RegisterGameObjectName(gameobj->GetName(), gameobj);
 	to->GetLogicManager()->RegisterGameObj(gameobj->GetBlenderObject(), gameobj);
@@ -1567,9 +2085,21 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
 
 bool KX_Scene::MergeScene(KX_Scene *other)
 {
-	PHY_IPhysicsEnvironment *env = this->GetPhysicsEnvironment();
-	PHY_IPhysicsEnvironment *env_other = other->GetPhysicsEnvironment();
-
+	if (!MergeSceneBegin(other)) {
+		return false;
+	}
+
+	MergeSceneObjects(other, 0, UINT_MAX);
+	MergeSceneEnd(other);
+
+	return true;
+}
+
+bool KX_Scene::MergeSceneBegin(KX_Scene *other)
+{
+	PHY_IPhysicsEnvironment *env = this->GetPhysicsEnvironment();
+	PHY_IPhysicsEnvironment *env_other = other->GetPhysicsEnvironment();
+
 	if ((env == nullptr) != (env_other == nullptr)) {
 		// TODO - even when both scenes have NONE physics, the other is loaded with bullet enabled, ???
 		CM_FunctionError("physics scenes type differ, aborting\n\tsource " << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
@@ -1579,24 +2109,29 @@ bool KX_Scene::MergeScene(KX_Scene *other)
 	m_bucketmanager->Merge(other->GetBucketManager(), this);
 	m_boundingBoxManager->Merge(other->GetBoundingBoxManager());
 	m_rendererManager->Merge(other->GetTextureRendererManager());
-	m_componentManager.Merge(other->GetPythonComponentManager());
 
-	for (KX_GameObject *gameobj : *other->GetObjectList()) {
-		MergeScene_GameObject(gameobj, this, other);
+	/* The physics objects are merged before any object is added to this scene, the
+	 * objects then never run their logic outside of the physics environment. */
+	if (env) {
+		EXP_ListValue<KX_GameObject> *otherObjects = other->GetObjectList();
+		EXP_ListValue<KX_GameObject> *otherInactiveObjects = other->GetInactiveList();
+		for (EXP_ListValue<KX_GameObject> *list : {otherObjects, otherInactiveObjects}) {
+			for (KX_GameObject *gameobj : list) {
+				// Graphics controller.
+				PHY_IGraphicController *graphicCtrl = gameobj->GetGraphicController();
+				if (graphicCtrl) {
+					// Should update the m_cullingTree.
+					graphicCtrl->SetPhysicsEnvironment(env);
+				}
 
-		// Add properties to debug list for LibLoad objects.
-		if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
-			AddObjectDebugProperties(gameobj);
+				PHY_IPhysicsController *physicsCtrl = gameobj->GetPhysicsController();
+				if (physicsCtrl) {
+					physicsCtrl->SetPhysicsEnvironment(env);
+				}
+			}
 		}
-	}
 
-	for (KX_GameObject *gameobj : *other->GetInactiveList()) {
-		MergeScene_GameObject(gameobj, this, other);
-	}
-
-	if (env) {
 		env->MergeEnvironment(env_other);
-		EXP_ListValue<KX_GameObject> *otherObjects = other->GetObjectList();
 
 		// List of all physics objects to merge (needed by ReplicateConstraints).
 		std::vector<KX_GameObject *> physicsObjects;
@@ -1608,25 +2143,10 @@ bool KX_Scene::MergeScene(KX_Scene *other)
 
 		for (KX_GameObject *gameobj : physicsObjects) {
 			// Replicate all constraints in the right physics environment.
-			gameobj->ReplicateConstraints(m_physicsEnvironment, physicsObjects);
+			gameobj->ReplicateConstraints(env, physicsObjects);
 		}
 	}
 
-	m_objectlist->MergeList(other->GetObjectList());
-	other->GetObjectList()->ReleaseAndRemoveAll();
-
-	m_inactivelist->MergeList(other->GetInactiveList());
-	other->GetInactiveList()->ReleaseAndRemoveAll();
-
-	m_lightlist->MergeList(other->GetLightList());
-	other->GetLightList()->ReleaseAndRemoveAll();
-
-	m_cameralist->MergeList(other->GetCameraList());
-	other->GetCameraList()->ReleaseAndRemoveAll();
-
-	m_fontlist->MergeList(other->GetFontList());
-	other->GetFontList()->ReleaseAndRemoveAll();
-
 	// Grab any timer properties from the other scene.
 	SCA_TimeEventManager *timemgr_other = other->GetTimeEventManager();
 	std::vector<EXP_Value *> times = timemgr_other->GetTimeValues();
@@ -1635,9 +2155,61 @@ bool KX_Scene::MergeScene(KX_Scene *other)
 		m_timemgr->AddTimeProperty(time);
 	}
 
+	// The objects are inserted in the bounding volume tree of this scene at the next culling.
+	other->ResetBoundingVolumeTree();
+
 	return true;
 }
 
+unsigned int KX_Scene::MergeSceneObjects(KX_Scene *other, unsigned int index, unsigned int count)
+{
+	/* The objects are also kept in the lists of the other scene until MergeSceneEnd
+	 * which releases them. */
+	EXP_ListValue<KX_GameObject> *objects = other->GetObjectList();
+	EXP_ListValue<KX_GameObject> *inactiveObjects = other->GetInactiveList();
+	const unsigned int numObjects = objects->GetCount();
+	const unsigned int total = numObjects + inactiveObjects->GetCount();
+	const unsigned int end = (count < total - index) ? index + count : total;
+	const bool debugProperties = KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES);
+
+	for (; index < end; ++index) {
+		if (index < numObjects) {
+			KX_GameObject *gameobj = objects->GetValue(index);
+			MergeScene_GameObject(gameobj, this, other);
+
+			// Add properties to debug list for LibLoad objects.
+			if (debugProperties) {
+				AddObjectDebugProperties(gameobj);
+			}
+
+			// Register object for component update.
+			if (gameobj->GetComponents()) {
+				m_componentManager.RegisterObject(gameobj);
+			}
+
+			m_objectlist->Add(CM_AddRef(gameobj));
+			ScheduleBoundingVolumeUpdate(gameobj);
+		}
+		else {
+			KX_GameObject *gameobj = inactiveObjects->GetValue(index - numObjects);
+			MergeScene_GameObject(gameobj, this, other);
+			m_inactivelist->Add(CM_AddRef(gameobj));
+		}
+	}
+
+	return index;
+}
+
+void KX_Scene::MergeSceneEnd(KX_Scene *other)
+{
+	// The objects were added to the lists of this scene by MergeSceneObjects.
+	other->GetObjectList()->ReleaseAndRemoveAll();
+	other->GetInactiveList()->ReleaseAndRemoveAll();
+	other->GetLightList()->ReleaseAndRemoveAll();
+	other->GetCameraList()->ReleaseAndRemoveAll();
+	other->GetFontList()->ReleaseAndRemoveAll();
+}
+
 KX_2DFilterManager *KX_Scene::Get2DFilterManager() const
 {
 	return m_filterManager;
@@ -1660,6 +2232,40 @@ void KX_Scene::SetObstacleSimulation(KX_ObstacleSimulation *obstacleSimulation)
 
 #ifdef WITH_PYTHON
 
+/// Return the module and qualified name of a callback, e.g. "module.Class.method".
+static std::string GetCallbackName(PyObject *callback)
+{
+	PyObject *module = PyObject_GetAttrString(callback, "__module__");
+	PyObject *qualname = PyObject_GetAttrString(callback, "__qualname__");
+
+	std::string name;
+	if (module && PyUnicode_Check(module)) {
+		name = std::string(_PyUnicode_AsString(module)) + ".";
+	}
+	if (qualname && PyUnicode_Check(qualname)) {
+		name += _PyUnicode_AsString(qualname);
+	}
+	else {
+		name += Py_TYPE(callback)->tp_name;
+	}
+
+	Py_XDECREF(module);
+	Py_XDECREF(qualname);
+	PyErr_Clear();
+
+	return name;
+}
+
+void KX_Scene::ClearDrawCallbackInfos()
+{
+	for (std::vector<DrawCallbackInfo>& infos : m_drawCallbackInfos) {
+		for (DrawCallbackInfo& info : infos) {
+			Py_DECREF(info.callback);
+		}
+		infos.clear();
+	}
+}
+
 void KX_Scene::RunDrawingCallbacks(DrawingCallbackType callbackType, KX_Camera *camera)
 {
 	PyObject *list = m_drawCallbacks[callbackType];
@@ -1667,13 +2273,43 @@ void KX_Scene::RunDrawingCallbacks(DrawingCallbackType callbackType, KX_Camera *
 		return;
 	}
 
-	if (camera) {
-		PyObject *args[1] = {camera->GetProxy()};
-		EXP_RunPythonCallBackList(list, args, 0, 1);
+	PyObject *args[1] = {camera ? camera->GetProxy() : nullptr};
+	// The callbacks can take the camera or no argument.
+	const unsigned int argcount = camera ? 1 : 0;
+
+	/* The list is modified directly by the user, the profile infos are checked against
+	 * the callbacks instead, a callback can also modify or replace the list while it is run. */
+	std::vector<DrawCallbackInfo>& infos = m_drawCallbackInfos[callbackType];
+	Py_INCREF(list);
+
+	// Each callback is called separately to account its cost.
+	for (unsigned int i = 0; i < PyList_GET_SIZE(list); ++i) {
+		PyObject *item = PyList_GET_ITEM(list, i);
+		if (i == infos.size()) {
+			infos.push_back({nullptr, nullptr});
+		}
+
+		DrawCallbackInfo& info = infos[i];
+		if (info.callback != item) {
+			Py_XDECREF(info.callback);
+			Py_INCREF(item);
+			info.callback = item;
+			info.entry = &SCA_PythonProfiler::GetNamedEntry(SCA_PythonProfiler::DRAW_CALLBACK, GetCallbackName(item));
+		}
+
+		// The info could be modified by the callback, e.g. rendering the scene.
+		SCA_PythonProfiler::EntryMap::value_type *entry = info.entry;
+		SCA_PythonProfileScope profileScope(&entry->second, "DrawCallback", entry->first.c_str());
+		EXP_RunPythonCallback(item, args, 0, argcount);
 	}
-	else {
-		EXP_RunPythonCallBackList(list, nullptr, 0, 0);
+
+	// Release the callbacks removed from the list.
+	for (unsigned int i = PyList_GET_SIZE(list), size = infos.size(); i < size; ++i) {
+		Py_DECREF(infos[i].callback);
 	}
+	infos.resize(std::min<size_t>(infos.size(), PyList_GET_SIZE(list)));
+
+	Py_DECREF(list);
 }
 
 void KX_Scene::RunOnRemoveCallbacks()
@@ -1720,6 +2356,10 @@ PyMethodDef KX_Scene::Methods[] = {
 	EXP_PYMETHODTABLE(KX_Scene, suspend),
 	EXP_PYMETHODTABLE(KX_Scene, resume),
 	EXP_PYMETHODTABLE(KX_Scene, drawObstacleSimulation),
+	EXP_PYMETHODTABLE_KEYWORDS(KX_Scene, rayCastBatch),
+	EXP_PYMETHODTABLE(KX_Scene, getTransforms),
+	EXP_PYMETHODTABLE(KX_Scene, setTransforms),
+	EXP_PYMETHODTABLE_KEYWORDS(KX_Scene, setObjectPoolSize),
 
 	// Sict style access.
 	EXP_PYMETHODTABLE(KX_Scene, get),
@@ -2062,6 +2702,27 @@ int KX_Scene::pyattr_set_gravity(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE
 	return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_Scene::pyattr_get_transform_store(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+	KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+	return PyBool_FromLong(self->GetTransformStore() != nullptr);
+}
+
+int KX_Scene::pyattr_set_transform_store(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef, PyObject *value)
+{
+	KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+	const int use = PyObject_IsTrue(value);
+	if (use == -1) {
+		PyErr_SetString(PyExc_TypeError, "scene.transformStore = bool: KX_Scene, expected True or False");
+		return PY_SET_ATTR_FAIL;
+	}
+
+	self->SetUseTransformStore(use);
+	return PY_SET_ATTR_SUCCESS;
+}
+
 PyAttributeDef KX_Scene::Attributes[] = {
 	EXP_PYATTRIBUTE_RO_FUNCTION("name", KX_Scene, pyattr_get_name),
 	EXP_PYATTRIBUTE_RO_FUNCTION("objects", KX_Scene, pyattr_get_objects),
@@ -2081,6 +2742,7 @@ PyAttributeDef KX_Scene::Attributes[] = {
 	EXP_PYATTRIBUTE_BOOL_RO("suspended", KX_Scene, m_suspend),
 	EXP_PYATTRIBUTE_BOOL_RO("activityCulling", KX_Scene, m_activityCulling),
 	EXP_PYATTRIBUTE_BOOL_RO("dbvt_culling", KX_Scene, m_dbvtCulling),
+	EXP_PYATTRIBUTE_RW_FUNCTION("transformStore", KX_Scene, pyattr_get_transform_store, pyattr_set_transform_store),
 	EXP_PYATTRIBUTE_NULL // Sentinel
 };
 
@@ -2111,6 +2773,48 @@ EXP_PYMETHODDEF_DOC(KX_Scene, addObject,
 	return replica->GetProxy();
 }
 
+EXP_PYMETHODDEF_DOC(KX_Scene, setObjectPoolSize,
+                    "setObjectPoolSize(object, size, prewarm=False)\n"
+                    "Set the number of removed replicas of an inactive object kept to be reused by addObject.\n"
+                    " object = the inactive object\n"
+                    " size = maximum number of replicas kept, 0 to remove the pool\n"
+                    " prewarm = add the replicas to fill the pool immediately\n")
+{
+	PyObject *pyob;
+	KX_GameObject *ob;
+	int size;
+	int prewarm = 0;
+
+	if (!EXP_ParseTupleArgsAndKeywords(args, kwds, "Oi|i:setObjectPoolSize", {"object", "size", "prewarm", 0},
+	                                   &pyob, &size, &prewarm)) {
+		return nullptr;
+	}
+
+	if (!ConvertPythonToGameObject(m_logicmgr, pyob, &ob, false, "scene.setObjectPoolSize(object, size, prewarm): KX_Scene (first argument)")) {
+		return nullptr;
+	}
+
+	if (!m_inactivelist->SearchValue(ob)) {
+		PyErr_SetString(PyExc_ValueError, "scene.setObjectPoolSize(object, size, prewarm): KX_Scene (first argument): object must be in an inactive layer");
+		return nullptr;
+	}
+
+	if (!CanPoolObject(ob)) {
+		PyErr_SetString(PyExc_ValueError, "scene.setObjectPoolSize(object, size, prewarm): KX_Scene (first argument): "
+		                "object must be a mesh or empty object without logic bricks, components, children or dupli group");
+		return nullptr;
+	}
+
+	if (size < 0) {
+		PyErr_SetString(PyExc_ValueError, "scene.setObjectPoolSize(object, size, prewarm): KX_Scene (second argument): size must be positive");
+		return nullptr;
+	}
+
+	SetObjectPoolSize(ob, size, prewarm);
+
+	Py_RETURN_NONE;
+}
+
 EXP_PYMETHODDEF_DOC(KX_Scene, end,
                     "end()\n"
                     "Removes this scene from the game.\n")
@@ -2177,6 +2881,443 @@ EXP_PYMETHODDEF_DOC(KX_Scene, drawObstacleSimulation,
 	Py_RETURN_NONE;
 }
 
+/// Filter shared by the rays of KX_Scene.rayCastBatch, called from multiple threads.
+class KX_RayCastBatchFilter : public PHY_IRayCastFilterCallback
+{
+private:
+	const KX_GameObject::RayCastData& m_rayData;
+
+public:
+	KX_RayCastBatchFilter(const KX_GameObject::RayCastData& rayData)
+		:PHY_IRayCastFilterCallback(nullptr),
+		m_rayData(rayData)
+	{
+	}
+
+	virtual bool needBroadphaseRayCast(PHY_IPhysicsController *controller)
+	{
+		KX_ClientObjectInfo *info = static_cast<KX_ClientObjectInfo *>(controller->GetNewClientInfo());
+		// With the X-Ray option the objects not matching are skipped, else the closest object is tested after.
+		return (info && (!m_rayData.m_xray || m_rayData.CheckObject(info->m_gameobject)));
+	}
+
+	virtual void reportHit(PHY_RayCastResult *result)
+	{
+	}
+};
+
+EXP_PYMETHODDEF_DOC(KX_Scene, rayCastBatch,
+                    "rayCastBatch(origins, targets, mask, prop, xray, ignore)\n"
+                    "Cast multiple rays in parallel and return a tuple of the list of the hit objects\n"
+                    "and a buffer of the hit points and normals of shape (count, 6).\n"
+                    " origins, targets = buffers of floats or doubles of shape (count, 3)\n"
+                    " mask = collision mask: the collision mask that rays can hit, 0 < mask < 65536\n"
+                    " prop = property name that objects must have; can be omitted => detect any object\n"
+                    " xray = X-ray option: 1=>skip objects that don't match prop and mask; 0 or omitted => stop on first object\n"
+                    " ignore = object ignored by all rays or sequence of objects ignored by each ray, can be None\n")
+{
+	PyObject *pyorigins;
+	PyObject *pytargets;
+	int mask = (1 << OB_MAX_COL_MASKS) - 1;
+	const char *propName = "";
+	int xray = 0;
+	PyObject *pyignore = Py_None;
+
+	if (!EXP_ParseTupleArgsAndKeywords(args, kwds, "OO|isiO:rayCastBatch",
+	                                   {"origins", "targets", "mask", "prop", "xray", "ignore", 0},
+	                                   &pyorigins, &pytargets, &mask, &propName, &xray, &pyignore)) {
+		return nullptr;
+	}
+
+	std::vector<float> origins;
+	std::vector<float> targets;
+	if (!PyBufferToFloats(pyorigins, 3, origins, "scene.rayCastBatch(origins, targets, ...): KX_Scene, origins") ||
+	    !PyBufferToFloats(pytargets, 3, targets, "scene.rayCastBatch(origins, targets, ...): KX_Scene, targets")) {
+		return nullptr;
+	}
+
+	if (origins.size() != targets.size()) {
+		PyErr_SetString(PyExc_ValueError, "scene.rayCastBatch(origins, targets, ...): KX_Scene, origins and targets must have the same size");
+		return nullptr;
+	}
+
+	if (mask == 0 || mask & ~((1 << OB_MAX_COL_MASKS) - 1)) {
+		PyErr_Format(PyExc_TypeError, "scene.rayCastBatch(origins, targets, ...): KX_Scene, mask must be a int bitfield, 0 < mask < %i", (1 << OB_MAX_COL_MASKS));
+		return nullptr;
+	}
+
+	const unsigned int count = origins.size() / 3;
+	std::vector<PHY_RayCastQuery, mt::simd_allocator<PHY_RayCastQuery> > queries(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		PHY_RayCastQuery& query = queries[i];
+		query.m_from = mt::vec3(&origins[i * 3]);
+		query.m_to = mt::vec3(&targets[i * 3]);
+		query.m_ignoreController = nullptr;
+	}
+
+	// Ignore a single object for all the rays or one object per ray.
+	KX_GameObject *ignore;
+	// An object name is a sequence too.
+	if (!PyUnicode_Check(pyignore) && PySequence_Check(pyignore)) {
+		if (PySequence_Size(pyignore) != count) {
+			PyErr_SetString(PyExc_ValueError, "scene.rayCastBatch(origins, targets, ...): KX_Scene, ignore must contain an object or None per ray");
+			return nullptr;
+		}
+
+		for (unsigned int i = 0; i < count; ++i) {
+			PyObject *item = PySequence_GetItem(pyignore, i);
+			const bool valid = ConvertPythonToGameObject(m_logicmgr, item, &ignore, true, "scene.rayCastBatch(origins, targets, ...): KX_Scene, ignore");
+			Py_DECREF(item);
+			if (!valid) {
+				return nullptr;
+			}
+			queries[i].m_ignoreController = ignore ? ignore->GetPhysicsController() : nullptr;
+		}
+	}
+	else {
+		if (!ConvertPythonToGameObject(m_logicmgr, pyignore, &ignore, true, "scene.rayCastBatch(origins, targets, ...): KX_Scene, ignore")) {
+			return nullptr;
+		}
+		if (ignore) {
+			for (PHY_RayCastQuery& query : queries) {
+				query.m_ignoreController = ignore->GetPhysicsController();
+			}
+		}
+	}
+
+	const KX_GameObject::RayCastData rayData(propName, xray, mask);
+	KX_RayCastBatchFilter filter(rayData);
+	std::vector<PHY_RayCastResult> results(count);
+	if (m_physicsEnvironment) {
+		m_physicsEnvironment->RayTestBatch(filter, queries.data(), results.data(), count);
+	}
+
+	PyObject *objects = PyList_New(count);
+	if (!objects) {
+		return nullptr;
+	}
+
+	std::vector<float> hits(count * 6, 0.0f);
+	for (unsigned int i = 0; i < count; ++i) {
+		const PHY_RayCastResult& result = results[i];
+		KX_GameObject *hitObject = nullptr;
+		if (result.m_controller) {
+			KX_ClientObjectInfo *info = static_cast<KX_ClientObjectInfo *>(result.m_controller->GetNewClientInfo());
+			hitObject = info ? info->m_gameobject : nullptr;
+			// Without the X-Ray option the closest object must match the property and mask.
+			if (hitObject && !xray && !rayData.CheckObject(hitObject)) {
+				hitObject = nullptr;
+			}
+		}
+
+		if (hitObject) {
+			PyList_SET_ITEM(objects, i, hitObject->GetProxy());
+			result.m_hitPoint.Pack(&hits[i * 6]);
+			result.m_hitNormal.Pack(&hits[i * 6 + 3]);
+		}
+		else {
+			Py_INCREF(Py_None);
+			PyList_SET_ITEM(objects, i, Py_None);
+		}
+	}
+
+	PyObject *buffer = PyBufferFromFloats(hits.data(), hits.size(), 6);
+	if (!buffer) {
+		Py_DECREF(objects);
+		return nullptr;
+	}
+
+	PyObject *ret = PyTuple_New(2);
+	if (!ret) {
+		Py_DECREF(objects);
+		Py_DECREF(buffer);
+		return nullptr;
+	}
+
+	PyTuple_SET_ITEM(ret, 0, objects);
+	PyTuple_SET_ITEM(ret, 1, buffer);
+	return ret;
+}
+
+/// Transform attributes read or written by KX_Scene.getTransforms and KX_Scene.setTransforms.
+enum KX_BulkAttribute {
+	BULK_WORLD_POSITION = 0,
+	BULK_LOCAL_POSITION,
+	BULK_WORLD_ORIENTATION,
+	BULK_LOCAL_ORIENTATION,
+	BULK_WORLD_SCALE,
+	BULK_LOCAL_SCALE,
+	BULK_WORLD_LINEAR_VELOCITY,
+	BULK_LOCAL_LINEAR_VELOCITY,
+	BULK_WORLD_ANGULAR_VELOCITY,
+	BULK_LOCAL_ANGULAR_VELOCITY,
+	BULK_MAX
+};
+
+/// Names of the attributes as in KX_GameObject and number of floats per object.
+static const struct {
+	const char *name;
+	unsigned int width;
+} bulkAttributes[BULK_MAX] = {
+	{"worldPosition", 3},
+	{"localPosition", 3},
+	{"worldOrientation", 9},
+	{"localOrientation", 9},
+	{"worldScale", 3},
+	{"localScale", 3},
+	{"worldLinearVelocity", 3},
+	{"localLinearVelocity", 3},
+	{"worldAngularVelocity", 3},
+	{"localAngularVelocity", 3}
+};
+
+/// Convert the attribute name and the sequence of objects of a bulk access.
+static bool ConvertBulkArguments(SCA_LogicManager *logicmgr, PyObject *pyobjects, const char *attribute,
+                                 std::vector<KX_GameObject *>& objects, KX_BulkAttribute& bulkAttribute, const char *error_prefix)
+{
+	bulkAttribute = BULK_MAX;
+	for (unsigned short i = 0; i < BULK_MAX; ++i) {
+		if (STREQ(attribute, bulkAttributes[i].name)) {
+			bulkAttribute = (KX_BulkAttribute)i;
+			break;
+		}
+	}
+
+	if (bulkAttribute == BULK_MAX) {
+		PyErr_Format(PyExc_ValueError, "%s, unknown attribute \"%s\"", error_prefix, attribute);
+		return false;
+	}
+
+	PyObject *fast = PySequence_Fast(pyobjects, "");
+	if (!fast) {
+		PyErr_Format(PyExc_TypeError, "%s, expected a sequence of objects", error_prefix);
+		return false;
+	}
+
+	const unsigned int size = PySequence_Fast_GET_SIZE(fast);
+	PyObject **items = PySequence_Fast_ITEMS(fast);
+	objects.resize(size);
+	for (unsigned int i = 0; i < size; ++i) {
+		if (!ConvertPythonToGameObject(logicmgr, items[i], &objects[i], false, error_prefix)) {
+			Py_DECREF(fast);
+			return false;
+		}
+	}
+
+	Py_DECREF(fast);
+	return true;
+}
+
+/// Write a matrix in row major order as mathutils.
+static void PackBulkMatrix(const mt::mat3& mat, float *values)
+{
+	for (unsigned short row = 0; row < 3; ++row) {
+		for (unsigned short col = 0; col < 3; ++col) {
+			values[row * 3 + col] = mat(row, col);
+		}
+	}
+}
+
+static mt::mat3 UnpackBulkMatrix(const float *values)
+{
+	mt::mat3 mat;
+	for (unsigned short row = 0; row < 3; ++row) {
+		for (unsigned short col = 0; col < 3; ++col) {
+			mat(row, col) = values[row * 3 + col];
+		}
+	}
+	return mat;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene, getTransforms,
+                    "getTransforms(objects, attribute)\n"
+                    "Return a buffer of shape (count, 3) or (count, 9) of a transform attribute of each object.\n"
+                    " objects = sequence of objects or object names\n"
+                    " attribute = name of a game object attribute, e.g. \"worldPosition\" or \"worldOrientation\"\n")
+{
+	PyObject *pyobjects;
+	const char *attribute;
+
+	if (!PyArg_ParseTuple(args, "Os:getTransforms", &pyobjects, &attribute)) {
+		return nullptr;
+	}
+
+	std::vector<KX_GameObject *> objects;
+	KX_BulkAttribute bulkAttribute;
+	if (!ConvertBulkArguments(m_logicmgr, pyobjects, attribute, objects, bulkAttribute, "scene.getTransforms(objects, attribute): KX_Scene")) {
+		return nullptr;
+	}
+
+	const unsigned int width = bulkAttributes[bulkAttribute].width;
+	std::vector<float> values(objects.size() * width);
+	for (unsigned int i = 0, size = objects.size(); i < size; ++i) {
+		KX_GameObject *gameobj = objects[i];
+		float *value = &values[i * width];
+		switch (bulkAttribute) {
+			case BULK_WORLD_POSITION:
+			{
+				gameobj->NodeGetWorldPosition().Pack(value);
+				break;
+			}
+			case BULK_LOCAL_POSITION:
+			{
+				gameobj->NodeGetLocalPosition().Pack(value);
+				break;
+			}
+			case BULK_WORLD_ORIENTATION:
+			{
+				PackBulkMatrix(gameobj->NodeGetWorldOrientation(), value);
+				break;
+			}
+			case BULK_LOCAL_ORIENTATION:
+			{
+				PackBulkMatrix(gameobj->NodeGetLocalOrientation(), value);
+				break;
+			}
+			case BULK_WORLD_SCALE:
+			{
+				gameobj->NodeGetWorldScaling().Pack(value);
+				break;
+			}
+			case BULK_LOCAL_SCALE:
+			{
+				gameobj->NodeGetLocalScaling().Pack(value);
+				break;
+			}
+			case BULK_WORLD_LINEAR_VELOCITY:
+			case BULK_LOCAL_LINEAR_VELOCITY:
+			{
+				gameobj->GetLinearVelocity(bulkAttribute == BULK_LOCAL_LINEAR_VELOCITY).Pack(value);
+				break;
+			}
+			case BULK_WORLD_ANGULAR_VELOCITY:
+			case BULK_LOCAL_ANGULAR_VELOCITY:
+			{
+				gameobj->GetAngularVelocity(bulkAttribute == BULK_LOCAL_ANGULAR_VELOCITY).Pack(value);
+				break;
+			}
+			case BULK_MAX:
+			{
+				BLI_assert(false);
+				break;
+			}
+		}
+	}
+
+	return PyBufferFromFloats(values.data(), values.size(), width);
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene, setTransforms,
+                    "setTransforms(objects, attribute, values)\n"
+                    "Set a transform attribute of each object from a buffer of shape (count, 3) or (count, 9).\n"
+                    " objects = sequence of objects or object names\n"
+                    " attribute = name of a game object attribute, e.g. \"worldPosition\" or \"worldOrientation\"\n"
+                    " values = buffer of floats or doubles\n")
+{
+	PyObject *pyobjects;
+	const char *attribute;
+	PyObject *pyvalues;
+
+	if (!PyArg_ParseTuple(args, "OsO:setTransforms", &pyobjects, &attribute, &pyvalues)) {
+		return nullptr;
+	}
+
+	std::vector<KX_GameObject *> objects;
+	KX_BulkAttribute bulkAttribute;
+	if (!ConvertBulkArguments(m_logicmgr, pyobjects, attribute, objects, bulkAttribute,
+	                          "scene.setTransforms(objects, attribute, values): KX_Scene")) {
+		return nullptr;
+	}
+
+	const unsigned int width = bulkAttributes[bulkAttribute].width;
+	std::vector<float> values;
+	if (!PyBufferToFloats(pyvalues, width, values, "scene.setTransforms(objects, attribute, values): KX_Scene, values")) {
+		return nullptr;
+	}
+
+	if (values.size() != objects.size() * width) {
+		PyErr_Format(PyExc_ValueError, "scene.setTransforms(objects, attribute, values): KX_Scene, expected %u values for %u objects, not %u",
+		             (unsigned int)(objects.size() * width), (unsigned int)objects.size(), (unsigned int)values.size());
+		return nullptr;
+	}
+
+	const bool worldSpace = ELEM(bulkAttribute, BULK_WORLD_POSITION, BULK_WORLD_ORIENTATION, BULK_WORLD_SCALE);
+
+	/* The modified nodes are scheduled in the scene graph update list and their world data
+	 * updated in one pass at the end instead of after each object. A world transform of a
+	 * child is converted from the world transform of its parent, the scheduled nodes are
+	 * then updated before. */
+	bool scheduled = false;
+	for (unsigned int i = 0, size = objects.size(); i < size; ++i) {
+		KX_GameObject *gameobj = objects[i];
+		const float *value = &values[i * width];
+
+		if (worldSpace && scheduled && gameobj->GetNode()->GetParent()) {
+			UpdateParents();
+			scheduled = false;
+		}
+
+		switch (bulkAttribute) {
+			case BULK_WORLD_POSITION:
+			{
+				gameobj->NodeSetWorldPosition(mt::vec3(value));
+				break;
+			}
+			case BULK_LOCAL_POSITION:
+			{
+				gameobj->NodeSetLocalPosition(mt::vec3(value));
+				break;
+			}
+			case BULK_WORLD_ORIENTATION:
+			{
+				gameobj->NodeSetGlobalOrientation(UnpackBulkMatrix(value));
+				break;
+			}
+			case BULK_LOCAL_ORIENTATION:
+			{
+				gameobj->NodeSetLocalOrientation(UnpackBulkMatrix(value));
+				break;
+			}
+			case BULK_WORLD_SCALE:
+			{
+				gameobj->NodeSetWorldScale(mt::vec3(value));
+				break;
+			}
+			case BULK_LOCAL_SCALE:
+			{
+				gameobj->NodeSetLocalScale(mt::vec3(value));
+				break;
+			}
+			case BULK_WORLD_LINEAR_VELOCITY:
+			case BULK_LOCAL_LINEAR_VELOCITY:
+			{
+				gameobj->SetLinearVelocity(mt::vec3(value), bulkAttribute == BULK_LOCAL_LINEAR_VELOCITY);
+				// The velocities don't modify the node.
+				continue;
+			}
+			case BULK_WORLD_ANGULAR_VELOCITY:
+			case BULK_LOCAL_ANGULAR_VELOCITY:
+			{
+				gameobj->SetAngularVelocity(mt::vec3(value), bulkAttribute == BULK_LOCAL_ANGULAR_VELOCITY);
+				continue;
+			}
+			case BULK_MAX:
+			{
+				BLI_assert(false);
+				break;
+			}
+		}
+
+		scheduled = true;
+	}
+
+	if (scheduled) {
+		UpdateParents();
+	}
+
+	Py_RETURN_NONE;
+}
+
 EXP_PYMETHODDEF_DOC(KX_Scene, get, "")
 {
 	PyObject *key;
@@ -33,6 +33,7 @@
 #include "SG_Scene.h"
 #include "SG_Frustum.h"
 #include "SCA_IScene.h"
+#include "SCA_PythonProfiler.h"
 
 #include "RAS_Rasterizer.h" // For RAS_Rasterizer::DrawType.
 #include "RAS_DebugDraw.h"
@@ -42,6 +43,10 @@
 #include "EXP_PyObjectPlus.h"
 #include "EXP_Value.h"
 
+#include "BL_Resource.h" // For BL_Resource::Library.
+
+#include "CM_Thread.h"
+
 #include <set>
 
 template <class T>
@@ -64,10 +69,12 @@ class KX_GameObject;
 class KX_LightObject;
 struct KX_ClientObjectInfo;
 class BL_SceneConverter;
+class BL_PoseCache;
 class SG_Node;
 class PHY_IPhysicsEnvironment;
 class RAS_Mesh;
 class RAS_BoundingBoxManager;
+class RAS_BoundingVolumeTree;
 class RAS_BucketManager;
 class RAS_MaterialBucket;
 class RAS_IMaterial;
@@ -93,6 +100,18 @@ public:
 		double curtime;
 	};
 
+	/// Time spent in the stages of the scene since the last profile measurement, in seconds.
+	struct ProfileTimes
+	{
+		double logic;
+		double physics;
+		double scenegraph;
+		/// Time spent in AddReplicaObject, included in the logic time.
+		double replication;
+		/// Number of objects added by AddReplicaObject.
+		unsigned int replicas;
+	};
+
 	static SG_Callbacks m_callbacks;
 
 private:
@@ -102,6 +121,23 @@ private:
 	PyObject *m_attrDict;
 	PyObject *m_removeCallbacks;
 	PyObject *m_drawCallbacks[MAX_DRAW_CALLBACK];
+
+	/// Profile entry of a draw callback.
+	struct DrawCallbackInfo
+	{
+		/// The callback, a reference is kept so that an other callback can't reuse its address.
+		PyObject *callback;
+		/// The profile entry and its name, never freed.
+		SCA_PythonProfiler::EntryMap::value_type *entry;
+	};
+
+	/** Profile infos of the draw callbacks at the same index in the callback lists,
+	 * an info is updated when the callback at its index changed.
+	 */
+	std::vector<DrawCallbackInfo> m_drawCallbackInfos[MAX_DRAW_CALLBACK];
+
+	/// Release the references to the callbacks of the profile infos.
+	void ClearDrawCallbackInfos();
 #endif
 
 	struct CullingInfo
@@ -121,6 +157,18 @@ private:
 
 	/// Manager used to update all the mesh bounding box.
 	RAS_BoundingBoxManager *m_boundingBoxManager;
+	/** Tree of the object world bounding boxes used for culling when the physics
+	 * engine doesn't provide it. Objects are inserted and refitted lazily.
+	 */
+	RAS_BoundingVolumeTree *m_boundingVolumeTree;
+	/// True once the bounding volume tree is used, the objects are then scheduled for update.
+	bool m_useBoundingVolumeTree;
+	/** Objects added or of which the transform or bounds changed since the last tree update,
+	 * an object is scheduled once while its node has the DIRTY_CULLING flag.
+	 */
+	std::vector<KX_GameObject *> m_boundingVolumeUpdates;
+	/// Lock of the scheduled objects, the transforms and bounds are updated in tasks.
+	CM_ThreadSpinLock m_boundingVolumeMutex;
 
 	std::vector<KX_GameObject *> m_tempObjectList;
 
@@ -193,6 +241,20 @@ private:
 	 */
 	std::set<KX_GameObject *> m_groupGameObjects;
 
+	/// Replicas of an object kept after their removal to be reused by AddReplicaObject.
+	struct ObjectPool
+	{
+		/// Maximum number of parked replicas.
+		unsigned int m_size;
+		/// Parked replicas, deactivated and out of the object list.
+		std::vector<KX_GameObject *> m_objects;
+	};
+
+	/// Object pools per original object.
+	std::map<KX_GameObject *, ObjectPool> m_objectPools;
+	/// Original object of the added replicas which can return to a pool once removed.
+	std::map<KX_GameObject *, KX_GameObject *> m_pooledReplicas;
+
 	/// The execution priority of replicated object actuators.
 	int m_ueberExecutionPriority;
 
@@ -205,6 +267,8 @@ private:
 
 	/// Toggle to enable or disable object activity culling.
 	bool m_activityCulling;
+	/// Minimum squared distance to cameras per transform store entry, used by activity culling.
+	std::vector<float> m_activityDistances;
 
 	/// Toggle to enable or disable culling via DBVT broadphase of Bullet.
 	bool m_dbvtCulling;
@@ -226,6 +290,10 @@ private:
 
 	/// Visibility testing functions.
 	static void PhysicsCullingCallback(KX_ClientObjectInfo *objectInfo, void *cullingInfo);
+	/// Remove the objects from the bounding volume tree and stop scheduling them.
+	void ResetBoundingVolumeTree();
+	/// Remove an object from the bounding volume tree and from the scheduled objects.
+	void UnscheduleBoundingVolumeUpdate(KX_GameObject *gameobj);
 
 	Scene *m_blenderScene;
 
@@ -236,6 +304,11 @@ private:
 	AnimationPoolData m_animationPoolData;
 	TaskPool *m_animationPool;
 	double m_previousAnimTime;
+	/// Poses shared by the armature instances, cleared every animation update.
+	BL_PoseCache *m_poseCache;
+
+	/// Times spent per stages, reset by the engine every profile measurement.
+	ProfileTimes m_profileTimes;
 
 	/// LOD Hysteresis settings.
 	bool m_isActivedHysteresis;
@@ -246,6 +319,13 @@ private:
 	void RemoveDupliGroup(KX_GameObject *gameobj);
 	bool NewRemoveObject(KX_GameObject *gameobj);
 
+	/// Reactivate a parked replica of original, return nullptr if the pool is empty.
+	KX_GameObject *ReuseReplicaObject(KX_GameObject *original);
+	/// Deactivate and park a removed replica in the pool of its original, return false if not possible.
+	bool ParkReplicaObject(KX_GameObject *gameobj);
+	/// Destruct a parked replica.
+	void DestructParkedObject(KX_GameObject *gameobj);
+
 public:
 	KX_Scene(SCA_IInputDevice *inputDevice,
 	         const std::string& scenename,
@@ -256,6 +336,19 @@ public:
 	RAS_BucketManager *GetBucketManager() const;
 	KX_TextureRendererManager *GetTextureRendererManager() const;
 	RAS_BoundingBoxManager *GetBoundingBoxManager() const;
+	RAS_BoundingVolumeTree *GetBoundingVolumeTree() const;
+	/** Schedule the insertion or refit of an object in the bounding volume tree.
+	 * Does nothing until the tree is used, can be called from tasks.
+	 */
+	void ScheduleBoundingVolumeUpdate(KX_GameObject *gameobj);
+	/** Insert the scheduled new objects in the bounding volume tree and refit the moved ones.
+	 * The tree is used from the first call, all the objects are then inserted.
+	 */
+	void UpdateBoundingVolumeTree();
+	/** Refit the scheduled objects only if the tree is already used, called after the
+	 * logic scene graph update to keep the tree current when nothing is rendered.
+	 */
+	void RefitBoundingVolumeTree();
 	void RenderBuckets(const std::vector<KX_GameObject *>& objects, RAS_Rasterizer::DrawType drawingMode,
 			const mt::mat3x4& cameratransform, unsigned short viewportIndex,
 			RAS_Rasterizer *rasty, RAS_OffScreen *offScreen);
@@ -276,6 +369,23 @@ public:
 	KX_GameObject *AddReplicaObject(KX_GameObject *gameobj, KX_GameObject *locationobj, float lifespan = 0.0f);
 	KX_GameObject *AddNodeReplicaObject(SG_Node *node, KX_GameObject *gameobj);
 
+	/** Return true if the replicas of original can be pooled, only the objects without
+	 * logic bricks, components, children or dupli group and of a plain object type are.
+	 */
+	bool CanPoolObject(KX_GameObject *original) const;
+	/** Set the maximum number of replicas of original kept after their removal to be
+	 * reused by AddReplicaObject instead of replicating the object again. A pool of size
+	 * zero is removed.
+	 * \param prewarm Replicate the object to fill the pool immediately.
+	 */
+	void SetObjectPoolSize(KX_GameObject *original, unsigned int size, bool prewarm);
+	/// Destruct all the parked replicas and remove all the pools.
+	void ClearObjectPools();
+	/** Remove the pools of the originals belonging to a library and destruct their parked
+	 * replicas, the parked replicas of the other pools release the library ressources.
+	 */
+	void RemoveObjectPoolsRessources(const BL_Resource::Library& libraryId);
+
 	/// Add an object to remove.
 	void DelayedRemoveObject(KX_GameObject *gameobj);
 	/// Effectivly remove object added with DelayedRemoveObject
@@ -344,6 +454,12 @@ public:
 	std::vector<KX_GameObject *> CalculateVisibleMeshes(KX_Camera *cam, RAS_Rasterizer::StereoEye eye, int layer);
 	std::vector<KX_GameObject *> CalculateVisibleMeshes(bool frustumCulling, const SG_Frustum& frustum, int layer);
 	std::vector<KX_GameObject *> CalculateVisibleMeshes(const SG_Frustum& frustum, int layer);
+	/** Compute the non-culled objects of all the camera and texture views of a scene schedule
+	 * in a single pass over the objects. The bounding volumes are updated only once.
+	 * Nothing is computed when DBVT culling is used as it depends on the viewport of each view.
+	 * \return True if the objects of each view were computed.
+	 */
+	bool CalculateVisibleMeshes(KX_SceneRenderSchedule& sceneSchedule);
 
 	RAS_DebugDraw& GetDebugDraw();
 	/// \section Debug draw.
@@ -378,6 +494,9 @@ public:
 
 	bool IsSuspended() const;
 
+	ProfileTimes& GetProfileTimes();
+	BL_PoseCache& GetPoseCache();
+
 	/// Use of DBVT tree for camera culling
 	void SetDbvtCulling(bool b);
 	bool GetDbvtCulling() const;
@@ -406,8 +525,24 @@ public:
 	/// Returns the Blender scene this was made from.
 	Scene *GetBlenderScene() const;
 
+	/// Merge all the data and objects of an other scene in one go.
 	bool MergeScene(KX_Scene *other);
 
+	/** Merge the render, bounding box, texture renderer, physics and timer data of an
+	 * other scene, it must be called before merging its objects.
+	 * \return False if the physics environment types differ.
+	 */
+	bool MergeSceneBegin(KX_Scene *other);
+	/** Merge a range of objects of an other scene, the objects are indexed from
+	 * the active objects followed by the inactive objects.
+	 * \param index The index of the first object to merge.
+	 * \param count The maximum number of objects to merge.
+	 * \return The index of the next object to merge.
+	 */
+	unsigned int MergeSceneObjects(KX_Scene *other, unsigned int index, unsigned int count);
+	/// Release the objects of an other scene once they are all merged.
+	void MergeSceneEnd(KX_Scene *other);
+
 	/// 2D Filters.
 	KX_2DFilterManager *Get2DFilterManager() const;
 	RAS_OffScreen *Render2DFilters(RAS_Rasterizer *rasty, RAS_ICanvas *canvas, RAS_OffScreen *inputofs, RAS_OffScreen *targetofs);
@@ -428,6 +563,10 @@ public:
 	EXP_PYMETHOD_DOC(KX_Scene, resume);
 	EXP_PYMETHOD_DOC(KX_Scene, get);
 	EXP_PYMETHOD_DOC(KX_Scene, drawObstacleSimulation);
+	EXP_PYMETHOD_DOC(KX_Scene, rayCastBatch);
+	EXP_PYMETHOD_DOC(KX_Scene, getTransforms);
+	EXP_PYMETHOD_DOC(KX_Scene, setTransforms);
+	EXP_PYMETHOD_DOC(KX_Scene, setObjectPoolSize);
 
 	// Attributes.
 	static PyObject *pyattr_get_name(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
@@ -448,6 +587,8 @@ public:
 	static int pyattr_set_remove_callback(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef, PyObject *value);
 	static PyObject *pyattr_get_gravity(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 	static int pyattr_set_gravity(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef, PyObject *value);
+	static PyObject *pyattr_get_transform_store(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+	static int pyattr_set_transform_store(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef, PyObject *value);
 
 	// getitem/setitem
 	static PyMappingMethods Mapping;
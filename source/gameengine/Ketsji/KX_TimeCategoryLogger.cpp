@@ -27,7 +27,9 @@
 KX_TimeCategoryLogger::KX_TimeCategoryLogger(const CM_Clock& clock, unsigned int maxNumMeasurements)
 	:m_clock(clock),
 	m_maxNumMeasurements(maxNumMeasurements),
-	m_lastCategory(-1)
+	m_lastCategory(-1),
+	m_traceCategory(-1),
+	m_traceStart(0)
 {
 }
 
@@ -48,14 +50,33 @@ unsigned int KX_TimeCategoryLogger::GetMaxNumMeasurements() const
 	return m_maxNumMeasurements;
 }
 
-void KX_TimeCategoryLogger::AddCategory(TimeCategory tc)
+void KX_TimeCategoryLogger::AddCategory(TimeCategory tc, const char *name)
 {
 	// Only add if not already present
 	if (m_loggers.find(tc) == m_loggers.end()) {
 		m_loggers.emplace(TimeLoggerMap::value_type(tc, KX_TimeLogger(m_maxNumMeasurements)));
+		m_names[tc] = name;
 	}
 }
 
+void KX_TimeCategoryLogger::TraceCategory(TimeCategory tc)
+{
+	if (!CM_Profiler::IsEnabled()) {
+		m_traceCategory = -1;
+		return;
+	}
+
+	// All the loggers are used from the main thread and share the same track.
+	static CM_ProfileTrack *track = CM_Profiler::AddTrack("Time Categories");
+
+	const CM_Clock::Rep now = CM_Profiler::GetTime();
+	if (m_traceCategory != -1) {
+		track->AddEvent(m_names[m_traceCategory], nullptr, m_traceStart, now);
+	}
+	m_traceCategory = tc;
+	m_traceStart = now;
+}
+
 void KX_TimeCategoryLogger::StartLog(TimeCategory tc)
 {
 	const double now = m_clock.GetTimeSecond();
@@ -64,6 +85,8 @@ void KX_TimeCategoryLogger::StartLog(TimeCategory tc)
 	}
 	m_loggers[tc].StartLog(now);
 	m_lastCategory = tc;
+
+	TraceCategory(tc);
 }
 
 void KX_TimeCategoryLogger::EndLog(TimeCategory tc)
@@ -77,6 +100,8 @@ void KX_TimeCategoryLogger::EndLog()
 	const double now = m_clock.GetTimeSecond();
 	m_loggers[m_lastCategory].EndLog(now);
 	m_lastCategory = -1;
+
+	TraceCategory(-1);
 }
 
 void KX_TimeCategoryLogger::NextMeasurement()
@@ -32,12 +32,14 @@
 
 #include "KX_TimeLogger.h"
 #include "CM_Clock.h"
+#include "CM_Profiler.h"
 
 /**
  * Stores and manages time measurements by category.
  * Categories can be added dynamically.
  * Average measurements can be established for each separate category
  * or for all categories together.
+ * When the profiler is enabled the categories are also traced as events.
  */
 class KX_TimeCategoryLogger
 {
@@ -69,8 +71,9 @@ public:
 	/**
 	 * Adds a category.
 	 * \param category	The new category.
+	 * \param name		The static name used for the trace events.
 	 */
-	void AddCategory(TimeCategory tc);
+	void AddCategory(TimeCategory tc, const char *name = "Category");
 
 	/**
 	 * Starts logging in current measurement for the given category.
@@ -113,6 +116,15 @@ protected:
 	unsigned int m_maxNumMeasurements;
 
 	TimeCategory m_lastCategory;
+
+	/// Names of the categories for the trace events.
+	std::map<TimeCategory, const char *> m_names;
+	/// Category traced since m_traceStart, -1 if none.
+	TimeCategory m_traceCategory;
+	CM_Clock::Rep m_traceStart;
+
+	/// End the trace event of the current category and start the one of the new category.
+	void TraceCategory(TimeCategory tc);
 };
 
 #endif  /* __KX_TIMECATEGORYLOGGER_H__ */
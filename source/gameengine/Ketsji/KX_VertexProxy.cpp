@@ -195,7 +195,7 @@ bool KX_VertexProxy::py_set_uvs_item(unsigned int index, PyObject *item)
 	}
 
 	m_array->SetUv(m_vertexIndex, index, uv);
-	m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+	m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, m_vertexIndex, m_vertexIndex + 1);
 
 	return true;
 }
@@ -227,7 +227,7 @@ bool KX_VertexProxy::py_set_colors_item(unsigned int index, PyObject *item)
 	}
 
 	m_array->SetColor(m_vertexIndex, index, color);
-	m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED);
+	m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, m_vertexIndex, m_vertexIndex + 1);
 
 	return true;
 }
@@ -259,7 +259,7 @@ int KX_VertexProxy::pyattr_set_x(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetPosition(self->m_vertexIndex).x = val;
-		self->m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -271,7 +271,7 @@ int KX_VertexProxy::pyattr_set_y(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetPosition(self->m_vertexIndex).y = val;
-		self->m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -283,7 +283,7 @@ int KX_VertexProxy::pyattr_set_z(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetPosition(self->m_vertexIndex).z = val;
-		self->m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -295,7 +295,7 @@ int KX_VertexProxy::pyattr_set_u(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetUv(self->m_vertexIndex, 0).x = val;
-		self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -307,7 +307,7 @@ int KX_VertexProxy::pyattr_set_v(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetUv(self->m_vertexIndex, 0).y = val;
-		self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -320,7 +320,7 @@ int KX_VertexProxy::pyattr_set_u2(EXP_PyObjectPlus *self_v, const struct EXP_PYA
 		if (self->m_array->GetFormat().uvSize > 1) {
 			float val = PyFloat_AsDouble(value);
 			self->m_array->GetUv(self->m_vertexIndex, 1).x = val;
-			self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+			self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		}
 		return PY_SET_ATTR_SUCCESS;
 	}
@@ -334,7 +334,7 @@ int KX_VertexProxy::pyattr_set_v2(EXP_PyObjectPlus *self_v, const struct EXP_PYA
 		if (self->m_array->GetFormat().uvSize > 1) {
 			float val = PyFloat_AsDouble(value);
 			self->m_array->GetUv(self->m_vertexIndex, 1).y = val;
-			self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+			self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		}
 		return PY_SET_ATTR_SUCCESS;
 	}
@@ -347,7 +347,7 @@ int KX_VertexProxy::pyattr_set_r(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetColor(self->m_vertexIndex, 0)[0] = (unsigned char)(val * 255.0f);
-		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -359,7 +359,7 @@ int KX_VertexProxy::pyattr_set_g(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetColor(self->m_vertexIndex, 0)[1] = (unsigned char)(val * 255.0f);
-		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -371,7 +371,7 @@ int KX_VertexProxy::pyattr_set_b(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetColor(self->m_vertexIndex, 0)[2] = (unsigned char)(val * 255.0f);
-		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -383,7 +383,7 @@ int KX_VertexProxy::pyattr_set_a(EXP_PyObjectPlus *self_v, const struct EXP_PYAT
 	if (PyFloat_Check(value)) {
 		float val = PyFloat_AsDouble(value);
 		self->m_array->GetColor(self->m_vertexIndex, 0)[3] = (unsigned char)(val * 255.0f);
-		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -395,7 +395,7 @@ int KX_VertexProxy::pyattr_set_XYZ(EXP_PyObjectPlus *self_v, const struct EXP_PY
 	mt::vec3_packed vec;
 	if (PyVecTo(value, vec)) {
 		self->m_array->SetPosition(self->m_vertexIndex, vec);
-		self->m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -407,7 +407,7 @@ int KX_VertexProxy::pyattr_set_UV(EXP_PyObjectPlus *self_v, const struct EXP_PYA
 	mt::vec2_packed vec;
 	if (PyVecTo(value, vec)) {
 		self->m_array->SetUv(self->m_vertexIndex, 0, vec);
-		self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -428,7 +428,7 @@ int KX_VertexProxy::pyattr_set_uvs(EXP_PyObjectPlus *self_v, const struct EXP_PY
 			}
 		}
 
-		self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -440,7 +440,7 @@ int KX_VertexProxy::pyattr_set_color(EXP_PyObjectPlus *self_v, const struct EXP_
 	mt::vec4 vec;
 	if (PyVecTo(value, vec)) {
 		self->m_array->SetColor(self->m_vertexIndex, 0, vec);
-		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -461,7 +461,7 @@ int KX_VertexProxy::pyattr_set_colors(EXP_PyObjectPlus *self_v, const struct EXP
 			}
 		}
 
-		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -473,7 +473,7 @@ int KX_VertexProxy::pyattr_set_normal(EXP_PyObjectPlus *self_v, const struct EXP
 	mt::vec3_packed vec;
 	if (PyVecTo(value, vec)) {
 		self->m_array->SetNormal(self->m_vertexIndex, vec);
-		self->m_array->NotifyUpdate(RAS_DisplayArray::NORMAL_MODIFIED);
+		self->m_array->NotifyUpdate(RAS_DisplayArray::NORMAL_MODIFIED, self->m_vertexIndex, self->m_vertexIndex + 1);
 		return PY_SET_ATTR_SUCCESS;
 	}
 	return PY_SET_ATTR_FAIL;
@@ -519,7 +519,7 @@ PyObject *KX_VertexProxy::PySetXYZ(PyObject *value)
 	}
 
 	m_array->SetPosition(m_vertexIndex, vec);
-	m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED);
+	m_array->NotifyUpdate(RAS_DisplayArray::POSITION_MODIFIED, m_vertexIndex, m_vertexIndex + 1);
 	Py_RETURN_NONE;
 }
 
@@ -536,7 +536,7 @@ PyObject *KX_VertexProxy::PySetNormal(PyObject *value)
 	}
 
 	m_array->SetNormal(m_vertexIndex, vec);
-	m_array->NotifyUpdate(RAS_DisplayArray::NORMAL_MODIFIED);
+	m_array->NotifyUpdate(RAS_DisplayArray::NORMAL_MODIFIED, m_vertexIndex, m_vertexIndex + 1);
 	Py_RETURN_NONE;
 }
 
@@ -551,14 +551,14 @@ PyObject *KX_VertexProxy::PySetRGBA(PyObject *value)
 	if (PyLong_Check(value)) {
 		int rgba = PyLong_AsLong(value);
 		m_array->SetColor(m_vertexIndex, 0, rgba);
-		m_array->NotifyUpdate(true);
+		m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, m_vertexIndex, m_vertexIndex + 1);
 		Py_RETURN_NONE;
 	}
 	else {
 		mt::vec4 vec;
 		if (PyVecTo(value, vec)) {
 			m_array->SetColor(m_vertexIndex, 0, vec);
-			m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED);
+			m_array->NotifyUpdate(RAS_DisplayArray::COLORS_MODIFIED, m_vertexIndex, m_vertexIndex + 1);
 			Py_RETURN_NONE;
 		}
 	}
@@ -580,7 +580,7 @@ PyObject *KX_VertexProxy::PySetUV1(PyObject *value)
 	}
 
 	m_array->SetUv(m_vertexIndex, 0, vec);
-	m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+	m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, m_vertexIndex, m_vertexIndex + 1);
 	Py_RETURN_NONE;
 }
 
@@ -598,7 +598,7 @@ PyObject *KX_VertexProxy::PySetUV2(PyObject *args)
 
 	if (m_array->GetFormat().uvSize > 1) {
 		m_array->SetUv(m_vertexIndex, 1, vec);
-		m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED);
+		m_array->NotifyUpdate(RAS_DisplayArray::UVS_MODIFIED, m_vertexIndex, m_vertexIndex + 1);
 	}
 	Py_RETURN_NONE;
 }
@@ -32,6 +32,7 @@
 #include "LA_SystemCommandLine.h"
 
 #include "RAS_ICanvas.h"
+#include "RAS_NullCanvas.h"
 
 #include "GPG_Canvas.h"
 
@@ -57,10 +58,12 @@
 
 #include "DEV_EventConsumer.h"
 #include "DEV_InputDevice.h"
+#include "DEV_InputRecorder.h"
 
 #include "DEV_Joystick.h"
 
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 
 extern "C" {
 #  include "GPU_extensions.h"
@@ -99,6 +102,7 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system, Main *maggie, Scene *scene, Glob
 	m_ketsjiEngine(nullptr),
 	m_inputDevice(nullptr),
 	m_eventConsumer(nullptr),
+	m_inputRecorder(nullptr),
 	m_canvas(nullptr),
 	m_rasterizer(nullptr),
 	m_converter(nullptr),
@@ -113,6 +117,11 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system, Main *maggie, Scene *scene, Glob
 	m_argv(argv)
 {
 	m_pythonConsole.use = false;
+	m_headless.use = false;
+	m_headless.maxFrames = 0;
+	m_headless.frames = 0;
+	m_headless.reportFrames = 0;
+	m_headless.reportTime = 0.0;
 }
 
 LA_Launcher::~LA_Launcher()
@@ -131,6 +140,12 @@ GlobalSettings *LA_Launcher::GetGlobalSettings()
 	return m_ketsjiEngine->GetGlobalSettings();
 }
 
+void LA_Launcher::SetHeadless(bool headless, unsigned int maxFrames)
+{
+	m_headless.use = headless;
+	m_headless.maxFrames = maxFrames;
+}
+
 void LA_Launcher::InitEngine()
 {
 	// Get and set the preferences.
@@ -154,13 +169,30 @@ void LA_Launcher::InitEngine()
 	bool nodepwarnings = (SYS_GetCommandLineInt(syshandle, "ignore_deprecation_warnings", 1) != 0);
 	bool restrictAnimFPS = (gm.flag & GAME_RESTRICT_ANIM_UPDATES) != 0;
 
+	/* Recorded inputs are meaningful only for the same frames,
+	 * the deterministic mode is then forced when recording or replaying. */
+	const std::string recordInputPath = SYS_GetCommandLineString(syshandle, "record_input", "");
+	const std::string replayInputPath = SYS_GetCommandLineString(syshandle, "replay_input", "");
+	bool deterministic = (SYS_GetCommandLineInt(syshandle, "deterministic", 0) != 0) ||
+	                     !recordInputPath.empty() || !replayInputPath.empty();
+	// Used by the physics environment creation.
+	SYS_WriteCommandLineInt(syshandle, "deterministic", deterministic);
+
+	/* The profile trace is written at the game end, or for each frame
+	 * longer than the threshold if one is specified. */
+	const std::string profileTracePath = SYS_GetCommandLineString(syshandle, "profile_trace", "");
+	const float profileTraceThreshold = SYS_GetCommandLineFloat(syshandle, "profile_trace_threshold", 0.0f);
+	CM_Profiler::SetEnabled(!profileTracePath.empty());
+
 	const KX_KetsjiEngine::FlagType flags = (KX_KetsjiEngine::FlagType)
 	                                        ((fixed_framerate ? KX_KetsjiEngine::FIXED_FRAMERATE : 0) |
 	                                         (frameRate ? KX_KetsjiEngine::SHOW_FRAMERATE : 0) |
 	                                         (renderQueries ? KX_KetsjiEngine::SHOW_RENDER_QUERIES : 0) |
 	                                         (restrictAnimFPS ? KX_KetsjiEngine::RESTRICT_ANIMATION : 0) |
 	                                         (properties ? KX_KetsjiEngine::SHOW_DEBUG_PROPERTIES : 0) |
-	                                         (profile ? KX_KetsjiEngine::SHOW_PROFILE : 0));
+	                                         (profile ? KX_KetsjiEngine::SHOW_PROFILE : 0) |
+	                                         (m_headless.use ? KX_KetsjiEngine::UNTHROTTLED_FRAMERATE : 0) |
+	                                         (deterministic ? KX_KetsjiEngine::DETERMINISTIC : 0));
 
 	// Setup python console keys used as shortcut.
 	for (unsigned short i = 0; i < 4; ++i) {
@@ -170,57 +202,64 @@ void LA_Launcher::InitEngine()
 	}
 	m_pythonConsole.use = (gm.flag & GAME_PYTHON_CONSOLE);
 
-	m_rasterizer = new RAS_Rasterizer();
-
-	// Stereo parameters - Eye Separation from the UI - stereomode from the command-line/UI
-	static const RAS_Rasterizer::ColorManagement colorManagementTable[] = {
-		RAS_Rasterizer::RAS_COLOR_MANAGEMENT_LINEAR, // GAME_COLOR_MANAGEMENT_LINEAR
-		RAS_Rasterizer::RAS_COLOR_MANAGEMENT_SRGB // GAME_COLOR_MANAGEMENT_SRGB
-	};
-	m_rasterizer->SetColorManagment(colorManagementTable[gm.colorManagement]);
-	m_rasterizer->SetStereoMode(m_stereoMode);
-	m_rasterizer->SetEyeSeparation(m_startScene->gm.eyeseparation);
-	m_rasterizer->SetDrawingMode(GetRasterizerDrawMode());
-
-	// Copy current anisotropic level to restore it at the game end.
-	m_savedData.anisotropic = m_rasterizer->GetAnisotropicFiltering();
-	// Copy current mipmap mode to restore at the game end.
-	m_savedData.mipmap = m_rasterizer->GetMipmapping();
-
-	static RAS_Rasterizer::HdrType hdrTable[] = {
-		RAS_Rasterizer::RAS_HDR_NONE, // GAME_HDR_NONE
-		RAS_Rasterizer::RAS_HDR_HALF_FLOAT, // GAME_HDR_HALF_FLOAT
-		RAS_Rasterizer::RAS_HDR_FULL_FLOAT // GAME_HDR_FULL_FLOAT
-	};
-
-	RAS_OffScreen::AttachmentList attachments;
-	attachments.push_back({4, hdrTable[gm.hdr]});
-	for (unsigned short i = 0; i < 7; ++i) {
-		RenderAttachment *attach = gm.attachments[i];
-		if (attach) {
-			attachments.push_back({(unsigned short)attach->size, hdrTable[attach->hdr]});
-		}
+	if (m_headless.use) {
+		/* In headless mode no rasterizer is created, the scenes are converted without materials
+		 * and GPU data and the canvas only keeps the game resolution. */
+		m_canvas = new RAS_NullCanvas(gm.xplay, gm.yplay);
 	}
+	else {
+		m_rasterizer = new RAS_Rasterizer();
+
+		// Stereo parameters - Eye Separation from the UI - stereomode from the command-line/UI
+		static const RAS_Rasterizer::ColorManagement colorManagementTable[] = {
+			RAS_Rasterizer::RAS_COLOR_MANAGEMENT_LINEAR, // GAME_COLOR_MANAGEMENT_LINEAR
+			RAS_Rasterizer::RAS_COLOR_MANAGEMENT_SRGB // GAME_COLOR_MANAGEMENT_SRGB
+		};
+		m_rasterizer->SetColorManagment(colorManagementTable[gm.colorManagement]);
+		m_rasterizer->SetStereoMode(m_stereoMode);
+		m_rasterizer->SetEyeSeparation(m_startScene->gm.eyeseparation);
+		m_rasterizer->SetDrawingMode(GetRasterizerDrawMode());
+
+		// Copy current anisotropic level to restore it at the game end.
+		m_savedData.anisotropic = m_rasterizer->GetAnisotropicFiltering();
+		// Copy current mipmap mode to restore at the game end.
+		m_savedData.mipmap = m_rasterizer->GetMipmapping();
+
+		static RAS_Rasterizer::HdrType hdrTable[] = {
+			RAS_Rasterizer::RAS_HDR_NONE, // GAME_HDR_NONE
+			RAS_Rasterizer::RAS_HDR_HALF_FLOAT, // GAME_HDR_HALF_FLOAT
+			RAS_Rasterizer::RAS_HDR_FULL_FLOAT // GAME_HDR_FULL_FLOAT
+		};
+
+		RAS_OffScreen::AttachmentList attachments;
+		attachments.push_back({4, hdrTable[gm.hdr]});
+		for (unsigned short i = 0; i < 7; ++i) {
+			RenderAttachment *attach = gm.attachments[i];
+			if (attach) {
+				attachments.push_back({(unsigned short)attach->size, hdrTable[attach->hdr]});
+			}
+		}
 
-	// Create the canvas, rasterizer and rendertools.
-	m_canvas = CreateCanvas(m_rasterizer, attachments, m_startScene->gm.aasamples);
+		// Create the canvas, rasterizer and rendertools.
+		m_canvas = CreateCanvas(m_rasterizer, attachments, m_startScene->gm.aasamples);
 
-	static const RAS_ICanvas::SwapControl swapControlTable[] = {
-		RAS_ICanvas::VSYNC_ON, // VSYNC_ON
-		RAS_ICanvas::VSYNC_OFF, // VSYNC_OFF
-		RAS_ICanvas::VSYNC_ADAPTIVE // VSYNC_ADAPTIVE
-	};
+		static const RAS_ICanvas::SwapControl swapControlTable[] = {
+			RAS_ICanvas::VSYNC_ON, // VSYNC_ON
+			RAS_ICanvas::VSYNC_OFF, // VSYNC_OFF
+			RAS_ICanvas::VSYNC_ADAPTIVE // VSYNC_ADAPTIVE
+		};
 
-	m_canvas->SetSwapControl(swapControlTable[gm.vsync]);
+		m_canvas->SetSwapControl(swapControlTable[gm.vsync]);
 
-	m_canvas->SetSamples(m_samples);
+		m_canvas->SetSamples(m_samples);
 
-	m_canvas->Init();
-	if (gm.flag & GAME_SHOW_MOUSE) {
-		m_canvas->SetMouseState(RAS_ICanvas::MOUSE_NORMAL);
-	}
-	else {
-		m_canvas->SetMouseState(RAS_ICanvas::MOUSE_INVISIBLE);
+		m_canvas->Init();
+		if (gm.flag & GAME_SHOW_MOUSE) {
+			m_canvas->SetMouseState(RAS_ICanvas::MOUSE_NORMAL);
+		}
+		else {
+			m_canvas->SetMouseState(RAS_ICanvas::MOUSE_INVISIBLE);
+		}
 	}
 
 	// Create the inputdevices.
@@ -240,6 +279,27 @@ void LA_Launcher::InitEngine()
 	m_ketsjiEngine->SetRasterizer(m_rasterizer);
 	m_ketsjiEngine->SetNetworkMessageManager(m_networkMessageManager);
 
+	if (!replayInputPath.empty()) {
+		m_inputRecorder = new DEV_InputRecorder(DEV_InputRecorder::REPLAY, replayInputPath);
+	}
+	else if (!recordInputPath.empty()) {
+		m_inputRecorder = new DEV_InputRecorder(DEV_InputRecorder::RECORD, recordInputPath);
+	}
+	if (m_inputRecorder && !m_inputRecorder->IsValid()) {
+		delete m_inputRecorder;
+		m_inputRecorder = nullptr;
+	}
+	m_ketsjiEngine->SetInputRecorder(m_inputRecorder);
+
+	if (!profileTracePath.empty()) {
+		if (profileTraceThreshold > 0.0f) {
+			m_ketsjiEngine->SetProfileTraceThreshold(profileTraceThreshold, profileTracePath);
+		}
+		else {
+			m_profileTracePath = profileTracePath;
+		}
+	}
+
 	DEV_Joystick::Init();
 
 	m_ketsjiEngine->SetExitKey(BL_ConvertKeyCode(gm.exitkey));
@@ -250,7 +310,8 @@ void LA_Launcher::InitEngine()
 #endif
 
 	m_ketsjiEngine->SetFlag(flags, true);
-	m_ketsjiEngine->SetRender(true);
+	// In headless mode the logic, physics and animations are proceeded without render.
+	m_ketsjiEngine->SetRender(!m_headless.use);
 	m_ketsjiEngine->SetShowBoundingBox((KX_DebugOption)showBoundingBox);
 	m_ketsjiEngine->SetShowArmatures((KX_DebugOption)showArmatures);
 	m_ketsjiEngine->SetShowCameraFrustum((KX_DebugOption)showCameraFrustum);
@@ -270,6 +331,10 @@ void LA_Launcher::InitEngine()
 	KX_SetMainPath(std::string(m_maggie->name));
 	// Some python things.
 	initGamePython(m_maggie, m_globalDict);
+	// Scripts using the random module get the same numbers for each run.
+	if (deterministic) {
+		PyRun_SimpleString("import random\nrandom.seed(0)");
+	}
 #endif  // WITH_PYTHON
 
 	// Create a scene converter, create and convert the stratingscene.
@@ -295,7 +360,9 @@ void LA_Launcher::InitEngine()
 	m_ketsjiEngine->AddScene(m_kxStartScene);
 	m_kxStartScene->Release();
 
-	m_rasterizer->Init();
+	if (m_rasterizer) {
+		m_rasterizer->Init();
+	}
 	m_ketsjiEngine->StartEngine();
 
 	/* Set the animation playback rate for ipo's and actions the
@@ -304,6 +371,13 @@ void LA_Launcher::InitEngine()
 	 */
 	Scene *scene = m_kxStartScene->GetBlenderScene(); // needed for macro
 	m_ketsjiEngine->SetAnimFrameRate(FPS);
+
+	if (m_headless.use) {
+		m_headless.frames = 0;
+		m_headless.reportFrames = 0;
+		m_headless.reportTime = 0.0;
+		m_headless.clock.Reset();
+	}
 }
 
 
@@ -313,13 +387,26 @@ void LA_Launcher::ExitEngine()
 	Texture::FreeAllTextures(nullptr);
 #endif  // WITH_PYTHON
 
+	if (m_headless.use) {
+		const double time = m_headless.clock.GetTimeSecond();
+		CM_Message("headless: " << m_headless.frames << " frames in " << time << " s, "
+		                        << ((time > 0.0) ? m_headless.frames / time : 0.0) << " fps");
+	}
+
 	DEV_Joystick::Close();
 	m_ketsjiEngine->StopEngine();
 
-	// Set anisotropic settign back to its original value.
-	m_rasterizer->SetAnisotropicFiltering(m_savedData.anisotropic);
-	// Set mipmap setting back to its original value.
-	m_rasterizer->SetMipmapping(m_savedData.mipmap);
+	if (!m_profileTracePath.empty() && CM_Profiler::WriteTrace(m_profileTracePath)) {
+		CM_Message("profile trace written to \"" << m_profileTracePath << "\"");
+	}
+	CM_Profiler::SetEnabled(false);
+
+	if (m_rasterizer) {
+		// Set anisotropic settign back to its original value.
+		m_rasterizer->SetAnisotropicFiltering(m_savedData.anisotropic);
+		// Set mipmap setting back to its original value.
+		m_rasterizer->SetMipmapping(m_savedData.mipmap);
+	}
 
 	if (m_converter) {
 		delete m_converter;
@@ -333,6 +420,12 @@ void LA_Launcher::ExitEngine()
 		delete m_inputDevice;
 		m_inputDevice = nullptr;
 	}
+	if (m_inputRecorder) {
+		CM_Message("input " << ((m_inputRecorder->GetMode() == DEV_InputRecorder::RECORD) ? "recorded" : "replayed")
+		                    << " for " << m_inputRecorder->GetFrames() << " frames");
+		delete m_inputRecorder;
+		m_inputRecorder = nullptr;
+	}
 	if (m_eventConsumer) {
 		m_system->removeEventConsumer(m_eventConsumer);
 		delete m_eventConsumer;
@@ -414,6 +507,27 @@ int LA_Launcher::PythonEngineNextFrame(void *state)
 
 #endif
 
+void LA_Launcher::UpdateHeadless(KX_ExitInfo& exitInfo)
+{
+	++m_headless.frames;
+
+	// Report the frame rate of the last period every few seconds.
+	static const double reportPeriod = 5.0;
+	const double time = m_headless.clock.GetTimeSecond();
+	if ((time - m_headless.reportTime) > reportPeriod) {
+		CM_Message("headless: frame " << m_headless.frames << ", "
+		           << (m_headless.frames - m_headless.reportFrames) / (time - m_headless.reportTime) << " fps");
+		m_headless.reportFrames = m_headless.frames;
+		m_headless.reportTime = time;
+	}
+
+	if (m_headless.maxFrames != 0 && m_headless.frames >= m_headless.maxFrames &&
+	    exitInfo.m_code == KX_ExitInfo::NO_REQUEST)
+	{
+		exitInfo.m_code = KX_ExitInfo::QUIT_GAME;
+	}
+}
+
 void LA_Launcher::RenderEngine()
 {
 	// Render the frame.
@@ -462,6 +576,15 @@ KX_ExitInfo LA_Launcher::EngineNextFrame()
 		}
 	}
 
+	if (m_headless.use) {
+		UpdateHeadless(exitInfo);
+	}
+
+	// The game ends with the replayed inputs.
+	if (m_inputRecorder && m_inputRecorder->IsFinished() && exitInfo.m_code == KX_ExitInfo::NO_REQUEST) {
+		exitInfo.m_code = KX_ExitInfo::QUIT_GAME;
+	}
+
 	m_system->processEvents(false);
 	m_system->dispatchEvents();
 
@@ -33,6 +33,8 @@
 
 #include "SCA_IInputDevice.h"
 
+#include "CM_Clock.h"
+
 #include <string>
 
 class KX_Scene;
@@ -41,6 +43,7 @@ class KX_NetworkMessageManager;
 class RAS_ICanvas;
 class DEV_EventConsumer;
 class DEV_InputDevice;
+class DEV_InputRecorder;
 class GHOST_ISystem;
 struct Scene;
 struct Main;
@@ -64,6 +67,10 @@ protected:
 	/// The game engine's input device abstraction.
 	DEV_InputDevice *m_inputDevice;
 	DEV_EventConsumer *m_eventConsumer;
+	/// Record or replay the inputs in deterministic mode.
+	DEV_InputRecorder *m_inputRecorder;
+	/// Profile trace file written at the game end, empty to not write it.
+	std::string m_profileTracePath;
 	/// The game engine's canvas abstraction.
 	RAS_ICanvas *m_canvas;
 	/// The rasterizer.
@@ -101,10 +108,26 @@ protected:
 		std::vector<SCA_IInputDevice::SCA_EnumInputs> keys;
 	} m_pythonConsole;
 
+	/// Server mode without render proceeding frames as fast as possible.
+	struct Headless {
+		bool use;
+		/// Number of frames to proceed before exiting, 0 for no limit.
+		unsigned int maxFrames;
+		/// Number of frames proceeded.
+		unsigned int frames;
+		/// Number of frames and time of the last frame rate report.
+		unsigned int reportFrames;
+		double reportTime;
+		CM_Clock clock;
+	} m_headless;
+
 #ifdef WITH_PYTHON
 	void HandlePythonConsole();
 #endif  // WITH_PYTHON
 
+	/// Count a headless frame and report the frame rate periodically.
+	void UpdateHeadless(KX_ExitInfo& exitInfo);
+
 	/// Execute engine render, overrided to render background.
 	virtual void RenderEngine();
 
@@ -136,6 +159,11 @@ public:
 
 	GlobalSettings *GetGlobalSettings();
 
+	/** Run the engine without render, one tic per frame as fast as possible
+	 * and exit after maxFrames frames if not zero. Must be called before InitEngine.
+	 */
+	void SetHeadless(bool headless, unsigned int maxFrames);
+
 	inline KX_Scene *GetStartScene() const
 	{
 		return m_kxStartScene;
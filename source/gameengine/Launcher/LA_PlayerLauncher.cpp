@@ -121,7 +121,10 @@ void LA_PlayerLauncher::InitCamera()
 
 void LA_PlayerLauncher::SetWindowOrder(short order)
 {
-	m_mainWindow->setOrder((order == 0) ? GHOST_kWindowOrderBottom : GHOST_kWindowOrderTop);
+	// No window in headless mode.
+	if (m_mainWindow) {
+		m_mainWindow->setOrder((order == 0) ? GHOST_kWindowOrderBottom : GHOST_kWindowOrderTop);
+	}
 }
 
 void LA_PlayerLauncher::InitEngine()
@@ -129,7 +132,9 @@ void LA_PlayerLauncher::InitEngine()
 	BKE_sound_init(m_maggie);
 	LA_Launcher::InitEngine();
 
-	m_rasterizer->PrintHardwareInfo();
+	if (m_rasterizer) {
+		m_rasterizer->PrintHardwareInfo();
+	}
 }
 
 void LA_PlayerLauncher::ExitEngine()
@@ -140,7 +145,7 @@ void LA_PlayerLauncher::ExitEngine()
 
 KX_ExitInfo LA_PlayerLauncher::EngineNextFrame()
 {
-	if (m_inputDevice->GetInput(SCA_IInputDevice::WINRESIZE).Find(SCA_InputEvent::ACTIVE)) {
+	if (m_mainWindow && m_inputDevice->GetInput(SCA_IInputDevice::WINRESIZE).Find(SCA_InputEvent::ACTIVE)) {
 		GHOST_Rect bnds;
 		m_mainWindow->getClientBounds(bnds);
 		m_canvas->Resize(bnds.getWidth(), bnds.getHeight());
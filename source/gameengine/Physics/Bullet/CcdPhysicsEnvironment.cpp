@@ -40,6 +40,7 @@
 
 //profiling/timings
 #include "LinearMath/btQuickprof.h"
+#include "LinearMath/btThreads.h"
 
 
 #include "PHY_IMotionState.h"
@@ -417,7 +418,7 @@ void CcdDebugDraw::draw3dText(const btVector3& location, const char *textString)
 {
 }
 
-CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling)
+CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling, bool deterministic)
 	:m_collisionConfiguration(new btSoftBodyRigidBodyCollisionConfiguration()),
 	m_broadphase(new btDbvtBroadphase()),
 	m_cullingCache(nullptr),
@@ -436,8 +437,10 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 {
 	// Initialize the task scheduler used for bullet parallelization.
 	btITaskScheduler *scheduler = btGetTBBTaskScheduler();
-	const int numThread = scheduler->getMaxNumThreads();
-	if (btGetTaskScheduler() != scheduler) {
+	/* The order of the contacts and constraints proceeded in parallel depends on
+	 * the threads scheduling, a deterministic simulation uses a single thread. */
+	const int numThread = deterministic ? 1 : scheduler->getMaxNumThreads();
+	if (btGetTaskScheduler() != scheduler || scheduler->getNumThreads() != numThread) {
 		scheduler->setNumThreads(numThread);
 		btSetTaskScheduler(scheduler);
 	}
@@ -740,6 +743,24 @@ void CcdPhysicsEnvironment::UpdateCcdPhysicsControllerShape(CcdShapeConstruction
 	}
 }
 
+void CcdPhysicsEnvironment::ApplyGlobalSettings()
+{
+	gDeactivationTime = m_deactivationTime;
+	gContactBreakingThreshold = m_contactBreakingThreshold;
+}
+
+bool CcdPhysicsEnvironment::HasSameGlobalSettings(PHY_IPhysicsEnvironment *other) const
+{
+	CcdPhysicsEnvironment *ccdEnv = dynamic_cast<CcdPhysicsEnvironment *>(other);
+	// Other physics engines don't use the Bullet global variables.
+	if (!ccdEnv) {
+		return true;
+	}
+
+	return (m_deactivationTime == ccdEnv->m_deactivationTime &&
+	        m_contactBreakingThreshold == ccdEnv->m_contactBreakingThreshold);
+}
+
 void CcdPhysicsEnvironment::DebugDrawWorld()
 {
 	m_dynamicsWorld->debugDrawWorld();
@@ -766,10 +787,6 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
 	std::set<CcdPhysicsController *>::iterator it;
 	int i;
 
-	// Update Bullet global variables.
-	gDeactivationTime = m_deactivationTime;
-	gContactBreakingThreshold = m_contactBreakingThreshold;
-
 	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
 		(*it)->SynchronizeMotionStates(timeStep);
 	}
@@ -1099,12 +1116,14 @@ void CcdPhysicsEnvironment::RemoveConstraintById(int constraintId, bool free)
 
 struct  FilterClosestRayResultCallback : public btCollisionWorld::ClosestRayResultCallback {
 	PHY_IRayCastFilterCallback& m_phyRayFilter;
+	PHY_IPhysicsController *m_ignoreController;
 	const btCollisionShape *m_hitTriangleShape;
 	int m_hitTriangleIndex;
 
 	FilterClosestRayResultCallback(PHY_IRayCastFilterCallback& phyRayFilter, const btVector3& rayFrom, const btVector3& rayTo)
 		:btCollisionWorld::ClosestRayResultCallback(rayFrom, rayTo),
 		m_phyRayFilter(phyRayFilter),
+		m_ignoreController(phyRayFilter.m_ignoreController),
 		m_hitTriangleShape(nullptr),
 		m_hitTriangleIndex(0)
 	{
@@ -1124,7 +1143,7 @@ struct  FilterClosestRayResultCallback : public btCollisionWorld::ClosestRayResu
 		}
 		btCollisionObject *object = (btCollisionObject *)proxy0->m_clientObject;
 		CcdPhysicsController *phyCtrl = static_cast<CcdPhysicsController *>(object->getUserPointer());
-		if (phyCtrl == m_phyRayFilter.m_ignoreController) {
+		if (phyCtrl == m_ignoreController) {
 			return false;
 		}
 		return m_phyRayFilter.needBroadphaseRayCast(phyCtrl);
@@ -1146,6 +1165,60 @@ struct  FilterClosestRayResultCallback : public btCollisionWorld::ClosestRayResu
 	}
 };
 
+/// Number of rays tested by a task of CcdPhysicsEnvironment::RayTestBatch.
+static const int rayTestBatchGrainSize = 64;
+
+/// Test a batch of rays in parallel with the Bullet task scheduler.
+class RayTestBatchBody : public btIParallelForBody
+{
+private:
+	btCollisionWorld *m_world;
+	PHY_IRayCastFilterCallback& m_filterCallback;
+	const PHY_RayCastQuery *m_queries;
+	PHY_RayCastResult *m_results;
+
+public:
+	RayTestBatchBody(btCollisionWorld *world, PHY_IRayCastFilterCallback& filterCallback, const PHY_RayCastQuery *queries,
+	                 PHY_RayCastResult *results)
+		:m_world(world),
+		m_filterCallback(filterCallback),
+		m_queries(queries),
+		m_results(results)
+	{
+	}
+
+	virtual void forLoop(int iBegin, int iEnd) const
+	{
+		for (int i = iBegin; i < iEnd; ++i) {
+			const PHY_RayCastQuery& query = m_queries[i];
+			PHY_RayCastResult& result = m_results[i];
+			result = PHY_RayCastResult();
+
+			const btVector3 rayFrom = ToBullet(query.m_from);
+			const btVector3 rayTo = ToBullet(query.m_to);
+			FilterClosestRayResultCallback rayCallback(m_filterCallback, rayFrom, rayTo);
+			rayCallback.m_ignoreController = query.m_ignoreController;
+			// Same settings as CcdPhysicsEnvironment::RayTest.
+			rayCallback.m_collisionFilterMask = CcdConstructionInfo::AllFilter ^ CcdConstructionInfo::SensorFilter;
+			rayCallback.m_flags |= btTriangleRaycastCallback::kF_UseSubSimplexConvexCastRaytest;
+
+			m_world->rayTest(rayFrom, rayTo, rayCallback);
+			if (!rayCallback.hasHit()) {
+				continue;
+			}
+
+			result.m_controller = static_cast<CcdPhysicsController *>(rayCallback.m_collisionObject->getUserPointer());
+			result.m_hitPoint = ToMt(rayCallback.m_hitPointWorld);
+			if (rayCallback.m_hitNormalWorld.length2() > (SIMD_EPSILON * SIMD_EPSILON)) {
+				result.m_hitNormal = ToMt(rayCallback.m_hitNormalWorld.normalized());
+			}
+			else {
+				result.m_hitNormal = mt::axisX3;
+			}
+		}
+	}
+};
+
 static bool GetHitTriangle(btCollisionShape *shape, CcdShapeConstructionInfo *shapeInfo, int hitTriangleIndex, btVector3 triangle[])
 {
 	// this code is copied from Bullet
@@ -1339,6 +1412,13 @@ SKIP_UV_NORMAL:
 	return result.m_controller;
 }
 
+void CcdPhysicsEnvironment::RayTestBatch(PHY_IRayCastFilterCallback &filterCallback, const PHY_RayCastQuery *queries,
+                                         PHY_RayCastResult *results, unsigned int count)
+{
+	// The broadphase uses a ray test stack per thread.
+	btParallelFor(0, count, rayTestBatchGrainSize, RayTestBatchBody(m_dynamicsWorld.get(), filterCallback, queries, results));
+}
+
 // Handles occlusion culling.
 // The implementation is based on the CDTestFramework
 struct OcclusionBuffer {
@@ -2601,7 +2681,7 @@ void CcdPhysicsEnvironment::ExportFile(const std::string& filename)
 	}
 }
 
-CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool visualizePhysics)
+CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool visualizePhysics, bool deterministic)
 {
 	static const PHY_SolverType solverTypeTable[] = {
 		PHY_SOLVER_SEQUENTIAL, // GAME_SOLVER_SEQUENTIAL
@@ -2611,7 +2691,8 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
 	};
 
 	CcdPhysicsEnvironment *ccdPhysEnv = new CcdPhysicsEnvironment(solverTypeTable[blenderscene->gm.solverType],
-	                                                              (blenderscene->gm.mode & WO_DBVT_CULLING) != 0);
+	                                                              (blenderscene->gm.mode & WO_DBVT_CULLING) != 0,
+	                                                              deterministic);
 
 	ccdPhysEnv->SetDeactivationLinearTreshold(blenderscene->gm.lineardeactthreshold);
 	ccdPhysEnv->SetDeactivationAngularTreshold(blenderscene->gm.angulardeactthreshold);
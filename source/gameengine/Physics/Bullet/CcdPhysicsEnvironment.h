@@ -147,7 +147,10 @@ protected:
 	virtual void ExportFile(const std::string& filename);
 
 public:
-	CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling);
+	/** \param deterministic Proceed the simulation in a single thread to get the same
+	 * contacts and constraints order for each run.
+	 */
+	CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling, bool deterministic);
 
 	virtual ~CcdPhysicsEnvironment();
 
@@ -180,6 +183,9 @@ public:
 	}
 	/// Perform an integration step of duration 'timeStep'.
 	virtual bool ProceedDeltaTime(double curTime, float timeStep, float interval);
+	/// Set the Bullet global variables of deactivation time and contact breaking threshold.
+	virtual void ApplyGlobalSettings();
+	virtual bool HasSameGlobalSettings(PHY_IPhysicsEnvironment *other) const;
 
 	/**
 	 * Called by Bullet for every physical simulation (sub)tick.
@@ -229,6 +235,8 @@ public:
 	btTypedConstraint *GetConstraintById(int constraintId);
 
 	virtual PHY_IPhysicsController *RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ);
+	virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback, const PHY_RayCastQuery *queries,
+	                          PHY_RayCastResult *results, unsigned int count);
 	virtual bool CullingTest(PHY_CullingCallback callback, void *userData, const std::array<mt::vec4, 6>& planes,
 							 int occlusionRes, const int *viewport, const mt::mat4& matrix);
 
@@ -295,7 +303,7 @@ public:
 
 	void MergeEnvironment(PHY_IPhysicsEnvironment *other_env);
 
-	static CcdPhysicsEnvironment *Create(struct Scene *blenderscene, bool visualizePhysics);
+	static CcdPhysicsEnvironment *Create(struct Scene *blenderscene, bool visualizePhysics, bool deterministic);
 
 	virtual void ConvertObject(BL_SceneConverter& converter,
 							   KX_GameObject *gameobj,
@@ -74,6 +74,14 @@ struct PHY_RayCastResult {
 	}
 };
 
+/// Ray of a batched ray test.
+struct PHY_RayCastQuery {
+	mt::vec3 m_from;
+	mt::vec3 m_to;
+	/// Controller ignored by this ray, can be null.
+	PHY_IPhysicsController *m_ignoreController;
+};
+
 /**
  * This class replaces the ignoreController parameter of rayTest function.
  * It allows more sophisticated filtering on the physics controller before computing the ray intersection to save CPU.
@@ -118,6 +126,15 @@ public:
 	}
 	/// Perform an integration step of duration 'timeStep'.
 	virtual bool ProceedDeltaTime(double curTime, float timeStep, float interval) = 0;
+	/// Set the settings shared by all the environments of the physics engine, must be called before ProceedDeltaTime.
+	virtual void ApplyGlobalSettings()
+	{
+	}
+	/// Return true if the shared settings of other are the same, the environments can then be proceeded in parallel.
+	virtual bool HasSameGlobalSettings(PHY_IPhysicsEnvironment *other) const
+	{
+		return true;
+	}
 	/// draw debug lines (make sure to call this during the render phase, otherwise lines are not drawn properly)
 	virtual void DebugDrawWorld()
 	{
@@ -210,6 +227,15 @@ public:
 	virtual PHY_ICharacter *GetCharacterController(class KX_GameObject *ob) = 0;
 
 	virtual PHY_IPhysicsController *RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ) = 0;
+	/** Test multiple rays in parallel, each ray returns its closest hit without the polygon and UV informations.
+	 * \param filterCallback The filter of the objects tested by all the rays, needBroadphaseRayCast
+	 * is called from multiple threads and reportHit is not called. The ignored controller is defined per ray.
+	 * \param queries The rays to test.
+	 * \param results The result of each ray, the controller is null when the ray didn't hit.
+	 * \param count The number of rays.
+	 */
+	virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback, const PHY_RayCastQuery *queries,
+	                          PHY_RayCastResult *results, unsigned int count) = 0;
 
 	// culling based on physical broad phase
 	// the plane number must be set as follow: near, far, left, right, top, botton
@@ -96,3 +96,11 @@ PHY_IPhysicsController *DummyPhysicsEnvironment::RayTest(PHY_IRayCastFilterCallb
 	return nullptr;
 }
 
+void DummyPhysicsEnvironment::RayTestBatch(PHY_IRayCastFilterCallback &filterCallback, const PHY_RayCastQuery *queries,
+                                           PHY_RayCastResult *results, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		results[i] = PHY_RayCastResult();
+	}
+}
+
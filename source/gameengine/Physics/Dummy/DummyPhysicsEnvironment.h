@@ -72,6 +72,8 @@ public:
 	}
 
 	virtual PHY_IPhysicsController *RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ);
+	virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback, const PHY_RayCastQuery *queries,
+	                          PHY_RayCastResult *results, unsigned int count);
 	virtual bool CullingTest(PHY_CullingCallback callback, void *userData, const std::array<mt::vec4, 6>& planes,
 							 int occlusionRes, const int *viewport, const mt::mat4& matrix)
 	{
@@ -0,0 +1,333 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file RAS_BoundingVolumeTree.cpp
+ *  \ingroup bgerast
+ */
+
+#include "RAS_BoundingVolumeTree.h"
+
+#include "BLI_utildefines.h"
+
+#include <algorithm>
+#include <cfloat>
+
+static float box_area(const mt::vec3& min, const mt::vec3& max)
+{
+	const mt::vec3 size = max - min;
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+RAS_BoundingVolumeTree::RAS_BoundingVolumeTree(float margin)
+	:m_root(NULL_NODE),
+	m_freeList(NULL_NODE),
+	m_leafCount(0),
+	m_reinsertCount(0),
+	m_margin(margin)
+{
+}
+
+int RAS_BoundingVolumeTree::AllocateNode()
+{
+	int index;
+	if (m_freeList != NULL_NODE) {
+		index = m_freeList;
+		m_freeList = m_nodes[index].m_parent;
+	}
+	else {
+		index = m_nodes.size();
+		m_nodes.emplace_back();
+	}
+
+	Node& node = m_nodes[index];
+	node.m_userData = nullptr;
+	node.m_parent = NULL_NODE;
+	node.m_children[0] = NULL_NODE;
+	node.m_children[1] = NULL_NODE;
+	node.m_height = 0;
+
+	return index;
+}
+
+void RAS_BoundingVolumeTree::FreeNode(int index)
+{
+	Node& node = m_nodes[index];
+	node.m_parent = m_freeList;
+	node.m_height = -1;
+	m_freeList = index;
+}
+
+int RAS_BoundingVolumeTree::Insert(const mt::vec3& min, const mt::vec3& max, void *userData)
+{
+	const int proxy = AllocateNode();
+	Node& node = m_nodes[proxy];
+	const mt::vec3 margin(m_margin);
+	node.m_min = min - margin;
+	node.m_max = max + margin;
+	node.m_userData = userData;
+
+	InsertLeaf(proxy);
+	++m_leafCount;
+
+	return proxy;
+}
+
+void RAS_BoundingVolumeTree::Remove(int proxy)
+{
+	BLI_assert(m_nodes[proxy].IsLeaf() && m_nodes[proxy].m_height == 0);
+
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--m_leafCount;
+}
+
+bool RAS_BoundingVolumeTree::Update(int proxy, const mt::vec3& min, const mt::vec3& max)
+{
+	Node& node = m_nodes[proxy];
+	BLI_assert(node.IsLeaf() && node.m_height == 0);
+
+	// The enlarged box still contains the new box.
+	if (node.m_min.x <= min.x && node.m_min.y <= min.y && node.m_min.z <= min.z &&
+	    node.m_max.x >= max.x && node.m_max.y >= max.y && node.m_max.z >= max.z)
+	{
+		return false;
+	}
+
+	RemoveLeaf(proxy);
+
+	const mt::vec3 margin(m_margin);
+	node.m_min = min - margin;
+	node.m_max = max + margin;
+
+	InsertLeaf(proxy);
+	++m_reinsertCount;
+
+	return true;
+}
+
+void RAS_BoundingVolumeTree::Clear()
+{
+	m_nodes.clear();
+	m_root = NULL_NODE;
+	m_freeList = NULL_NODE;
+	m_leafCount = 0;
+	m_reinsertCount = 0;
+}
+
+void RAS_BoundingVolumeTree::InsertLeaf(int leaf)
+{
+	if (m_root == NULL_NODE) {
+		m_root = leaf;
+		m_nodes[leaf].m_parent = NULL_NODE;
+		return;
+	}
+
+	const mt::vec3 leafMin = m_nodes[leaf].m_min;
+	const mt::vec3 leafMax = m_nodes[leaf].m_max;
+
+	// Find the sibling of the leaf minimizing the surface area of the tree.
+	int index = m_root;
+	while (!m_nodes[index].IsLeaf()) {
+		const Node& node = m_nodes[index];
+
+		const float area = box_area(node.m_min, node.m_max);
+		const float combinedArea = box_area(mt::vec3::Min(node.m_min, leafMin), mt::vec3::Max(node.m_max, leafMax));
+
+		// Cost of creating a new parent for this node and the leaf.
+		const float cost = 2.0f * combinedArea;
+		// Minimum cost of pushing the leaf further down the tree.
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		float childCosts[2];
+		for (unsigned short i = 0; i < 2; ++i) {
+			const Node& child = m_nodes[node.m_children[i]];
+			const float childArea = box_area(mt::vec3::Min(child.m_min, leafMin), mt::vec3::Max(child.m_max, leafMax));
+			childCosts[i] = (child.IsLeaf() ? childArea : childArea - box_area(child.m_min, child.m_max)) + inheritanceCost;
+		}
+
+		if (cost < childCosts[0] && cost < childCosts[1]) {
+			break;
+		}
+
+		index = (childCosts[0] < childCosts[1]) ? node.m_children[0] : node.m_children[1];
+	}
+
+	const int sibling = index;
+	const int oldParent = m_nodes[sibling].m_parent;
+	const int newParent = AllocateNode();
+
+	Node& parentNode = m_nodes[newParent];
+	parentNode.m_parent = oldParent;
+	parentNode.m_min = mt::vec3::Min(m_nodes[sibling].m_min, leafMin);
+	parentNode.m_max = mt::vec3::Max(m_nodes[sibling].m_max, leafMax);
+	parentNode.m_height = m_nodes[sibling].m_height + 1;
+	parentNode.m_children[0] = sibling;
+	parentNode.m_children[1] = leaf;
+
+	if (oldParent != NULL_NODE) {
+		Node& oldParentNode = m_nodes[oldParent];
+		if (oldParentNode.m_children[0] == sibling) {
+			oldParentNode.m_children[0] = newParent;
+		}
+		else {
+			oldParentNode.m_children[1] = newParent;
+		}
+	}
+	else {
+		m_root = newParent;
+	}
+
+	m_nodes[sibling].m_parent = newParent;
+	m_nodes[leaf].m_parent = newParent;
+
+	RefitAncestors(oldParent);
+}
+
+void RAS_BoundingVolumeTree::RemoveLeaf(int leaf)
+{
+	if (leaf == m_root) {
+		m_root = NULL_NODE;
+		return;
+	}
+
+	const int parent = m_nodes[leaf].m_parent;
+	const int grandParent = m_nodes[parent].m_parent;
+	const Node& parentNode = m_nodes[parent];
+	const int sibling = (parentNode.m_children[0] == leaf) ? parentNode.m_children[1] : parentNode.m_children[0];
+
+	if (grandParent != NULL_NODE) {
+		// Replace the parent by the sibling.
+		Node& grandParentNode = m_nodes[grandParent];
+		if (grandParentNode.m_children[0] == parent) {
+			grandParentNode.m_children[0] = sibling;
+		}
+		else {
+			grandParentNode.m_children[1] = sibling;
+		}
+		m_nodes[sibling].m_parent = grandParent;
+		FreeNode(parent);
+
+		RefitAncestors(grandParent);
+	}
+	else {
+		m_root = sibling;
+		m_nodes[sibling].m_parent = NULL_NODE;
+		FreeNode(parent);
+	}
+
+	m_nodes[leaf].m_parent = NULL_NODE;
+}
+
+void RAS_BoundingVolumeTree::RefitAncestors(int index)
+{
+	while (index != NULL_NODE) {
+		Node& node = m_nodes[index];
+		const Node& child0 = m_nodes[node.m_children[0]];
+		const Node& child1 = m_nodes[node.m_children[1]];
+
+		node.m_min = mt::vec3::Min(child0.m_min, child1.m_min);
+		node.m_max = mt::vec3::Max(child0.m_max, child1.m_max);
+		node.m_height = std::max(child0.m_height, child1.m_height) + 1;
+
+		index = node.m_parent;
+	}
+}
+
+int RAS_BoundingVolumeTree::BuildTopDown(int *leaves, unsigned int count)
+{
+	if (count == 1) {
+		return leaves[0];
+	}
+
+	// Split the leaves at the median of their centers along the largest axis.
+	mt::vec3 centerMin(FLT_MAX);
+	mt::vec3 centerMax(-FLT_MAX);
+	for (unsigned int i = 0; i < count; ++i) {
+		const Node& node = m_nodes[leaves[i]];
+		const mt::vec3 center = node.m_min + node.m_max;
+		centerMin = mt::vec3::Min(centerMin, center);
+		centerMax = mt::vec3::Max(centerMax, center);
+	}
+
+	const mt::vec3 size = centerMax - centerMin;
+	const unsigned short axis = (size.x > size.y) ? ((size.x > size.z) ? 0 : 2) : ((size.y > size.z) ? 1 : 2);
+	const unsigned int half = count / 2;
+
+	std::nth_element(leaves, leaves + half, leaves + count, [this, axis](int a, int b) {
+		return (m_nodes[a].m_min[axis] + m_nodes[a].m_max[axis]) < (m_nodes[b].m_min[axis] + m_nodes[b].m_max[axis]);
+	});
+
+	const int child0 = BuildTopDown(leaves, half);
+	const int child1 = BuildTopDown(leaves + half, count - half);
+	const int index = AllocateNode();
+
+	Node& node = m_nodes[index];
+	node.m_children[0] = child0;
+	node.m_children[1] = child1;
+	m_nodes[child0].m_parent = index;
+	m_nodes[child1].m_parent = index;
+	node.m_min = mt::vec3::Min(m_nodes[child0].m_min, m_nodes[child1].m_min);
+	node.m_max = mt::vec3::Max(m_nodes[child0].m_max, m_nodes[child1].m_max);
+	node.m_height = std::max(m_nodes[child0].m_height, m_nodes[child1].m_height) + 1;
+
+	return index;
+}
+
+void RAS_BoundingVolumeTree::Rebuild()
+{
+	m_reinsertCount = 0;
+
+	if (m_root == NULL_NODE) {
+		return;
+	}
+
+	std::vector<int> leaves;
+	leaves.reserve(m_leafCount);
+	for (int i = 0, size = m_nodes.size(); i < size; ++i) {
+		const Node& node = m_nodes[i];
+		if (node.m_height == 0) {
+			leaves.push_back(i);
+		}
+		// Free all the internal nodes.
+		else if (node.m_height > 0) {
+			FreeNode(i);
+		}
+	}
+
+	m_root = BuildTopDown(leaves.data(), leaves.size());
+	m_nodes[m_root].m_parent = NULL_NODE;
+}
+
+void RAS_BoundingVolumeTree::Optimize()
+{
+	if (m_reinsertCount > (m_leafCount / 2)) {
+		Rebuild();
+	}
+}
+
+void *RAS_BoundingVolumeTree::GetUserData(int proxy) const
+{
+	return m_nodes[proxy].m_userData;
+}
+
+unsigned int RAS_BoundingVolumeTree::GetSize() const
+{
+	return m_leafCount;
+}
@@ -0,0 +1,206 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file RAS_BoundingVolumeTree.h
+ *  \ingroup bgerast
+ */
+
+#ifndef __RAS_BOUNDING_VOLUME_TREE_H__
+#define __RAS_BOUNDING_VOLUME_TREE_H__
+
+#include "mathfu.h"
+
+#include <array>
+#include <vector>
+
+/** Dynamic tree of axis aligned bounding boxes used to accelerate frustum culling
+ * and spatial queries independently of the physics engine.
+ * Each leaf stores a box enlarged by a margin, a leaf is reinserted only when its
+ * box leaves the enlarged box. The tree is rebuilt when too many leaves were
+ * reinserted since the last build to keep it balanced.
+ */
+class RAS_BoundingVolumeTree
+{
+public:
+	/// Index of an invalid node or proxy.
+	static const int NULL_NODE = -1;
+
+	/** Construct the tree.
+	 * \param margin The margin added to each side of the leaf boxes.
+	 */
+	RAS_BoundingVolumeTree(float margin);
+	~RAS_BoundingVolumeTree() = default;
+
+	/** Insert a leaf.
+	 * \param userData The user data returned by the queries.
+	 * \return The proxy of the leaf.
+	 */
+	int Insert(const mt::vec3& min, const mt::vec3& max, void *userData);
+	/// Remove a leaf.
+	void Remove(int proxy);
+	/** Refit a leaf to a new box.
+	 * \return True if the leaf was reinserted.
+	 */
+	bool Update(int proxy, const mt::vec3& min, const mt::vec3& max);
+	/// Remove all the leaves.
+	void Clear();
+
+	/// Rebuild the tree top-down from all the leaves.
+	void Rebuild();
+	/// Rebuild the tree if the number of reinserted leaves exceeds half of the leaves.
+	void Optimize();
+
+	void *GetUserData(int proxy) const;
+	unsigned int GetSize() const;
+
+	/** Call a function for the user data of each leaf overlapping a box.
+	 * \param func The function called with the leaf user data.
+	 */
+	template <class Function>
+	void Query(const mt::vec3& min, const mt::vec3& max, Function func) const;
+
+	/** Call a function for the user data of each leaf inside or intersecting a frustum.
+	 * Planes fully containing a sub tree are not tested again for its children.
+	 * \param planes The frustum planes with normals pointing inside.
+	 * \param func The function called with the leaf user data.
+	 */
+	template <class Function>
+	void QueryFrustum(const std::array<mt::vec4, 6>& planes, Function func) const;
+
+private:
+	struct Node
+	{
+		/// Box enlarged by the margin for leaves, union of the children boxes otherwise.
+		mt::vec3 m_min;
+		mt::vec3 m_max;
+		void *m_userData;
+		/// Parent node or next free node when unused.
+		int m_parent;
+		int m_children[2];
+		/// Height of the sub tree, 0 for a leaf and -1 for a free node.
+		int m_height;
+
+		inline bool IsLeaf() const
+		{
+			return (m_children[0] == NULL_NODE);
+		}
+	};
+
+	int AllocateNode();
+	void FreeNode(int index);
+
+	void InsertLeaf(int leaf);
+	void RemoveLeaf(int leaf);
+	/// Refit the boxes and heights from a node to the root.
+	void RefitAncestors(int index);
+	/// Build a sub tree from leaves sorted by position along the largest axis.
+	int BuildTopDown(int *leaves, unsigned int count);
+
+	std::vector<Node, mt::simd_allocator<Node> > m_nodes;
+	int m_root;
+	int m_freeList;
+	unsigned int m_leafCount;
+	/// Number of leaves reinserted since the last build.
+	unsigned int m_reinsertCount;
+	float m_margin;
+};
+
+template <class Function>
+void RAS_BoundingVolumeTree::Query(const mt::vec3& min, const mt::vec3& max, Function func) const
+{
+	if (m_root == NULL_NODE) {
+		return;
+	}
+
+	std::vector<int> stack = {m_root};
+	while (!stack.empty()) {
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (node.m_min.x > max.x || node.m_min.y > max.y || node.m_min.z > max.z ||
+		    node.m_max.x < min.x || node.m_max.y < min.y || node.m_max.z < min.z)
+		{
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			func(node.m_userData);
+		}
+		else {
+			stack.push_back(node.m_children[0]);
+			stack.push_back(node.m_children[1]);
+		}
+	}
+}
+
+template <class Function>
+void RAS_BoundingVolumeTree::QueryFrustum(const std::array<mt::vec4, 6>& planes, Function func) const
+{
+	if (m_root == NULL_NODE) {
+		return;
+	}
+
+	// Pairs of node and mask of the planes to test.
+	std::vector<std::pair<int, unsigned short> > stack = {{m_root, (1 << 6) - 1}};
+	while (!stack.empty()) {
+		const std::pair<int, unsigned short> entry = stack.back();
+		stack.pop_back();
+
+		const Node& node = m_nodes[entry.first];
+		unsigned short mask = entry.second;
+
+		const mt::vec3 center = (node.m_min + node.m_max) * 0.5f;
+		const mt::vec3 extent = (node.m_max - node.m_min) * 0.5f;
+
+		bool outside = false;
+		for (unsigned short i = 0; i < 6; ++i) {
+			if (!(mask & (1 << i))) {
+				continue;
+			}
+
+			const mt::vec4& plane = planes[i];
+			const float dist = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			const float radius = fabs(plane.x) * extent.x + fabs(plane.y) * extent.y + fabs(plane.z) * extent.z;
+
+			if ((dist + radius) < 0.0f) {
+				outside = true;
+				break;
+			}
+			// Fully inside this plane, the children don't need to test it.
+			if ((dist - radius) >= 0.0f) {
+				mask &= ~(1 << i);
+			}
+		}
+
+		if (outside) {
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			func(node.m_userData);
+		}
+		else {
+			stack.emplace_back(node.m_children[0], mask);
+			stack.emplace_back(node.m_children[1], mask);
+		}
+	}
+}
+
+#endif  // __RAS_BOUNDING_VOLUME_TREE_H__
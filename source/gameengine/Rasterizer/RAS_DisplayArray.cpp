@@ -31,6 +31,7 @@
 #include "GPU_glew.h"
 
 #include <algorithm>
+#include <climits>
 
 struct PolygonSort {
 	/// Distance from polygon center to camera near plane.
@@ -118,6 +119,36 @@ void RAS_DisplayArray::Clear()
 	m_maxOrigIndex = 0;
 }
 
+void RAS_DisplayArray::CopyData(const RAS_DisplayArray& other)
+{
+	BLI_assert(m_type == other.m_type && m_format == other.m_format);
+
+	m_vertexData = other.m_vertexData;
+	m_vertexInfos = other.m_vertexInfos;
+	m_primitiveIndices = other.m_primitiveIndices;
+	m_triangleIndices = other.m_triangleIndices;
+	m_maxOrigIndex = other.m_maxOrigIndex;
+	m_polygonCenters.clear();
+}
+
+void RAS_DisplayArray::NotifyUpdate(unsigned int flag)
+{
+	NotifyUpdate(flag, 0, UINT_MAX);
+}
+
+void RAS_DisplayArray::NotifyUpdate(unsigned int flag, unsigned int begin, unsigned int end)
+{
+	for (unsigned short i = 0; i < STREAM_COUNT; ++i) {
+		if (flag & (1 << i)) {
+			ModifiedRange& range = m_modifiedRanges[i];
+			range.begin = std::min(range.begin, begin);
+			range.end = std::max(range.end, end);
+		}
+	}
+
+	CM_UpdateServer<RAS_DisplayArray>::NotifyUpdate(flag);
+}
+
 void RAS_DisplayArray::SortPolygons(const mt::mat3x4& transform, unsigned int *indexmap)
 {
 	const unsigned int totpoly = GetPrimitiveIndexCount() / 3;
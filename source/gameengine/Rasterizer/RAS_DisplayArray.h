@@ -38,8 +38,10 @@
 #include "mathfu.h"
 
 #include <vector>
+#include <array>
 #include <algorithm>
 #include <memory>
+#include <climits>
 
 class RAS_BatchDisplayArray;
 class RAS_StorageVbo;
@@ -76,6 +78,9 @@ public:
 		ANY_MODIFIED = MESH_MODIFIED | SIZE_MODIFIED | STORAGE_INVALID
 	};
 
+	/// Number of vertex data streams, one per bit of MESH_MODIFIED.
+	static const unsigned short STREAM_COUNT = 5;
+
 	/// Struct used to pass the vertex format to functions.
 	struct Format
 	{
@@ -136,6 +141,17 @@ protected:
 	/// The OpenGL data storage used for rendering.
 	RAS_DisplayArrayStorage m_storage;
 
+	/** Range of vertices modified since the last storage update, empty when the first
+	 * vertex is after the last vertex.
+	 */
+	struct ModifiedRange {
+		unsigned int begin = UINT_MAX;
+		unsigned int end = 0;
+	};
+
+	/// Modified range of each vertex data stream, indexed by the bit of the stream modified flag.
+	std::array<ModifiedRange, STREAM_COUNT> m_modifiedRanges;
+
 public:
 	RAS_DisplayArray(PrimitiveType type, const Format& format);
 	RAS_DisplayArray(const RAS_DisplayArray& other);
@@ -266,6 +282,19 @@ public:
 
 	void Clear();
 
+	/** Replace the vertices and indices by the ones of an other display array
+	 * of the same primitive type and format.
+	 */
+	void CopyData(const RAS_DisplayArray& other);
+
+	/// Notify a modification of all the vertices.
+	void NotifyUpdate(unsigned int flag);
+	/** Notify a modification of a range of vertices, only the modified ranges are copied to the storage.
+	 * \param begin The first modified vertex.
+	 * \param end The vertex following the last modified vertex.
+	 */
+	void NotifyUpdate(unsigned int flag, unsigned int begin, unsigned int end);
+
 	inline unsigned int GetVertexCount() const
 	{
 		return m_vertexData.positions.size();
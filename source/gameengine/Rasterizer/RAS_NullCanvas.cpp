@@ -0,0 +1,127 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Rasterizer/RAS_NullCanvas.cpp
+ *  \ingroup bgerast
+ */
+
+#include "RAS_NullCanvas.h"
+#include "RAS_OffScreen.h"
+
+#include "CM_Message.h"
+
+#include "BLI_utildefines.h"
+
+RAS_NullCanvas::RAS_NullCanvas(int width, int height)
+	:RAS_ICanvas(RAS_OffScreen::AttachmentList(), 0)
+{
+	m_mousestate = MOUSE_INVISIBLE;
+	Resize(width, height);
+	SetViewPort(0, 0, width, height);
+}
+
+RAS_NullCanvas::~RAS_NullCanvas()
+{
+}
+
+void RAS_NullCanvas::Init()
+{
+}
+
+void RAS_NullCanvas::BeginFrame()
+{
+}
+
+void RAS_NullCanvas::EndFrame()
+{
+}
+
+void RAS_NullCanvas::BeginDraw()
+{
+}
+
+void RAS_NullCanvas::EndDraw()
+{
+}
+
+void RAS_NullCanvas::SwapBuffers()
+{
+}
+
+void RAS_NullCanvas::ConvertMousePosition(int x, int y, int &r_x, int &r_y, bool UNUSED(screen))
+{
+	r_x = x;
+	r_y = y;
+}
+
+void RAS_NullCanvas::SetViewPort(int x, int y, int width, int height)
+{
+	m_viewport[0] = x;
+	m_viewport[1] = y;
+	m_viewport[2] = width;
+	m_viewport[3] = height;
+}
+
+void RAS_NullCanvas::UpdateViewPort(int x, int y, int width, int height)
+{
+	SetViewPort(x, y, width, height);
+}
+
+void RAS_NullCanvas::SetMouseState(RAS_MouseState mousestate)
+{
+	m_mousestate = mousestate;
+}
+
+void RAS_NullCanvas::SetMousePosition(int UNUSED(x), int UNUSED(y))
+{
+}
+
+void RAS_NullCanvas::MakeScreenShot(const std::string& filename)
+{
+	CM_Warning("no render, screenshot \"" << filename << "\" skipped");
+}
+
+void RAS_NullCanvas::GetDisplayDimensions(int &width, int &height)
+{
+	width = GetWidth();
+	height = GetHeight();
+}
+
+void RAS_NullCanvas::ResizeWindow(int width, int height)
+{
+	Resize(width, height);
+}
+
+void RAS_NullCanvas::Resize(int width, int height)
+{
+	m_area.SetLeft(0);
+	m_area.SetBottom(0);
+	m_area.SetRight(width - 1);
+	m_area.SetTop(height - 1);
+}
+
+void RAS_NullCanvas::SetFullScreen(bool UNUSED(enable))
+{
+}
+
+bool RAS_NullCanvas::GetFullScreen()
+{
+	return false;
+}
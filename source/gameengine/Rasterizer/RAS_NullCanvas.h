@@ -0,0 +1,66 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file RAS_NullCanvas.h
+ *  \ingroup bgerast
+ */
+
+#ifndef __RAS_NULLCANVAS_H__
+#define __RAS_NULLCANVAS_H__
+
+#include "RAS_ICanvas.h"
+
+/** Canvas without window nor OpenGL context, used when the game runs without render.
+ * It only keeps a fixed area for the cameras projection and the mouse coordinates.
+ */
+class RAS_NullCanvas : public RAS_ICanvas
+{
+public:
+	RAS_NullCanvas(int width, int height);
+	virtual ~RAS_NullCanvas();
+
+	virtual void Init();
+
+	virtual void BeginFrame();
+	virtual void EndFrame();
+	virtual void BeginDraw();
+	virtual void EndDraw();
+	virtual void SwapBuffers();
+
+	virtual void ConvertMousePosition(int x, int y, int &r_x, int &r_y, bool screen);
+
+	virtual void SetViewPort(int x, int y, int width, int height);
+	virtual void UpdateViewPort(int x, int y, int width, int height);
+
+	virtual void SetMouseState(RAS_MouseState mousestate);
+	virtual void SetMousePosition(int x, int y);
+
+	virtual void MakeScreenShot(const std::string& filename);
+
+	virtual void GetDisplayDimensions(int &width, int &height);
+
+	virtual void ResizeWindow(int width, int height);
+	virtual void Resize(int width, int height);
+
+	virtual void SetFullScreen(bool enable);
+	virtual bool GetFullScreen();
+};
+
+#endif  // __RAS_NULLCANVAS_H__
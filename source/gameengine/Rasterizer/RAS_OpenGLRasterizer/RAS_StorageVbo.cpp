@@ -28,6 +28,9 @@
 #include "RAS_StorageVbo.h"
 #include "RAS_DisplayArray.h"
 
+#include <algorithm>
+#include <climits>
+
 RAS_StorageVbo::RAS_StorageVbo(RAS_DisplayArray *array)
 	:m_array(array),
 	m_indices(0),
@@ -64,45 +67,68 @@ void RAS_StorageVbo::UnbindIndexBuffer()
 }
 
 template <class Item>
-static void copySubData(intptr_t offset, const std::vector<Item>& data)
+static void copySubData(intptr_t offset, const std::vector<Item>& data, unsigned int begin, unsigned int end)
 {
-	const unsigned int size = sizeof(Item) * data.size();
-	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data.data());
+	const unsigned int size = sizeof(Item) * (end - begin);
+	glBufferSubData(GL_ARRAY_BUFFER, offset + sizeof(Item) * begin, size, data.data() + begin);
 }
 
-void RAS_StorageVbo::CopyVertexData(const RAS_DisplayArrayLayout& layout, unsigned int modifiedFlag)
+void RAS_StorageVbo::CopyVertexData(const RAS_DisplayArrayLayout& layout, unsigned int modifiedFlag,
+		unsigned int begin, unsigned int end)
 {
 	const RAS_DisplayArray::Format& format = m_array->GetFormat();
 	const RAS_DisplayArray::VertexData& data = m_array->m_vertexData;
 
 	if (modifiedFlag & RAS_DisplayArray::POSITION_MODIFIED) {
-		copySubData(layout.position, data.positions);
+		copySubData(layout.position, data.positions, begin, end);
 	}
 	if (modifiedFlag & RAS_DisplayArray::NORMAL_MODIFIED) {
-		copySubData(layout.normal, data.normals);
+		copySubData(layout.normal, data.normals, begin, end);
 	}
 	if (modifiedFlag & RAS_DisplayArray::TANGENT_MODIFIED) {
-		copySubData(layout.tangent, data.tangents);
+		copySubData(layout.tangent, data.tangents, begin, end);
 	}
 
 	if (modifiedFlag & RAS_DisplayArray::UVS_MODIFIED) {
 		for (unsigned short i = 0; i < format.uvSize; ++i) {
-			copySubData(layout.uvs[i], data.uvs[i]);
+			copySubData(layout.uvs[i], data.uvs[i], begin, end);
 		}
 	}
 
 	if (modifiedFlag & RAS_DisplayArray::COLORS_MODIFIED) {
 		for (unsigned short i = 0; i < format.colorSize; ++i) {
-			copySubData(layout.colors[i], data.colors[i]);
+			copySubData(layout.colors[i], data.colors[i], begin, end);
 		}
 	}
 }
 
 void RAS_StorageVbo::UpdateVertexData(unsigned int modifiedFlag)
 {
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	CopyVertexData(m_array->GetLayout(), modifiedFlag);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	const RAS_DisplayArrayLayout layout = m_array->GetLayout();
+	bool bound = false;
+
+	// Copy only the vertices modified since the last update, per stream.
+	for (unsigned short i = 0; i < RAS_DisplayArray::STREAM_COUNT; ++i) {
+		RAS_DisplayArray::ModifiedRange& range = m_array->m_modifiedRanges[i];
+		const unsigned int begin = range.begin;
+		const unsigned int end = std::min(range.end, m_array->GetVertexCount());
+		range = RAS_DisplayArray::ModifiedRange();
+
+		const unsigned int flag = (1 << i);
+		if (!(modifiedFlag & flag) || begin >= end) {
+			continue;
+		}
+
+		if (!bound) {
+			glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+			bound = true;
+		}
+		CopyVertexData(layout, flag, begin, end);
+	}
+
+	if (bound) {
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
 }
 
 void RAS_StorageVbo::UpdateSize()
@@ -112,7 +138,8 @@ void RAS_StorageVbo::UpdateSize()
 	const RAS_DisplayArrayLayout layout = m_array->GetLayout();
 	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
 	glBufferData(GL_ARRAY_BUFFER, layout.size, nullptr, GL_DYNAMIC_DRAW);
-	CopyVertexData(layout, RAS_DisplayArray::MESH_MODIFIED);
+	CopyVertexData(layout, RAS_DisplayArray::MESH_MODIFIED, 0, m_array->GetVertexCount());
+	m_array->m_modifiedRanges.fill(RAS_DisplayArray::ModifiedRange());
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
@@ -36,7 +36,11 @@ private:
 	GLuint m_ibo;
 	GLuint m_vbo;
 
-	void CopyVertexData(const RAS_DisplayArrayLayout& layout, unsigned int modifiedFlag);
+	/** Copy the modified vertex data streams of a range of vertices.
+	 * \param begin The first vertex to copy.
+	 * \param end The vertex following the last vertex to copy.
+	 */
+	void CopyVertexData(const RAS_DisplayArrayLayout& layout, unsigned int modifiedFlag, unsigned int begin, unsigned int end);
 
 public:
 	RAS_StorageVbo(RAS_DisplayArray *array);
@@ -0,0 +1,187 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/SceneGraph/SG_CullingBatch.cpp
+ *  \ingroup bgesg
+ */
+
+#include "SG_CullingBatch.h"
+#include "SG_Frustum.h"
+
+#include "vectorial/simd4f.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+SG_CullingBatch::SG_CullingBatch()
+	:m_size(0)
+{
+}
+
+void SG_CullingBatch::Clear()
+{
+	for (std::vector<float>& component : m_components) {
+		component.clear();
+	}
+	m_transforms.clear();
+	m_aabbs.clear();
+	m_size = 0;
+}
+
+void SG_CullingBatch::Add(const mt::mat3x4& trans, const mt::vec3& scale, const SG_BBox& aabb)
+{
+	// Pad the components to a multiple of the lane count, padding entries are ignored.
+	if ((m_size % LANE_COUNT) == 0) {
+		for (std::vector<float>& component : m_components) {
+			component.resize(m_size + LANE_COUNT, 0.0f);
+		}
+	}
+
+	const float maxscale = std::max(std::max(fabs(scale.x), fabs(scale.y)), fabs(scale.z));
+	const mt::vec3 center = trans * aabb.GetCenter();
+	const mt::vec3 halfExtents = (aabb.GetMax() - aabb.GetMin()) * 0.5f;
+
+	m_components[CENTER_X][m_size] = center.x;
+	m_components[CENTER_Y][m_size] = center.y;
+	m_components[CENTER_Z][m_size] = center.z;
+	m_components[RADIUS][m_size] = maxscale * aabb.GetRadius();
+
+	// The world axes of the box, the transform columns include the scale.
+	for (unsigned short axis = 0; axis < 3; ++axis) {
+		for (unsigned short i = 0; i < 3; ++i) {
+			m_components[AXIS_0_X + axis * 3 + i][m_size] = trans(i, axis) * halfExtents[axis];
+		}
+	}
+
+	m_transforms.push_back(trans);
+	m_aabbs.push_back(aabb);
+
+	++m_size;
+}
+
+unsigned int SG_CullingBatch::GetSize() const
+{
+	return m_size;
+}
+
+bool SG_CullingBatch::TestIntersect(const SG_Frustum& frustum, unsigned int index) const
+{
+	const SG_BBox& aabb = m_aabbs[index];
+	const mt::mat4 mat = mt::mat4::FromAffineTransform(m_transforms[index]);
+	return (frustum.AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) == SG_Frustum::OUTSIDE);
+}
+
+static inline simd4f simd4f_abs(simd4f v)
+{
+	return simd4f_max(v, simd4f_sub(simd4f_zero(), v));
+}
+
+static inline simd4f simd4f_dot_axis(simd4f nx, simd4f ny, simd4f nz, simd4f x, simd4f y, simd4f z)
+{
+	return simd4f_abs(simd4f_madd(x, nx, simd4f_madd(y, ny, simd4f_mul(z, nz))));
+}
+
+void SG_CullingBatch::Test(const SG_Frustum& frustum, VisibilityMask& mask) const
+{
+	mask.assign((m_size + MASK_BITS - 1) / MASK_BITS, 0);
+
+	const std::array<mt::vec4, 6>& planes = frustum.GetPlanes();
+	const simd4f max = simd4f_splat(FLT_MAX);
+
+	for (unsigned int i = 0; i < m_size; i += LANE_COUNT) {
+		const simd4f cx = simd4f_uload4(&m_components[CENTER_X][i]);
+		const simd4f cy = simd4f_uload4(&m_components[CENTER_Y][i]);
+		const simd4f cz = simd4f_uload4(&m_components[CENTER_Z][i]);
+		const simd4f radius = simd4f_uload4(&m_components[RADIUS][i]);
+		const simd4f a0x = simd4f_uload4(&m_components[AXIS_0_X][i]);
+		const simd4f a0y = simd4f_uload4(&m_components[AXIS_0_Y][i]);
+		const simd4f a0z = simd4f_uload4(&m_components[AXIS_0_Z][i]);
+		const simd4f a1x = simd4f_uload4(&m_components[AXIS_1_X][i]);
+		const simd4f a1y = simd4f_uload4(&m_components[AXIS_1_Y][i]);
+		const simd4f a1z = simd4f_uload4(&m_components[AXIS_1_Z][i]);
+		const simd4f a2x = simd4f_uload4(&m_components[AXIS_2_X][i]);
+		const simd4f a2y = simd4f_uload4(&m_components[AXIS_2_Y][i]);
+		const simd4f a2z = simd4f_uload4(&m_components[AXIS_2_Z][i]);
+
+		/* Minimum over the planes of the signed distance of the furthest and nearest
+		 * points of the sphere and the box, a negative furthest distance means outside
+		 * and a positive nearest distance means inside. */
+		simd4f sphereFar = max;
+		simd4f sphereNear = max;
+		simd4f boxFar = max;
+		simd4f boxNear = max;
+
+		for (const mt::vec4& plane : planes) {
+			const simd4f nx = simd4f_splat(plane.x);
+			const simd4f ny = simd4f_splat(plane.y);
+			const simd4f nz = simd4f_splat(plane.z);
+			const simd4f nw = simd4f_splat(plane.w);
+
+			const simd4f dist = simd4f_madd(cx, nx, simd4f_madd(cy, ny, simd4f_madd(cz, nz, nw)));
+			const simd4f extent = simd4f_add(simd4f_dot_axis(nx, ny, nz, a0x, a0y, a0z),
+					simd4f_add(simd4f_dot_axis(nx, ny, nz, a1x, a1y, a1z), simd4f_dot_axis(nx, ny, nz, a2x, a2y, a2z)));
+
+			sphereFar = simd4f_min(sphereFar, simd4f_add(dist, radius));
+			sphereNear = simd4f_min(sphereNear, simd4f_sub(dist, radius));
+			boxFar = simd4f_min(boxFar, simd4f_add(dist, extent));
+			boxNear = simd4f_min(boxNear, simd4f_sub(dist, extent));
+		}
+
+		float sphereFarLanes[LANE_COUNT];
+		float sphereNearLanes[LANE_COUNT];
+		float boxFarLanes[LANE_COUNT];
+		float boxNearLanes[LANE_COUNT];
+		simd4f_ustore4(sphereFar, sphereFarLanes);
+		simd4f_ustore4(sphereNear, sphereNearLanes);
+		simd4f_ustore4(boxFar, boxFarLanes);
+		simd4f_ustore4(boxNear, boxNearLanes);
+
+		const unsigned int lanes = std::min(LANE_COUNT, m_size - i);
+		for (unsigned int lane = 0; lane < lanes; ++lane) {
+			bool culled;
+			// Sphere fully outside of one plane.
+			if (sphereFarLanes[lane] < 0.0f) {
+				culled = true;
+			}
+			// Sphere fully inside all planes.
+			else if (sphereNearLanes[lane] > 0.0f) {
+				culled = false;
+			}
+			// Box fully outside of one plane.
+			else if (boxFarLanes[lane] < 0.0f) {
+				culled = true;
+			}
+			// Box fully inside all planes.
+			else if (boxNearLanes[lane] >= 0.0f) {
+				culled = false;
+			}
+			// Box intersecting, it could be outside the frustum while intersecting two planes.
+			else {
+				culled = TestIntersect(frustum, i + lane);
+			}
+
+			if (!culled) {
+				const unsigned int index = i + lane;
+				mask[index / MASK_BITS] |= (1u << (index % MASK_BITS));
+			}
+		}
+	}
+}
@@ -0,0 +1,110 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SG_CullingBatch.h
+ *  \ingroup bgesg
+ */
+
+#ifndef __SG_CULLING_BATCH_H__
+#define __SG_CULLING_BATCH_H__
+
+#include "SG_BBox.h"
+
+#include <vector>
+
+class SG_Frustum;
+
+/** Packed bounding volumes of a set of objects tested four by four against frustums.
+ * The world bounding sphere and oriented box of each entry are stored in structure of
+ * arrays and padded to a multiple of four. The same batch can be tested against several
+ * frustums, each test returns a visibility bit mask where each bit is an entry.
+ */
+class SG_CullingBatch
+{
+public:
+	typedef std::vector<unsigned int> VisibilityMask;
+
+	/// Number of entries tested by one kernel iteration.
+	static const unsigned int LANE_COUNT = 4;
+	/// Number of entries per visibility mask word.
+	static const unsigned int MASK_BITS = sizeof(VisibilityMask::value_type) * 8;
+
+	SG_CullingBatch();
+	~SG_CullingBatch() = default;
+
+	/// Remove all the entries.
+	void Clear();
+
+	/** Add an entry.
+	 * \param trans The object world transform.
+	 * \param scale The object world scale.
+	 * \param aabb The object local bounding box.
+	 */
+	void Add(const mt::mat3x4& trans, const mt::vec3& scale, const SG_BBox& aabb);
+
+	unsigned int GetSize() const;
+
+	/** Test all the entries against a frustum.
+	 * \param mask The visibility mask, an entry is visible when its bit is set.
+	 */
+	void Test(const SG_Frustum& frustum, VisibilityMask& mask) const;
+
+	/// Return true if an entry is set visible in a visibility mask.
+	static inline bool IsVisible(const VisibilityMask& mask, unsigned int index)
+	{
+		return (mask[index / MASK_BITS] & (1u << (index % MASK_BITS)));
+	}
+
+private:
+	enum Component {
+		CENTER_X = 0,
+		CENTER_Y,
+		CENTER_Z,
+		RADIUS,
+		AXIS_0_X,
+		AXIS_0_Y,
+		AXIS_0_Z,
+		AXIS_1_X,
+		AXIS_1_Y,
+		AXIS_1_Z,
+		AXIS_2_X,
+		AXIS_2_Y,
+		AXIS_2_Z,
+		COMPONENT_MAX
+	};
+
+	/** Exact test of an entry of which the oriented box is intersecting a frustum plane.
+	 * \return True if the entry is culled.
+	 */
+	bool TestIntersect(const SG_Frustum& frustum, unsigned int index) const;
+
+	/** World center, world radius and world box axes scaled by half extents,
+	 * one array per component.
+	 */
+	std::vector<float> m_components[COMPONENT_MAX];
+
+	/// Entries data used by the exact test.
+	std::vector<mt::mat3x4, mt::simd_allocator<mt::mat3x4> > m_transforms;
+	std::vector<SG_BBox, mt::simd_allocator<SG_BBox> > m_aabbs;
+
+	unsigned int m_size;
+};
+
+#endif  // __SG_CULLING_BATCH_H__
@@ -27,6 +27,7 @@
 #include "SG_Scene.h"
 #include "SG_Familly.h"
 #include "SG_Controller.h"
+#include "SG_TransformStore.h"
 
 #include "CM_List.h"
 
@@ -50,12 +51,14 @@ SG_Node::SG_Node(SG_Object *object, SG_Scene *scene, SG_Callbacks& callbacks, SG
 	m_parent_relation(relation),
 	m_familly(new SG_Familly()),
 	m_modified(true),
-	m_dirty(DIRTY_NONE)
+	m_dirty(DIRTY_NONE),
+	m_transformIndex(SG_TransformStore::INVALID_INDEX)
 {
 	BLI_assert(m_scene);
 	BLI_assert((m_object != nullptr) == (m_callbacks.m_updatefunc != nullptr));
 
 	m_scene->AddRootNode(this);
+	m_scene->RegisterTransform(this);
 }
 
 SG_Node::SG_Node(const SG_Node& other)
@@ -72,8 +75,10 @@ SG_Node::SG_Node(const SG_Node& other)
 	m_worldScaling(other.m_worldScaling),
 	m_parent_relation(other.m_parent_relation ? other.m_parent_relation->NewCopy() : nullptr),
 	m_familly(new SG_Familly()),
-	m_dirty(DIRTY_NONE)
+	m_dirty(DIRTY_NONE),
+	m_transformIndex(SG_TransformStore::INVALID_INDEX)
 {
+	m_scene->RegisterTransform(this);
 }
 
 SG_Node::~SG_Node()
@@ -92,6 +97,8 @@ SG_Node::~SG_Node()
 	if (!m_parent) {
 		m_scene->RemoveRootNode(this);
 	}
+
+	m_scene->UnregisterTransform(this);
 }
 
 SG_Node *SG_Node::GetReplica()
@@ -330,7 +337,10 @@ void SG_Node::SetScene(SG_Scene *scene)
 
 void SG_Node::ReplaceScene(SG_Scene* scene)
 {
+	m_scene->UnregisterTransform(this);
 	m_scene = scene;
+	m_scene->RegisterTransform(this);
+
 	for (SG_Node *child : m_children) {
 		child->ReplaceScene(scene);
 	}
@@ -339,7 +349,7 @@ void SG_Node::ReplaceScene(SG_Scene* scene)
 void SG_Node::ClearModified()
 {
 	m_modified = false;
-	m_dirty = DIRTY_ALL;
+	m_dirty |= DIRTY_RENDER;
 }
 
 void SG_Node::SetModified()
@@ -358,6 +368,11 @@ void SG_Node::SetModified()
 	}
 }
 
+void SG_Node::SetDirty(DirtyFlag flag)
+{
+	m_dirty |= flag;
+}
+
 void SG_Node::ClearDirty(DirtyFlag flag)
 {
 	m_dirty &= ~flag;
@@ -382,6 +397,11 @@ void SG_Node::UpdateSpatialData(const SG_Node *parent, bool& parentUpdated)
 {
 	// Ask the parent_relation object owned by this class to update our world coordinates.
 	ComputeWorldTransforms(parent, parentUpdated);
+
+	// Mirror the world position in the scene transform store.
+	if (m_transformIndex != SG_TransformStore::INVALID_INDEX) {
+		m_scene->GetTransformStore()->Update(m_transformIndex, m_worldPosition);
+	}
 }
 
 /**
@@ -543,6 +563,16 @@ bool SG_Node::IsDirty(DirtyFlag flag)
 	return (m_dirty & flag);
 }
 
+unsigned int SG_Node::GetTransformIndex() const
+{
+	return m_transformIndex;
+}
+
+void SG_Node::SetTransformIndex(unsigned int index)
+{
+	m_transformIndex = index;
+}
+
 void SG_Node::ActivateUpdateTransformCallback()
 {
 	if (m_callbacks.m_updatefunc) {
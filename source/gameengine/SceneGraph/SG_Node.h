@@ -83,6 +83,7 @@ public:
 		DIRTY_NONE = 0,
 		DIRTY_ALL = 0xFF,
 		DIRTY_RENDER = (1 << 0),
+		/// Set while the object is scheduled for the scene bounding volume tree update.
 		DIRTY_CULLING = (1 << 1)
 	};
 
@@ -193,6 +194,7 @@ public:
 
 	void ClearModified();
 	void SetModified();
+	void SetDirty(DirtyFlag flag);
 	void ClearDirty(DirtyFlag flag);
 
 	/**
@@ -250,6 +252,10 @@ public:
 	bool IsModified();
 	bool IsDirty(DirtyFlag flag);
 
+	/// Return the index of the node in the scene transform store, see SG_TransformStore.
+	unsigned int GetTransformIndex() const;
+	void SetTransformIndex(unsigned int index);
+
 protected:
 	friend class SG_Controller;
 	friend class KX_BoneParentRelation;
@@ -311,6 +317,9 @@ private:
 
 	bool m_modified;
 	unsigned short m_dirty;
+
+	/// Index in the scene transform store or SG_TransformStore::INVALID_INDEX.
+	unsigned int m_transformIndex;
 };
 
 #endif  // __SG_NODE_H__
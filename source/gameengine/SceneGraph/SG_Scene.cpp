@@ -1,9 +1,20 @@
 #include "SG_Scene.h"
+#include "SG_Familly.h"
 
 #include "CM_List.h"
 
 #include "BLI_utildefines.h"
 
+#include "tbb/tbb.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+/** Minimum number of scheduled nodes to update the scene graph in parallel,
+ * under this number the cost of tasks creation exceeds the update cost.
+ */
+static const unsigned int parallelUpdateThreshold = 512;
+
 void SG_Scene::Schedule(SG_Node *node)
 {
 	node->Schedule(m_head);
@@ -31,13 +42,75 @@ void SG_Scene::DestructRootNodes()
 	}
 }
 
+bool SG_Scene::UseParallelUpdate()
+{
+	unsigned int count = 0;
+	SG_DList::iterator<SG_Node> it(m_head);
+	for (it.begin(); !it.end() && count < parallelUpdateThreshold; ++it) {
+		++count;
+	}
+
+	return (count == parallelUpdateThreshold);
+}
+
+void SG_Scene::UpdateParentsParallel()
+{
+	// Unlink all the scheduled nodes.
+	std::vector<SG_Node *> nodes;
+	SG_Node *node;
+	while ((node = SG_Node::GetNextScheduled(m_head))) {
+		nodes.push_back(node);
+	}
+
+	const std::unordered_set<SG_Node *> scheduledNodes(nodes.begin(), nodes.end());
+
+	/* Group the nodes per familly, only the nodes without any scheduled ancestor are kept
+	 * as the update of a node is recursive. Nodes of different families never share a
+	 * parent and can be updated concurrently. */
+	std::unordered_map<SG_Familly *, NodeList> famillyNodes;
+	std::vector<NodeList *> groups;
+	for (SG_Node *scheduledNode : nodes) {
+		bool scheduledAncestor = false;
+		for (SG_Node *parent = scheduledNode->GetParent(); parent; parent = parent->GetParent()) {
+			if (scheduledNodes.find(parent) != scheduledNodes.end()) {
+				scheduledAncestor = true;
+				break;
+			}
+		}
+
+		if (scheduledAncestor) {
+			continue;
+		}
+
+		NodeList& group = famillyNodes[scheduledNode->GetFamilly().get()];
+		if (group.empty()) {
+			groups.push_back(&group);
+		}
+		group.push_back(scheduledNode);
+	}
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, groups.size()),
+		[&groups](const tbb::blocked_range<size_t>& r) {
+			for (size_t i = r.begin(), end = r.end(); i < end; ++i) {
+				for (SG_Node *node : *groups[i]) {
+					node->UpdateWorldDataThread();
+				}
+			}
+		});
+}
+
 void SG_Scene::UpdateParents()
 {
 	// We use the SG dynamic list
 	SG_Node *node;
 
-	while ((node = SG_Node::GetNextScheduled(m_head))) {
-		node->UpdateWorldData();
+	if (UseParallelUpdate()) {
+		UpdateParentsParallel();
+	}
+	else {
+		while ((node = SG_Node::GetNextScheduled(m_head))) {
+			node->UpdateWorldData();
+		}
 	}
 
 	// The list must be empty here
@@ -48,6 +121,53 @@ void SG_Scene::UpdateParents()
 	}
 }
 
+void SG_Scene::RegisterTransformRecursive(SG_Node *node)
+{
+	m_transformStore->Register(node);
+	for (SG_Node *child : node->GetChildren()) {
+		RegisterTransformRecursive(child);
+	}
+}
+
+void SG_Scene::SetUseTransformStore(bool use)
+{
+	if (use == (m_transformStore != nullptr)) {
+		return;
+	}
+
+	if (use) {
+		m_transformStore.reset(new SG_TransformStore());
+		for (SG_Node *node : m_rootNodes) {
+			RegisterTransformRecursive(node);
+		}
+	}
+	else {
+		for (SG_Node *node : m_transformStore->GetNodes()) {
+			node->SetTransformIndex(SG_TransformStore::INVALID_INDEX);
+		}
+		m_transformStore.reset(nullptr);
+	}
+}
+
+SG_TransformStore *SG_Scene::GetTransformStore() const
+{
+	return m_transformStore.get();
+}
+
+void SG_Scene::RegisterTransform(SG_Node *node)
+{
+	if (m_transformStore) {
+		m_transformStore->Register(node);
+	}
+}
+
+void SG_Scene::UnregisterTransform(SG_Node *node)
+{
+	if (m_transformStore && node->GetTransformIndex() != SG_TransformStore::INVALID_INDEX) {
+		m_transformStore->Unregister(node);
+	}
+}
+
 void SG_Scene::Merge(SG_Scene *other)
 {
 	// Change scene of merge nodes.
@@ -2,6 +2,9 @@
 #define __SG_SCENE_H__
 
 #include "SG_Node.h"
+#include "SG_TransformStore.h"
+
+#include <memory>
 
 class SG_Node;
 
@@ -19,6 +22,21 @@ private:
 	/// Root nodes: nodes without parent.
 	NodeList m_rootNodes;
 
+	/// Optional contiguous storage of the node world transforms, nullptr when unused.
+	std::unique_ptr<SG_TransformStore> m_transformStore;
+
+	/// Register a node and its recursive children in the transform store.
+	void RegisterTransformRecursive(SG_Node *node);
+
+	/** Return true if the number of scheduled nodes reaches the parallel update threshold.
+	 * The list is walked only until the threshold is reached.
+	 */
+	bool UseParallelUpdate();
+	/** Update the scheduled nodes with one task per independent familly.
+	 * Only the top most scheduled nodes are updated, their children are updated recursively.
+	 */
+	void UpdateParentsParallel();
+
 public:
 	/** Replicate node object.
 	 * \param node The new node owning the object replica.
@@ -47,6 +65,17 @@ public:
 	/// Update all nodes.
 	void UpdateParents();
 
+	/** Enable or disable the transform store of the scene.
+	 * When enabled all the existing nodes are registered and the new nodes are registered at creation.
+	 */
+	void SetUseTransformStore(bool use);
+	SG_TransformStore *GetTransformStore() const;
+
+	/// Register a node in the transform store if used.
+	void RegisterTransform(SG_Node *node);
+	/// Unregister a node from the transform store if used.
+	void UnregisterTransform(SG_Node *node);
+
 	/// Merge data with an other scene.
 	void Merge(SG_Scene *other);
 };
@@ -0,0 +1,82 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/SceneGraph/SG_TransformStore.cpp
+ *  \ingroup bgesg
+ */
+
+#include "SG_TransformStore.h"
+#include "SG_Node.h"
+
+#include "BLI_utildefines.h"
+
+void SG_TransformStore::Register(SG_Node *node)
+{
+	BLI_assert(node->GetTransformIndex() == INVALID_INDEX);
+
+	const unsigned int index = m_nodes.size();
+	node->SetTransformIndex(index);
+
+	m_nodes.push_back(node);
+	m_positions.push_back(node->GetWorldPosition());
+}
+
+void SG_TransformStore::Unregister(SG_Node *node)
+{
+	const unsigned int index = node->GetTransformIndex();
+	BLI_assert(index < m_nodes.size() && m_nodes[index] == node);
+
+	const unsigned int last = m_nodes.size() - 1;
+	if (index != last) {
+		// Move the last entry in place of the removed one.
+		SG_Node *lastNode = m_nodes[last];
+		lastNode->SetTransformIndex(index);
+
+		m_nodes[index] = lastNode;
+		m_positions[index] = m_positions[last];
+	}
+
+	m_nodes.pop_back();
+	m_positions.pop_back();
+
+	node->SetTransformIndex(INVALID_INDEX);
+}
+
+void SG_TransformStore::Update(unsigned int index, const mt::vec3& position)
+{
+	BLI_assert(index < m_nodes.size());
+
+	m_positions[index] = position;
+}
+
+unsigned int SG_TransformStore::GetSize() const
+{
+	return m_nodes.size();
+}
+
+const SG_TransformStore::PositionList& SG_TransformStore::GetPositions() const
+{
+	return m_positions;
+}
+
+const std::vector<SG_Node *>& SG_TransformStore::GetNodes() const
+{
+	return m_nodes;
+}
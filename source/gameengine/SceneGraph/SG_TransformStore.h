@@ -0,0 +1,69 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SG_TransformStore.h
+ *  \ingroup bgesg
+ */
+
+#ifndef __SG_TRANSFORM_STORE_H__
+#define __SG_TRANSFORM_STORE_H__
+
+#include "mathfu.h"
+
+#include <vector>
+
+class SG_Node;
+
+/** Structure of arrays storage of the world positions of the nodes of a scene.
+ * Each registered node owns an index in the arrays, the arrays are kept packed
+ * by moving the last entry in place of an unregistered one. This allows linear
+ * scans of the world positions without going through each node.
+ */
+class SG_TransformStore
+{
+public:
+	typedef std::vector<mt::vec3, mt::simd_allocator<mt::vec3> > PositionList;
+
+	/// Index of a node not registered in a store.
+	static const unsigned int INVALID_INDEX = (unsigned int)-1;
+
+	SG_TransformStore() = default;
+	~SG_TransformStore() = default;
+
+	/// Register a node and set its index, the entry is initialized from the node world position.
+	void Register(SG_Node *node);
+	/// Unregister a node, the node moved at its index is updated.
+	void Unregister(SG_Node *node);
+
+	/// Copy the world position of the node into its entry.
+	void Update(unsigned int index, const mt::vec3& position);
+
+	unsigned int GetSize() const;
+
+	const PositionList& GetPositions() const;
+	const std::vector<SG_Node *>& GetNodes() const;
+
+private:
+	PositionList m_positions;
+	/// Node owning each entry.
+	std::vector<SG_Node *> m_nodes;
+};
+
+#endif  // __SG_TRANSFORM_STORE_H__
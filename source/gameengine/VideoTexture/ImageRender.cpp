@@ -457,6 +457,12 @@ static int ImageRender_init(PyObject *pySelf, PyObject *args, PyObject *kwds)
 	// camera object
 	PyObject *camera;
 
+	// The headless mode doesn't create any rasterizer to render with.
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "bge.texture.ImageRender(...), Rasterizer not available");
+		return -1;
+	}
+
 	const RAS_Rect& rect = KX_GetActiveEngine()->GetCanvas()->GetArea();
 	int width = rect.GetWidth();
 	int height = rect.GetHeight();
@@ -724,6 +730,12 @@ static int ImageMirror_init(PyObject *pySelf, PyObject *args, PyObject *kwds)
 	// material of the mirror
 	short materialID = 0;
 
+	// The headless mode doesn't create any rasterizer to render with.
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "bge.texture.ImageMirror(...), Rasterizer not available");
+		return -1;
+	}
+
 	const RAS_Rect& rect = KX_GetActiveEngine()->GetCanvas()->GetArea();
 	int width = rect.GetWidth();
 	int height = rect.GetHeight();
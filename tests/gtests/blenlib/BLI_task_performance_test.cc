@@ -0,0 +1,89 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "atomic_ops.h"
+
+extern "C" {
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+#include "PIL_time_utildefines.h"
+};
+
+/* Task pool contention. */
+
+#define NUM_POOL_TASKS 100000
+#define NUM_SPAWN_TASKS 1000
+#define NUM_SPAWNED_SUB_TASKS 100
+
+static void task_pool_count_func(TaskPool *pool, void *UNUSED(taskdata), int UNUSED(threadid))
+{
+	uint32_t *count = (uint32_t *)BLI_task_pool_userdata(pool);
+	atomic_add_and_fetch_uint32(count, 1);
+}
+
+/* Push sub-tasks from the thread running the task, these go to the queue of this thread. */
+static void task_pool_spawn_func(TaskPool *pool, void *UNUSED(taskdata), int threadid)
+{
+	for (int i = 0; i < NUM_SPAWNED_SUB_TASKS; i++) {
+		BLI_task_pool_push_from_thread(pool, task_pool_count_func, NULL, false, TASK_PRIORITY_HIGH, threadid);
+	}
+	task_pool_count_func(pool, NULL, threadid);
+}
+
+static void task_pool_contention_test(TaskPool *(*pool_create)(TaskScheduler *, void *), int num_threads)
+{
+	TaskScheduler *scheduler = BLI_task_scheduler_create(num_threads);
+	uint32_t count = 0;
+
+	printf("\n========== STARTING %d threads ==========\n", BLI_task_scheduler_num_threads(scheduler));
+
+	{
+		TaskPool *pool = pool_create(scheduler, &count);
+
+		TIMEIT_START(tiny_tasks_from_one_thread);
+		for (int i = 0; i < NUM_POOL_TASKS; i++) {
+			BLI_task_pool_push(pool, task_pool_count_func, NULL, false, TASK_PRIORITY_LOW);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		TIMEIT_END(tiny_tasks_from_one_thread);
+
+		EXPECT_EQ(count, NUM_POOL_TASKS);
+		BLI_task_pool_free(pool);
+	}
+
+	count = 0;
+
+	{
+		TaskPool *pool = pool_create(scheduler, &count);
+
+		TIMEIT_START(tiny_tasks_from_all_threads);
+		for (int i = 0; i < NUM_SPAWN_TASKS; i++) {
+			BLI_task_pool_push(pool, task_pool_spawn_func, NULL, false, TASK_PRIORITY_LOW);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		TIMEIT_END(tiny_tasks_from_all_threads);
+
+		EXPECT_EQ(count, NUM_SPAWN_TASKS * (NUM_SPAWNED_SUB_TASKS + 1));
+		BLI_task_pool_free(pool);
+	}
+
+	BLI_task_scheduler_free(scheduler);
+
+	printf("========== ENDED ==========\n\n");
+}
+
+/* Use the system threads count and a fixed threads count to also exercise work stealing
+ * on machines with few cores. */
+
+TEST(task, PoolContention)
+{
+	task_pool_contention_test(BLI_task_pool_create, 0);
+	task_pool_contention_test(BLI_task_pool_create, 16);
+}
+
+TEST(task, PoolContentionSuspended)
+{
+	task_pool_contention_test(BLI_task_pool_create_suspended, 0);
+	task_pool_contention_test(BLI_task_pool_create_suspended, 16);
+}
@@ -3,6 +3,10 @@
 #include "testing/testing.h"
 #include <string.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 #include "atomic_ops.h"
 
 extern "C" {
@@ -74,3 +78,69 @@ TEST(task, MempoolIter)
 
 	BLI_mempool_destroy(mempool);
 }
+
+/* Task pool work stealing. */
+
+#define NUM_STEAL_TASKS 100
+
+/* Time waited for a stolen task before failing, only reached without stealing. */
+#define STEAL_TIMEOUT std::chrono::seconds(5)
+
+typedef struct TaskStealData {
+	std::mutex mutex;
+	std::condition_variable cond;
+	int num_done;
+	bool stolen;
+	bool spawner_done;
+} TaskStealData;
+
+static void task_steal_count_func(TaskPool *pool, void *UNUSED(taskdata), int UNUSED(threadid))
+{
+	TaskStealData *data = (TaskStealData *)BLI_task_pool_userdata(pool);
+	std::unique_lock<std::mutex> lock(data->mutex);
+	data->num_done++;
+	data->cond.notify_all();
+}
+
+/* Push sub-tasks in the queue of the running thread and block this thread until
+ * one is done, the sub-tasks can only be run by the other threads stealing them. */
+static void task_steal_spawn_func(TaskPool *pool, void *UNUSED(taskdata), int threadid)
+{
+	TaskStealData *data = (TaskStealData *)BLI_task_pool_userdata(pool);
+
+	for (int i = 0; i < NUM_STEAL_TASKS; i++) {
+		BLI_task_pool_push_from_thread(pool, task_steal_count_func, NULL, false, TASK_PRIORITY_HIGH, threadid);
+	}
+
+	std::unique_lock<std::mutex> lock(data->mutex);
+	data->stolen = data->cond.wait_for(lock, STEAL_TIMEOUT, [data]() { return data->num_done > 0; });
+	data->spawner_done = true;
+	data->cond.notify_all();
+}
+
+TEST(task, PoolSteal)
+{
+	/* Fixed threads count to have workers to steal with on any machine. */
+	TaskScheduler *scheduler = BLI_task_scheduler_create(4);
+	TaskStealData data;
+	data.num_done = 0;
+	data.stolen = false;
+	data.spawner_done = false;
+	TaskPool *pool = BLI_task_pool_create(scheduler, &data);
+
+	BLI_task_pool_push(pool, task_steal_spawn_func, NULL, false, TASK_PRIORITY_HIGH);
+
+	/* Let a worker thread run the spawning task, the main thread would run the sub-tasks
+	 * itself in work_and_wait. */
+	{
+		std::unique_lock<std::mutex> lock(data.mutex);
+		data.cond.wait_for(lock, STEAL_TIMEOUT * 2, [&data]() { return data.spawner_done; });
+	}
+	BLI_task_pool_work_and_wait(pool);
+
+	EXPECT_TRUE(data.stolen);
+	EXPECT_EQ(data.num_done, NUM_STEAL_TASKS);
+
+	BLI_task_pool_free(pool);
+	BLI_task_scheduler_free(scheduler);
+}
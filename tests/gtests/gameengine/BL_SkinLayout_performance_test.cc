@@ -0,0 +1,270 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BL_SkinLayout.h"
+
+#include <Eigen/Core>
+
+#include <random>
+
+extern "C" {
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "PIL_time_utildefines.h"
+}
+
+/* Number of time the deformation is repeated. */
+#define DEFORM_PASS_COUNT 10
+
+#define BONE_COUNT 64
+
+static mt::mat4 test_matrix(const mt::mat3& rot, const mt::vec3& pos)
+{
+	return mt::mat4::FromTranslationVector(pos) * mt::mat4::FromRotationMatrix(rot);
+}
+
+struct TestWeight {
+	unsigned short bone;
+	float weight;
+};
+
+struct TestVertex {
+	TestWeight weights[BL_SkinLayout::MAX_INFLUENCES];
+	unsigned int count;
+};
+
+/* Same deformation as BL_SkinDeformer::BGEDeformVerts, reading the weights of each vertex
+ * and the matrices of each bone weight. */
+static void reference_deform(const std::vector<TestVertex>& vertices, const float (*chanmats)[4][4],
+                             const Eigen::Matrix4f& pre_mat, const Eigen::Matrix4f& post_mat,
+                             std::vector<mt::vec3_packed>& positions, std::vector<mt::vec3_packed>& normals)
+{
+	Eigen::Matrix4f norm_chan_mat;
+
+	for (unsigned int i = 0, size = vertices.size(); i < size; ++i) {
+		const TestVertex& vert = vertices[i];
+		Eigen::Vector4f vec(0.0f, 0.0f, 0.0f, 1.0f);
+		Eigen::Vector4f co(positions[i].x, positions[i].y, positions[i].z, 1.0f);
+		float contrib = 0.0f, max_weight = -1.0f;
+
+		co = pre_mat * co;
+
+		for (unsigned int j = 0; j < vert.count; ++j) {
+			const TestWeight& weight = vert.weights[j];
+			const Eigen::Matrix4f chan_mat = Eigen::Matrix4f::Map((float *)chanmats[weight.bone]);
+			vec.noalias() += (chan_mat * co - co) * weight.weight;
+			if (weight.weight > max_weight) {
+				max_weight = weight.weight;
+				norm_chan_mat = chan_mat;
+			}
+			contrib += weight.weight;
+		}
+
+		const Eigen::Vector3f normorg(0.0f, 0.0f, 1.0f);
+		Eigen::Map<Eigen::Vector3f> norm = Eigen::Vector3f::Map(normals[i].data);
+		norm = norm_chan_mat.topLeftCorner<3, 3>() * normorg;
+
+		co.noalias() += vec / contrib;
+		co[3] = 1.0f;
+		co = post_mat * co;
+
+		positions[i] = mt::vec3_packed(mt::vec3(co[0], co[1], co[2]));
+	}
+}
+
+static void skin_layout_deform_test(unsigned int numverts)
+{
+	printf("\n========== STARTING %u vertices ==========\n", numverts);
+
+	std::mt19937 rng(numverts);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	/* Bones with small random rotations and translations. */
+	float chanmats[BONE_COUNT][4][4];
+	for (unsigned short i = 0; i < BONE_COUNT; ++i) {
+		const mt::mat3 rot = mt::mat3::RotationX(dist(rng)) * mt::mat3::RotationZ(dist(rng));
+		const mt::mat4 mat = test_matrix(rot, mt::vec3(dist(rng), dist(rng), dist(rng)));
+		mat.Pack(chanmats[i]);
+	}
+
+	const mt::mat4 post_mat = test_matrix(mt::mat3::RotationY(0.5f), mt::vec3(1.0f, 2.0f, 3.0f));
+	const mt::mat4 pre_mat = post_mat.Inverse();
+	float post[4][4];
+	float pre[4][4];
+	post_mat.Pack(post);
+	pre_mat.Pack(pre);
+
+	/* Vertices with at most four weights to compare both deformations. */
+	std::vector<TestVertex> vertices(numverts);
+	std::vector<mt::vec3_packed> restPositions(numverts);
+	BL_SkinLayout layout;
+	for (unsigned int i = 0; i < numverts; ++i) {
+		TestVertex& vert = vertices[i];
+		vert.count = 1 + rng() % BL_SkinLayout::MAX_INFLUENCES;
+
+		unsigned short bones[BL_SkinLayout::MAX_INFLUENCES];
+		float weights[BL_SkinLayout::MAX_INFLUENCES];
+		for (unsigned int j = 0; j < vert.count; ++j) {
+			vert.weights[j].bone = rng() % BONE_COUNT;
+			vert.weights[j].weight = 0.1f + (dist(rng) + 1.0f);
+			bones[j] = vert.weights[j].bone + 1;
+			weights[j] = vert.weights[j].weight;
+		}
+
+		restPositions[i] = mt::vec3_packed(mt::vec3(dist(rng) * 10.0f, dist(rng) * 10.0f, dist(rng) * 10.0f));
+		layout.AddVertex(bones, weights, vert.count, mt::vec3_packed(mt::vec3(0.0f, 0.0f, 1.0f)));
+	}
+
+	std::vector<mt::vec3_packed> refPositions;
+	std::vector<mt::vec3_packed> refNormals(numverts);
+	{
+		TIMEIT_START(reference_deform);
+		for (unsigned int pass = 0; pass < DEFORM_PASS_COUNT; ++pass) {
+			refPositions = restPositions;
+			reference_deform(vertices, chanmats, Eigen::Matrix4f::Map((float *)pre),
+			                 Eigen::Matrix4f::Map((float *)post), refPositions, refNormals);
+		}
+		TIMEIT_END(reference_deform);
+	}
+
+	std::vector<mt::vec3_packed> positions;
+	std::vector<mt::vec3_packed> normals(numverts);
+	{
+		TIMEIT_START(skin_layout_deform);
+		for (unsigned int pass = 0; pass < DEFORM_PASS_COUNT; ++pass) {
+			positions = restPositions;
+
+			BL_SkinLayout::MatrixList matrices(BONE_COUNT + 1);
+			matrices[0] = mt::mat4::Identity();
+			for (unsigned short i = 0; i < BONE_COUNT; ++i) {
+				matrices[i + 1] = post_mat * mt::mat4(chanmats[i]) * pre_mat;
+			}
+
+			layout.Deform(matrices, positions.data(), normals.data());
+		}
+		TIMEIT_END(skin_layout_deform);
+	}
+
+	EXPECT_EQ(layout.GetVertexCount(), numverts);
+	for (unsigned int i = 0; i < numverts; ++i) {
+		EXPECT_NEAR(positions[i].x, refPositions[i].x, 1e-3f);
+		EXPECT_NEAR(positions[i].y, refPositions[i].y, 1e-3f);
+		EXPECT_NEAR(positions[i].z, refPositions[i].z, 1e-3f);
+	}
+
+	printf("========== ENDED %u vertices ==========\n\n", numverts);
+}
+
+TEST(skin_layout, Deform10k)
+{
+	skin_layout_deform_test(10000);
+}
+
+TEST(skin_layout, Deform60k)
+{
+	skin_layout_deform_test(60000);
+}
+
+/* Same deformation as armature_deform_verts with volume preservation. */
+static void reference_dual_quaternion_deform(const std::vector<TestVertex>& vertices, const std::vector<DualQuat>& dquats,
+                                             std::vector<mt::vec3_packed>& positions)
+{
+	for (unsigned int i = 0, size = vertices.size(); i < size; ++i) {
+		const TestVertex& vert = vertices[i];
+		DualQuat sumdq;
+		memset(&sumdq, 0, sizeof(DualQuat));
+		float contrib = 0.0f;
+
+		for (unsigned int j = 0; j < vert.count; ++j) {
+			add_weighted_dq_dq(&sumdq, &dquats[vert.weights[j].bone + 1], vert.weights[j].weight);
+			contrib += vert.weights[j].weight;
+		}
+
+		normalize_dq(&sumdq, contrib);
+		mul_v3m3_dq(positions[i].data, nullptr, &sumdq);
+	}
+}
+
+static void skin_layout_dual_quaternion_test(unsigned int numverts)
+{
+	printf("\n========== STARTING %u vertices ==========\n", numverts);
+
+	std::mt19937 rng(numverts);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	/* Bones with small random rotations and translations, some of them are scaled. */
+	BL_SkinLayout::DualQuatList dquats(BONE_COUNT + 1);
+	memset(&dquats[0], 0, sizeof(DualQuat));
+	unit_qt(dquats[0].quat);
+	for (unsigned short i = 0; i < BONE_COUNT; ++i) {
+		const mt::mat3 rot = mt::mat3::RotationX(dist(rng)) * mt::mat3::RotationZ(dist(rng));
+		const mt::vec3 scale = (i % 4 == 0) ? mt::vec3(1.5f, 1.0f, 0.5f) : mt::one3;
+		const mt::mat4 mat = test_matrix(rot, mt::vec3(dist(rng), dist(rng), dist(rng))) *
+		                     mt::mat4::FromScaleVector(scale);
+		float chanmat[4][4];
+		float basemat[4][4];
+		mat.Pack(chanmat);
+		unit_m4(basemat);
+		mat4_to_dquat(&dquats[i + 1], basemat, chanmat);
+	}
+
+	std::vector<TestVertex> vertices(numverts);
+	std::vector<mt::vec3_packed> restPositions(numverts);
+	BL_SkinLayout layout;
+	for (unsigned int i = 0; i < numverts; ++i) {
+		TestVertex& vert = vertices[i];
+		vert.count = 1 + rng() % BL_SkinLayout::MAX_INFLUENCES;
+
+		unsigned short bones[BL_SkinLayout::MAX_INFLUENCES];
+		float weights[BL_SkinLayout::MAX_INFLUENCES];
+		for (unsigned int j = 0; j < vert.count; ++j) {
+			vert.weights[j].bone = rng() % BONE_COUNT;
+			vert.weights[j].weight = 0.1f + (dist(rng) + 1.0f);
+			bones[j] = vert.weights[j].bone + 1;
+			weights[j] = vert.weights[j].weight;
+		}
+
+		restPositions[i] = mt::vec3_packed(mt::vec3(dist(rng) * 10.0f, dist(rng) * 10.0f, dist(rng) * 10.0f));
+		layout.AddVertex(bones, weights, vert.count, mt::vec3_packed(mt::vec3(0.0f, 0.0f, 1.0f)));
+	}
+
+	std::vector<mt::vec3_packed> refPositions;
+	{
+		TIMEIT_START(reference_dual_quaternion_deform);
+		for (unsigned int pass = 0; pass < DEFORM_PASS_COUNT; ++pass) {
+			refPositions = restPositions;
+			reference_dual_quaternion_deform(vertices, dquats, refPositions);
+		}
+		TIMEIT_END(reference_dual_quaternion_deform);
+	}
+
+	std::vector<mt::vec3_packed> positions;
+	std::vector<mt::vec3_packed> normals(numverts);
+	{
+		TIMEIT_START(skin_layout_dual_quaternion_deform);
+		for (unsigned int pass = 0; pass < DEFORM_PASS_COUNT; ++pass) {
+			positions = restPositions;
+			layout.DeformDualQuaternion(dquats, positions.data(), normals.data());
+		}
+		TIMEIT_END(skin_layout_dual_quaternion_deform);
+	}
+
+	for (unsigned int i = 0; i < numverts; ++i) {
+		EXPECT_NEAR(positions[i].x, refPositions[i].x, 1e-3f);
+		EXPECT_NEAR(positions[i].y, refPositions[i].y, 1e-3f);
+		EXPECT_NEAR(positions[i].z, refPositions[i].z, 1e-3f);
+	}
+
+	printf("========== ENDED %u vertices ==========\n\n", numverts);
+}
+
+TEST(skin_layout, DualQuaternionDeform10k)
+{
+	skin_layout_dual_quaternion_test(10000);
+}
+
+TEST(skin_layout, DualQuaternionDeform60k)
+{
+	skin_layout_dual_quaternion_test(60000);
+}
@@ -0,0 +1,98 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BL_SkinLayout.h"
+
+extern "C" {
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+}
+
+TEST(skin_layout, Influences)
+{
+	/* Only the four most influent bones are kept and their weights normalized. */
+	const unsigned short bones[] = {1, 2, 3, 4, 5, 6};
+	const float weights[] = {0.1f, 0.5f, 0.0f, 0.2f, 0.05f, 0.15f};
+	BL_SkinLayout layout;
+	layout.AddVertex(bones, weights, 6, mt::vec3_packed(mt::vec3(0.0f, 0.0f, 1.0f)));
+	/* A vertex without influence is not deformed. */
+	layout.AddVertex(nullptr, nullptr, 0, mt::vec3_packed(mt::vec3(0.0f, 0.0f, 1.0f)));
+
+	BL_SkinLayout::MatrixList matrices(7, mt::mat4::Identity());
+	matrices[5] = mt::mat4::FromTranslationVector(mt::vec3(100.0f, 0.0f, 0.0f));
+	matrices[2] = mt::mat4::FromTranslationVector(mt::vec3(1.0f, 0.0f, 0.0f));
+
+	mt::vec3_packed positions[2] = {mt::vec3_packed(mt::vec3(0.0f, 0.0f, 0.0f)), mt::vec3_packed(mt::vec3(1.0f, 2.0f, 3.0f))};
+	layout.Deform(matrices, positions, nullptr);
+
+	/* Weights 0.5, 0.2, 0.15, 0.1 normalized by 0.95, the bone 5 is ignored. */
+	EXPECT_NEAR(positions[0].x, 0.5f / 0.95f, 1e-5f);
+	EXPECT_EQ(positions[1].x, 1.0f);
+	EXPECT_EQ(positions[1].y, 2.0f);
+	EXPECT_EQ(positions[1].z, 3.0f);
+}
+
+TEST(skin_layout, DualQuaternionTwist)
+{
+	/* A vertex at the middle of two bones twisted by 180 degrees around the X axis,
+	 * the linear blend collapses the vertex on the axis when the dual quaternions keep its distance. */
+	const unsigned short bones[] = {1, 2};
+	const float weights[] = {0.5f, 0.5f};
+	BL_SkinLayout layout;
+	layout.AddVertex(bones, weights, 2, mt::vec3_packed(mt::vec3(0.0f, 0.0f, 1.0f)));
+
+	const mt::mat4 twist = mt::mat4::FromRotationMatrix(mt::mat3::RotationX(M_PI * 0.999f));
+	BL_SkinLayout::MatrixList matrices = {mt::mat4::Identity(), mt::mat4::Identity(), twist};
+
+	BL_SkinLayout::DualQuatList dquats(3);
+	float unitmat[4][4];
+	unit_m4(unitmat);
+	for (unsigned short i = 0; i < 3; ++i) {
+		float mat[4][4];
+		matrices[i].Pack(mat);
+		mat4_to_dquat(&dquats[i], unitmat, mat);
+	}
+
+	mt::vec3_packed linear(mt::vec3(0.0f, 0.0f, 1.0f));
+	layout.Deform(matrices, &linear, nullptr);
+	EXPECT_LT(mt::vec3(linear.data).Length(), 0.01f);
+
+	mt::vec3_packed dual(mt::vec3(0.0f, 0.0f, 1.0f));
+	layout.DeformDualQuaternion(dquats, &dual, nullptr);
+	EXPECT_NEAR(mt::vec3(dual.data).Length(), 1.0f, 1e-5f);
+}
+
+TEST(skin_layout, Normals)
+{
+	/* A vertex blended between a bone rotated by 90 degrees and a scaled bone,
+	 * the blended normals are normalized. */
+	const unsigned short bones[] = {1, 2};
+	const float weights[] = {0.5f, 0.5f};
+	BL_SkinLayout layout;
+	layout.AddVertex(bones, weights, 2, mt::vec3_packed(mt::vec3(0.0f, 0.0f, 1.0f)));
+
+	BL_SkinLayout::MatrixList matrices = {
+		mt::mat4::Identity(),
+		mt::mat4::FromRotationMatrix(mt::mat3::RotationX(M_PI_2)),
+		mt::mat4::FromScaleVector(mt::vec3(1.0f, 1.0f, 3.0f))
+	};
+
+	mt::vec3_packed position(mt::vec3(0.0f, 0.0f, 0.0f));
+	mt::vec3_packed normal;
+	layout.Deform(matrices, &position, &normal);
+	EXPECT_NEAR(mt::vec3(normal.data).Length(), 1.0f, 1e-5f);
+
+	BL_SkinLayout::DualQuatList dquats(3);
+	float unitmat[4][4];
+	unit_m4(unitmat);
+	for (unsigned short i = 0; i < 3; ++i) {
+		float mat[4][4];
+		matrices[i].Pack(mat);
+		mat4_to_dquat(&dquats[i], unitmat, mat);
+	}
+
+	position = mt::vec3_packed(mt::vec3(0.0f, 0.0f, 0.0f));
+	layout.DeformDualQuaternion(dquats, &position, &normal);
+	EXPECT_NEAR(mt::vec3(normal.data).Length(), 1.0f, 1e-5f);
+}
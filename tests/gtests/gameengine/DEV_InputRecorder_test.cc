@@ -0,0 +1,212 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "DEV_InputRecorder.h"
+
+#include "SCA_IInputDevice.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#define FRAME_COUNT 20
+
+/// Copy of the inputs table of a device, as seen by the sensors of a frame.
+struct InputSnapshot
+{
+	struct Event {
+		std::vector<SCA_InputEvent::SCA_EnumInputs> status;
+		std::vector<SCA_InputEvent::SCA_EnumInputs> queue;
+		std::vector<int> values;
+		unsigned int unicode;
+	};
+
+	Event events[SCA_IInputDevice::MAX_KEYS];
+	std::wstring text;
+
+	InputSnapshot(SCA_IInputDevice& device)
+	{
+		for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+			const SCA_InputEvent& input = device.GetInput((SCA_IInputDevice::SCA_EnumInputs)i);
+			events[i] = {input.m_status, input.m_queue, input.m_values, input.m_unicode};
+		}
+		text = device.GetText();
+	}
+};
+
+static void expect_inputs_equal(const InputSnapshot& expected, SCA_IInputDevice& device, unsigned int frame)
+{
+	for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+		const InputSnapshot::Event& event = expected.events[i];
+		const SCA_InputEvent& input = device.GetInput((SCA_IInputDevice::SCA_EnumInputs)i);
+		EXPECT_EQ(input.m_status, event.status) << "frame " << frame << ", input " << i;
+		EXPECT_EQ(input.m_queue, event.queue) << "frame " << frame << ", input " << i;
+		EXPECT_EQ(input.m_values, event.values) << "frame " << frame << ", input " << i;
+		EXPECT_EQ(input.m_unicode, event.unicode) << "frame " << frame << ", input " << i;
+	}
+	EXPECT_EQ(device.GetText(), expected.text) << "frame " << frame;
+}
+
+static void expect_inputs_discarded(SCA_IInputDevice& device)
+{
+	for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+		const SCA_InputEvent& input = device.GetInput((SCA_IInputDevice::SCA_EnumInputs)i);
+		EXPECT_EQ(input.m_status.size(), 1);
+		EXPECT_EQ(input.m_values.size(), 1);
+		EXPECT_TRUE(input.m_queue.empty());
+	}
+	EXPECT_TRUE(device.GetText().empty());
+}
+
+static void push_event(SCA_IInputDevice& device, SCA_IInputDevice::SCA_EnumInputs type, SCA_InputEvent::SCA_EnumInputs status,
+                       SCA_InputEvent::SCA_EnumInputs queue)
+{
+	SCA_InputEvent& input = device.GetInput(type);
+	input.m_status.push_back(status);
+	input.m_queue.push_back(queue);
+}
+
+/// Emit the events of a frame as the window system would do.
+static void frame_events(SCA_IInputDevice& device, unsigned int frame)
+{
+	// Key pressed every 3 frames and released the next frame, with text.
+	if ((frame % 3) == 0) {
+		push_event(device, SCA_IInputDevice::AKEY, SCA_InputEvent::ACTIVE, SCA_InputEvent::JUSTACTIVATED);
+		device.GetInput(SCA_IInputDevice::AKEY).m_unicode = (frame % 2) ? 'a' : 'A';
+		device.SetText(device.GetText() + ((frame % 2) ? L"a" : L"A\u00e9"));
+	}
+	else if ((frame % 3) == 1) {
+		push_event(device, SCA_IInputDevice::AKEY, SCA_InputEvent::NONE, SCA_InputEvent::JUSTRELEASED);
+	}
+
+	// Mouse moved with several values in the same frame.
+	if ((frame % 4) != 3) {
+		for (unsigned int i = 0; i < frame % 4 + 1; ++i) {
+			SCA_InputEvent& mousex = device.GetInput(SCA_IInputDevice::MOUSEX);
+			mousex.m_status.push_back(SCA_InputEvent::ACTIVE);
+			mousex.m_queue.push_back(SCA_InputEvent::JUSTACTIVATED);
+			mousex.m_values.push_back(frame * 10 - i * 7);
+		}
+	}
+
+	// Pressed and released in the same frame.
+	if (frame == 5) {
+		push_event(device, SCA_IInputDevice::LEFTMOUSE, SCA_InputEvent::ACTIVE, SCA_InputEvent::JUSTACTIVATED);
+		push_event(device, SCA_IInputDevice::LEFTMOUSE, SCA_InputEvent::NONE, SCA_InputEvent::JUSTRELEASED);
+	}
+}
+
+/// Record a stream of FRAME_COUNT frames and return the inputs of each frame.
+static std::vector<InputSnapshot> record_stream(const std::string& path)
+{
+	std::vector<InputSnapshot> snapshots;
+	DEV_InputRecorder recorder(DEV_InputRecorder::RECORD, path);
+	EXPECT_TRUE(recorder.IsValid());
+
+	SCA_IInputDevice device;
+	for (unsigned int frame = 0; frame < FRAME_COUNT; ++frame) {
+		device.ClearInputs();
+		frame_events(device, frame);
+		recorder.ProceedInputs(&device);
+		device.ReleaseMoveEvent();
+		recorder.ProceedJoysticks();
+		snapshots.emplace_back(device);
+	}
+
+	EXPECT_EQ(recorder.GetFrames(), FRAME_COUNT);
+
+	return snapshots;
+}
+
+TEST(DEV_InputRecorder, Replay)
+{
+	const std::string path = ::testing::internal::TempDir() + "DEV_InputRecorder_replay.bin";
+	const std::vector<InputSnapshot> snapshots = record_stream(path);
+
+	DEV_InputRecorder replayer(DEV_InputRecorder::REPLAY, path);
+	ASSERT_TRUE(replayer.IsValid());
+
+	SCA_IInputDevice device;
+	for (unsigned int frame = 0; frame < FRAME_COUNT; ++frame) {
+		device.ClearInputs();
+		// The live events are replaced by the recorded ones.
+		push_event(device, SCA_IInputDevice::ZKEY, SCA_InputEvent::ACTIVE, SCA_InputEvent::JUSTACTIVATED);
+		device.SetText(L"z");
+
+		replayer.ProceedInputs(&device);
+		device.ReleaseMoveEvent();
+		replayer.ProceedJoysticks();
+		EXPECT_FALSE(replayer.IsFinished());
+		expect_inputs_equal(snapshots[frame], device, frame);
+	}
+
+	EXPECT_EQ(replayer.GetFrames(), FRAME_COUNT);
+
+	// The end of the stream discards the live events.
+	device.ClearInputs();
+	push_event(device, SCA_IInputDevice::ZKEY, SCA_InputEvent::ACTIVE, SCA_InputEvent::JUSTACTIVATED);
+	replayer.ProceedInputs(&device);
+	replayer.ProceedJoysticks();
+	EXPECT_TRUE(replayer.IsFinished());
+	expect_inputs_discarded(device);
+
+	remove(path.c_str());
+}
+
+TEST(DEV_InputRecorder, Truncated)
+{
+	const std::string path = ::testing::internal::TempDir() + "DEV_InputRecorder_truncated.bin";
+	const std::vector<InputSnapshot> snapshots = record_stream(path);
+
+	// Cut the stream in the middle of the last frame.
+	std::string data;
+	{
+		std::ifstream file(path, std::ios::binary);
+		data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	ASSERT_GT(data.size(), 64);
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(data.data(), data.size() - 13);
+	}
+
+	DEV_InputRecorder replayer(DEV_InputRecorder::REPLAY, path);
+	ASSERT_TRUE(replayer.IsValid());
+
+	SCA_IInputDevice device;
+	unsigned int frame = 0;
+	for (; frame < FRAME_COUNT; ++frame) {
+		device.ClearInputs();
+		replayer.ProceedInputs(&device);
+		if (replayer.IsFinished()) {
+			break;
+		}
+		device.ReleaseMoveEvent();
+		replayer.ProceedJoysticks();
+		ASSERT_FALSE(replayer.IsFinished());
+		expect_inputs_equal(snapshots[frame], device, frame);
+	}
+
+	// The corrupted frame is discarded and the replay ends.
+	EXPECT_EQ(frame, FRAME_COUNT - 1);
+	expect_inputs_discarded(device);
+
+	device.ClearInputs();
+	replayer.ProceedInputs(&device);
+	EXPECT_TRUE(replayer.IsFinished());
+	expect_inputs_discarded(device);
+
+	remove(path.c_str());
+
+	// A stream without a complete header is invalid.
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(data.data(), 6);
+	}
+
+	DEV_InputRecorder invalid(DEV_InputRecorder::REPLAY, path);
+	EXPECT_FALSE(invalid.IsValid());
+
+	remove(path.c_str());
+}
@@ -0,0 +1,78 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "EXP_ListValue.h"
+#include "EXP_StringValue.h"
+
+#include <algorithm>
+#include <random>
+
+extern "C" {
+#include "PIL_time_utildefines.h"
+}
+
+/* Number of names looked up. */
+#define LOOKUP_COUNT 100000
+
+/* Same lookup as EXP_BaseListValue::FindValue without the name index. */
+static EXP_StringValue *reference_find(EXP_ListValue<EXP_StringValue> *list, const std::string& name)
+{
+	return list->FindIf([&name](EXP_StringValue *item) {
+		return item->GetName() == name;
+	});
+}
+
+static void list_value_find_test(unsigned int numvalues)
+{
+	printf("\n========== STARTING %u values ==========\n", numvalues);
+
+	EXP_ListValue<EXP_StringValue> *list = new EXP_ListValue<EXP_StringValue>();
+	for (unsigned int i = 0; i < numvalues; ++i) {
+		const std::string name = "OBObject." + std::to_string(i);
+		list->Add(new EXP_StringValue(name, name));
+	}
+
+	/* Random existing names and a few missing names. */
+	std::mt19937 rng(numvalues);
+	std::vector<std::string> names(LOOKUP_COUNT);
+	for (std::string& name : names) {
+		name = "OBObject." + std::to_string(rng() % (numvalues + numvalues / 10));
+	}
+
+	std::vector<EXP_StringValue *> refResults(LOOKUP_COUNT);
+	{
+		TIMEIT_START(reference_find);
+		for (unsigned int i = 0; i < LOOKUP_COUNT; ++i) {
+			refResults[i] = reference_find(list, names[i]);
+		}
+		TIMEIT_END(reference_find);
+	}
+
+	std::vector<EXP_StringValue *> results(LOOKUP_COUNT);
+	{
+		TIMEIT_START(list_value_find);
+		for (unsigned int i = 0; i < LOOKUP_COUNT; ++i) {
+			results[i] = list->FindValue(names[i]);
+		}
+		TIMEIT_END(list_value_find);
+	}
+
+	for (unsigned int i = 0; i < LOOKUP_COUNT; ++i) {
+		EXPECT_EQ(results[i], refResults[i]);
+	}
+
+	list->Release();
+
+	printf("========== ENDED %u values ==========\n\n", numvalues);
+}
+
+TEST(list_value, Find1k)
+{
+	list_value_find_test(1000);
+}
+
+TEST(list_value, Find10k)
+{
+	list_value_find_test(10000);
+}
@@ -0,0 +1,36 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "EXP_ListValue.h"
+#include "EXP_StringValue.h"
+
+TEST(list_value, Invalidate)
+{
+	EXP_ListValue<EXP_StringValue> *list = new EXP_ListValue<EXP_StringValue>();
+	for (unsigned int i = 0; i < 100; ++i) {
+		const std::string name = "OBObject." + std::to_string(i);
+		list->Add(new EXP_StringValue(name, name));
+	}
+
+	/* The first value of a name is found. */
+	EXP_StringValue *duplicate = new EXP_StringValue("", "OBObject.50");
+	list->Add(duplicate);
+	EXPECT_EQ(list->FindValue("OBObject.50"), list->GetValue(50));
+
+	/* The index is rebuilt after a removal. */
+	EXP_StringValue *removed = list->GetValue(50);
+	list->RemoveValue(removed);
+	removed->Release();
+	EXPECT_EQ(list->FindValue("OBObject.50"), duplicate);
+
+	/* And after a rename. */
+	EXP_StringValue *renamed = list->GetValue(10);
+	renamed->SetName("OBRenamed");
+	EXPECT_EQ(list->FindValue("OBRenamed"), renamed);
+	EXPECT_EQ(list->FindValue("OBObject.10"), nullptr);
+
+	EXPECT_EQ(list->FindValue("OBMissing"), nullptr);
+
+	list->Release();
+}
@@ -0,0 +1,116 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "EXP_IntValue.h"
+#include "EXP_StringValue.h"
+
+#include <map>
+
+extern "C" {
+#include "PIL_time_utildefines.h"
+}
+
+/* Number of properties of each value, as a game object with a lot of properties. */
+#define PROPERTY_COUNT 40
+
+/* Property storage as EXP_Value used to do. */
+typedef std::map<std::string, EXP_Value *> ReferenceProperties;
+
+static std::string property_name(unsigned int i)
+{
+	return "prop_" + std::to_string(i);
+}
+
+static void value_replica_test(unsigned int numreplicas)
+{
+	printf("\n========== STARTING %u replicas ==========\n", numreplicas);
+
+	EXP_StringValue *original = new EXP_StringValue("", "original");
+	ReferenceProperties refOriginal;
+	for (unsigned int i = 0; i < PROPERTY_COUNT; ++i) {
+		EXP_IntValue *prop = new EXP_IntValue(i);
+		original->SetProperty(property_name(i), prop);
+		refOriginal[property_name(i)] = prop->AddRef();
+		prop->Release();
+	}
+
+	std::vector<ReferenceProperties> refReplicas(numreplicas);
+	{
+		TIMEIT_START(reference_replica);
+		for (ReferenceProperties& replica : refReplicas) {
+			replica = refOriginal;
+			for (auto& pair : replica) {
+				pair.second = pair.second->GetReplica();
+			}
+		}
+		TIMEIT_END(reference_replica);
+	}
+
+	std::vector<EXP_Value *> replicas(numreplicas);
+	{
+		TIMEIT_START(value_replica);
+		for (EXP_Value *& replica : replicas) {
+			replica = original->GetReplica();
+		}
+		TIMEIT_END(value_replica);
+	}
+
+	unsigned int refFound = 0;
+	{
+		TIMEIT_START(reference_find);
+		for (ReferenceProperties& replica : refReplicas) {
+			for (unsigned int i = 0; i < PROPERTY_COUNT; ++i) {
+				refFound += (replica.find(property_name(i)) != replica.end());
+			}
+		}
+		TIMEIT_END(reference_find);
+	}
+
+	unsigned int found = 0;
+	{
+		TIMEIT_START(value_find);
+		for (EXP_Value *replica : replicas) {
+			for (unsigned int i = 0; i < PROPERTY_COUNT; ++i) {
+				found += (replica->GetPropertyNumber(property_name(i), -1.0f) >= 0.0f);
+			}
+		}
+		TIMEIT_END(value_find);
+	}
+
+	/* The inline properties are allocated when requested as values. */
+	unsigned int allocated = 0;
+	{
+		TIMEIT_START(value_allocate);
+		for (EXP_Value *replica : replicas) {
+			for (unsigned int i = 0; i < PROPERTY_COUNT; ++i) {
+				allocated += (replica->GetProperty(property_name(i)) != nullptr);
+			}
+		}
+		TIMEIT_END(value_allocate);
+	}
+
+	EXPECT_EQ(found, refFound);
+	EXPECT_EQ(found, numreplicas * PROPERTY_COUNT);
+	EXPECT_EQ(allocated, found);
+
+	for (ReferenceProperties& replica : refReplicas) {
+		for (auto& pair : replica) {
+			pair.second->Release();
+		}
+	}
+	for (auto& pair : refOriginal) {
+		pair.second->Release();
+	}
+	for (EXP_Value *replica : replicas) {
+		replica->Release();
+	}
+	original->Release();
+
+	printf("========== ENDED %u replicas ==========\n\n", numreplicas);
+}
+
+TEST(value, Replica20k)
+{
+	value_replica_test(20000);
+}
@@ -0,0 +1,105 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "EXP_BoolValue.h"
+#include "EXP_FloatValue.h"
+#include "EXP_IntValue.h"
+#include "EXP_StringValue.h"
+
+TEST(value, Properties)
+{
+	EXP_StringValue *value = new EXP_StringValue("", "value");
+	const char *names[] = {"b", "c", "a"};
+	for (unsigned int i = 0; i < 3; ++i) {
+		EXP_IntValue *prop = new EXP_IntValue(i);
+		value->SetProperty(names[i], prop);
+		prop->Release();
+	}
+
+	/* The names are sorted and a property is replaced. */
+	EXP_IntValue *prop = new EXP_IntValue(10);
+	value->SetProperty("c", prop);
+	prop->Release();
+
+	const std::vector<std::string> propNames = value->GetPropertyNames();
+	ASSERT_EQ(propNames.size(), 3u);
+	EXPECT_EQ(propNames[0], "a");
+	EXPECT_EQ(propNames[1], "b");
+	EXPECT_EQ(propNames[2], "c");
+	EXPECT_EQ(value->GetProperty("c"), prop);
+	EXPECT_EQ(value->GetProperty(2), prop);
+
+	EXPECT_TRUE(value->RemoveProperty("a"));
+	EXPECT_FALSE(value->RemoveProperty("a"));
+	EXPECT_EQ(value->GetProperty("a"), nullptr);
+	EXPECT_EQ(value->GetPropertyCount(), 2);
+
+	value->Release();
+}
+
+TEST(value, ReplicaInlineProperties)
+{
+	EXP_StringValue *original = new EXP_StringValue("", "original");
+	EXP_Value *props[] = {
+		new EXP_BoolValue(true),
+		new EXP_FloatValue(2.5f),
+		new EXP_IntValue(3),
+		new EXP_StringValue("text", ""),
+		new EXP_IntValue(4, "named")
+	};
+	const char *names[] = {"a", "b", "c", "d", "e"};
+	for (unsigned int i = 0; i < 5; ++i) {
+		original->SetProperty(names[i], props[i]);
+		props[i]->Release();
+	}
+
+	EXP_Value *replica = original->GetReplica();
+	ASSERT_EQ(replica->GetPropertyCount(), 5);
+
+	/* The unnamed int, float and bool are inline until requested. */
+	EXPECT_EQ(replica->GetStoredProperty(0), nullptr);
+	EXPECT_EQ(replica->GetStoredProperty(1), nullptr);
+	EXPECT_EQ(replica->GetStoredProperty(2), nullptr);
+	EXPECT_NE(replica->GetStoredProperty(3), nullptr);
+	EXPECT_NE(replica->GetStoredProperty(3), props[3]);
+	EXPECT_NE(replica->GetStoredProperty(4), nullptr);
+
+	EXPECT_EQ(replica->GetPropertyNumber("a", 0.0f), 1.0f);
+	EXPECT_EQ(replica->GetPropertyNumber("b", 0.0f), 2.5f);
+	EXPECT_EQ(replica->GetPropertyNumber("c", 0.0f), 3.0f);
+	EXPECT_EQ(replica->GetStoredProperty(2), nullptr);
+
+	/* A requested value is kept and its modifications are not shared with the original. */
+	EXP_Value *prop = replica->GetProperty("c");
+	ASSERT_NE(prop, nullptr);
+	EXPECT_EQ(prop->GetValueType(), VALUE_INT_TYPE);
+	EXPECT_EQ(replica->GetProperty("c"), prop);
+	EXPECT_EQ(replica->GetStoredProperty(2), prop);
+
+	EXP_IntValue *newval = new EXP_IntValue(10);
+	prop->SetValue(newval);
+	newval->Release();
+	EXPECT_EQ(replica->GetPropertyNumber("c", 0.0f), 10.0f);
+	EXPECT_EQ(original->GetPropertyNumber("c", 0.0f), 3.0f);
+	EXPECT_EQ(original->GetProperty("c"), props[2]);
+
+	/* A replica of a replica copies the inline and the requested values. */
+	EXP_Value *subReplica = replica->GetReplica();
+	EXPECT_EQ(subReplica->GetPropertyNumber("a", 0.0f), 1.0f);
+	EXPECT_EQ(subReplica->GetPropertyNumber("c", 0.0f), 10.0f);
+	EXPECT_EQ(subReplica->GetStoredProperty(2), nullptr);
+
+	/* The names shared with the original are copied before adding a property. */
+	EXP_IntValue *added = new EXP_IntValue(5);
+	replica->SetProperty("f", added);
+	added->Release();
+	EXPECT_EQ(replica->GetPropertyCount(), 6);
+	EXPECT_EQ(original->GetPropertyCount(), 5);
+	EXPECT_EQ(subReplica->GetPropertyCount(), 5);
+	EXPECT_EQ(original->GetProperty("f"), nullptr);
+
+	subReplica->Release();
+	replica->Release();
+	original->Release();
+}
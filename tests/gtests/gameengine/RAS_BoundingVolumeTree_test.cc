@@ -0,0 +1,171 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "RAS_BoundingVolumeTree.h"
+
+#include <algorithm>
+#include <random>
+
+#define BOX_COUNT 500
+#define FRAME_COUNT 10
+
+struct TreeBox
+{
+	mt::vec3 min;
+	mt::vec3 max;
+	int proxy;
+};
+
+static bool box_inside_frustum(const std::array<mt::vec4, 6>& planes, const mt::vec3& min, const mt::vec3& max)
+{
+	const mt::vec3 center = (min + max) * 0.5f;
+	const mt::vec3 extent = (max - min) * 0.5f;
+	for (const mt::vec4& plane : planes) {
+		const float dist = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+		const float radius = fabs(plane.x) * extent.x + fabs(plane.y) * extent.y + fabs(plane.z) * extent.z;
+		if ((dist + radius) < 0.0f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Planes with normals pointing inside of an axis aligned box frustum.
+static std::array<mt::vec4, 6> box_planes(const mt::vec3& min, const mt::vec3& max)
+{
+	return {{
+		mt::vec4(1.0f, 0.0f, 0.0f, -min.x),
+		mt::vec4(-1.0f, 0.0f, 0.0f, max.x),
+		mt::vec4(0.0f, 1.0f, 0.0f, -min.y),
+		mt::vec4(0.0f, -1.0f, 0.0f, max.y),
+		mt::vec4(0.0f, 0.0f, 1.0f, -min.z),
+		mt::vec4(0.0f, 0.0f, -1.0f, max.z)
+	}};
+}
+
+/// Planes of a pyramid looking along the x axis, with a normalized oblique normal per side.
+static std::array<mt::vec4, 6> pyramid_planes()
+{
+	const float n = 1.0f / sqrtf(2.0f);
+	return {{
+		mt::vec4(n, n, 0.0f, 0.0f),
+		mt::vec4(n, -n, 0.0f, 0.0f),
+		mt::vec4(n, 0.0f, n, 0.0f),
+		mt::vec4(n, 0.0f, -n, 0.0f),
+		mt::vec4(1.0f, 0.0f, 0.0f, -1.0f),
+		mt::vec4(-1.0f, 0.0f, 0.0f, 80.0f)
+	}};
+}
+
+static void expect_frustum_query(const RAS_BoundingVolumeTree& tree, const std::vector<TreeBox>& boxes,
+                                 const std::array<mt::vec4, 6>& planes, float margin)
+{
+	std::vector<TreeBox *> found;
+	tree.QueryFrustum(planes, [&found](void *userData) {
+		found.push_back(static_cast<TreeBox *>(userData));
+	});
+
+	// Each box found once.
+	std::vector<TreeBox *> sorted = found;
+	std::sort(sorted.begin(), sorted.end());
+	EXPECT_EQ(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+	for (const TreeBox& box : boxes) {
+		const bool inTree = (box.proxy != RAS_BoundingVolumeTree::NULL_NODE);
+		const bool isFound = std::binary_search(sorted.begin(), sorted.end(), &box);
+		if (!inTree) {
+			EXPECT_FALSE(isFound);
+			continue;
+		}
+
+		// A visible box is always found.
+		if (box_inside_frustum(planes, box.min, box.max)) {
+			EXPECT_TRUE(isFound);
+		}
+		/* The leaf boxes are enlarged by the margin and contain the moved boxes,
+		 * a box further than twice the margin is never found. */
+		const mt::vec3 enlarge(margin * 2.0f);
+		if (!box_inside_frustum(planes, box.min - enlarge, box.max + enlarge)) {
+			EXPECT_FALSE(isFound);
+		}
+	}
+}
+
+static void expect_queries(const RAS_BoundingVolumeTree& tree, const std::vector<TreeBox>& boxes, float margin)
+{
+	expect_frustum_query(tree, boxes, box_planes(mt::vec3(-20.0f, -20.0f, -20.0f), mt::vec3(20.0f, 30.0f, 10.0f)), margin);
+	expect_frustum_query(tree, boxes, box_planes(mt::vec3(40.0f, -100.0f, -5.0f), mt::vec3(60.0f, 100.0f, 5.0f)), margin);
+	expect_frustum_query(tree, boxes, pyramid_planes(), margin);
+}
+
+/* Compare the frustum queries against a test of each box while boxes are moved,
+ * removed and inserted again. */
+TEST(RAS_BoundingVolumeTree, QueryFrustum)
+{
+	const float margin = 0.5f;
+	RAS_BoundingVolumeTree tree(margin);
+
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> size(0.1f, 4.0f);
+	std::uniform_real_distribution<float> move(-3.0f, 3.0f);
+	std::uniform_int_distribution<int> action(0, 9);
+
+	std::vector<TreeBox> boxes(BOX_COUNT);
+	for (TreeBox& box : boxes) {
+		box.min = mt::vec3(position(rng), position(rng), position(rng));
+		box.max = box.min + mt::vec3(size(rng), size(rng), size(rng));
+		box.proxy = tree.Insert(box.min, box.max, &box);
+	}
+
+	EXPECT_EQ(tree.GetSize(), BOX_COUNT);
+	expect_queries(tree, boxes, margin);
+
+	for (unsigned int frame = 0; frame < FRAME_COUNT; ++frame) {
+		for (TreeBox& box : boxes) {
+			const int act = action(rng);
+			if (box.proxy == RAS_BoundingVolumeTree::NULL_NODE) {
+				// Insert again a removed box.
+				if (act < 3) {
+					box.proxy = tree.Insert(box.min, box.max, &box);
+				}
+			}
+			// Remove a box.
+			else if (act == 0) {
+				tree.Remove(box.proxy);
+				box.proxy = RAS_BoundingVolumeTree::NULL_NODE;
+			}
+			// Move a box, by small steps or teleported.
+			else if (act < 6) {
+				const mt::vec3 offset = (act == 1) ? mt::vec3(position(rng), position(rng), position(rng)) - box.min :
+					mt::vec3(move(rng), move(rng), move(rng));
+				box.min += offset;
+				box.max += offset;
+				tree.Update(box.proxy, box.min, box.max);
+			}
+		}
+
+		tree.Optimize();
+
+		unsigned int count = 0;
+		for (const TreeBox& box : boxes) {
+			if (box.proxy != RAS_BoundingVolumeTree::NULL_NODE) {
+				EXPECT_EQ(tree.GetUserData(box.proxy), &box);
+				++count;
+			}
+		}
+		EXPECT_EQ(tree.GetSize(), count);
+
+		expect_queries(tree, boxes, margin);
+	}
+
+	tree.Rebuild();
+	expect_queries(tree, boxes, margin);
+
+	tree.Clear();
+	EXPECT_EQ(tree.GetSize(), 0);
+	unsigned int found = 0;
+	tree.QueryFrustum(pyramid_planes(), [&found](void *) { ++found; });
+	EXPECT_EQ(found, 0);
+}
@@ -0,0 +1,60 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "SCA_TestScene.h"
+#include "SCA_ANDController.h"
+
+extern "C" {
+#include "PIL_time_utildefines.h"
+}
+
+/* Number of logic tics run for each scene. */
+#define FRAME_COUNT 100
+
+static void logic_manager_frame_test(unsigned int numobjects, unsigned int numcontrollers)
+{
+	printf("\n========== STARTING %u bricks ==========\n", numobjects * (numcontrollers * 2 + 1));
+
+	TestScene scene;
+	for (unsigned int i = 0; i < numobjects; ++i) {
+		SCA_IObject *gameobj = scene.AddObject();
+		for (unsigned int j = 0; j < numcontrollers; ++j) {
+			SCA_IController *controller = new SCA_ANDController(gameobj);
+			controller->SetExecutePriority(j);
+			scene.AddController(gameobj, controller);
+		}
+	}
+	scene.Start();
+
+	{
+		TIMEIT_START(logic_frame);
+		for (unsigned int i = 0; i < FRAME_COUNT; ++i) {
+			scene.Frame(i / 60.0);
+		}
+		TIMEIT_END(logic_frame);
+	}
+
+	for (SCA_IObject *gameobj : scene.m_objects) {
+		for (SCA_IController *controller : gameobj->GetControllers()) {
+			EXPECT_EQ(controller->GetTriggeredIndex(), -1);
+		}
+	}
+
+	printf("========== ENDED %u bricks ==========\n\n", numobjects * (numcontrollers * 2 + 1));
+}
+
+TEST(logic_manager, Frame5k)
+{
+	logic_manager_frame_test(1000, 2);
+}
+
+TEST(logic_manager, Frame50k)
+{
+	logic_manager_frame_test(10000, 2);
+}
+
+TEST(logic_manager, Frame50kSingleObject)
+{
+	logic_manager_frame_test(1, 25000);
+}
@@ -0,0 +1,47 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "SCA_TestScene.h"
+
+#include <algorithm>
+
+TEST(logic_manager, Order)
+{
+	std::vector<SCA_IController *> executed;
+	TestScene scene;
+
+	SCA_IObject *first = scene.AddObject();
+	SCA_IObject *second = scene.AddObject();
+
+	TestController *low = new TestController(second, executed);
+	low->SetExecutePriority(2);
+	scene.AddController(second, low);
+	TestController *high = new TestController(second, executed);
+	high->SetExecutePriority(1);
+	scene.AddController(second, high);
+	TestController *bookmarked = new TestController(second, executed);
+	bookmarked->SetBookmark(true);
+	scene.AddController(second, bookmarked);
+	TestController *other = new TestController(first, executed);
+	scene.AddController(first, other);
+
+	scene.Start();
+	scene.Frame(0.0);
+
+	/* The bookmarked controllers first, then the objects in trigger order
+	 * and the controllers of an object by priority. */
+	ASSERT_EQ(executed.size(), 4u);
+	EXPECT_EQ(executed[0], bookmarked);
+	EXPECT_EQ(executed[1], other);
+	EXPECT_EQ(executed[2], high);
+	EXPECT_EQ(executed[3], low);
+
+	/* A removed controller is not executed. */
+	executed.clear();
+	scene.m_logicmgr.AddTriggeredController(high, second->GetSensors().front());
+	scene.m_logicmgr.RemoveController(high);
+	EXPECT_EQ(high->GetTriggeredIndex(), -1);
+	scene.Frame(1.0 / 60.0);
+	EXPECT_EQ(std::count(executed.begin(), executed.end(), high), 0);
+}
@@ -0,0 +1,135 @@
+/* Apache License, Version 2.0 */
+
+#ifndef __SCA_TESTSCENE_H__
+#define __SCA_TESTSCENE_H__
+
+#include "SCA_LogicManager.h"
+#include "SCA_BasicEventManager.h"
+#include "SCA_AlwaysSensor.h"
+#include "SCA_IController.h"
+#include "SCA_IActuator.h"
+#include "SCA_IObject.h"
+
+#include <vector>
+
+class TestObject : public SCA_IObject
+{
+public:
+	virtual std::string GetName()
+	{
+		return "object";
+	}
+};
+
+/* Actuator ending immediately, as a motion actuator with a single update. */
+class TestActuator : public SCA_IActuator
+{
+public:
+	TestActuator(SCA_IObject *gameobj)
+		:SCA_IActuator(gameobj, KX_ACT_OBJECT)
+	{
+	}
+
+	virtual bool Update()
+	{
+		RemoveAllEvents();
+		return false;
+	}
+};
+
+/* Controller recording its execution order. */
+class TestController : public SCA_IController
+{
+public:
+	std::vector<SCA_IController *>& m_executed;
+
+	TestController(SCA_IObject *gameobj, std::vector<SCA_IController *>& executed)
+		:SCA_IController(gameobj),
+		m_executed(executed)
+	{
+	}
+
+	virtual void Trigger(SCA_LogicManager *logicmgr)
+	{
+		m_executed.push_back(this);
+	}
+};
+
+/* A logic scene of objects using an always sensor with pulse mode. */
+class TestScene
+{
+public:
+	SCA_LogicManager m_logicmgr;
+	SCA_EventManager *m_eventmgr;
+	std::vector<SCA_IObject *> m_objects;
+
+	TestScene()
+	{
+		m_eventmgr = new SCA_BasicEventManager(&m_logicmgr);
+		m_logicmgr.RegisterEventManager(m_eventmgr);
+	}
+
+	~TestScene()
+	{
+		for (SCA_IObject *gameobj : m_objects) {
+			for (SCA_ISensor *sensor : gameobj->GetSensors()) {
+				m_logicmgr.RemoveSensor(sensor);
+			}
+			for (SCA_IController *controller : gameobj->GetControllers()) {
+				m_logicmgr.RemoveController(controller);
+			}
+			for (SCA_IActuator *actuator : gameobj->GetActuators()) {
+				m_logicmgr.RemoveActuator(actuator);
+			}
+			gameobj->Release();
+		}
+	}
+
+	SCA_IObject *AddObject()
+	{
+		SCA_IObject *gameobj = new TestObject();
+		gameobj->SetInitState(1);
+		m_objects.push_back(gameobj);
+
+		SCA_ISensor *sensor = new SCA_AlwaysSensor(m_eventmgr, gameobj);
+		sensor->SetPulseMode(true, false, 0);
+		sensor->SetLogicManager(&m_logicmgr);
+		gameobj->AddSensor(sensor);
+		sensor->Release();
+
+		return gameobj;
+	}
+
+	/// Link a controller to the sensor of the object and to a new actuator.
+	void AddController(SCA_IObject *gameobj, SCA_IController *controller)
+	{
+		controller->SetState(1);
+		controller->SetLogicManager(&m_logicmgr);
+		gameobj->AddController(controller);
+		controller->Release();
+
+		SCA_IActuator *actuator = new TestActuator(gameobj);
+		actuator->SetLogicManager(&m_logicmgr);
+		gameobj->AddActuator(actuator);
+		actuator->Release();
+
+		m_logicmgr.RegisterToSensor(controller, gameobj->GetSensors().front());
+		m_logicmgr.RegisterToActuator(controller, actuator);
+	}
+
+	void Start()
+	{
+		for (SCA_IObject *gameobj : m_objects) {
+			gameobj->ResetState();
+		}
+	}
+
+	void Frame(double time)
+	{
+		m_logicmgr.BeginFrame(time, 1.0 / 60.0);
+		m_logicmgr.UpdateFrame(time);
+		m_logicmgr.EndFrame();
+	}
+};
+
+#endif  /* __SCA_TESTSCENE_H__ */
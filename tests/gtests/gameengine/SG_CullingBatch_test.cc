@@ -0,0 +1,100 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "SG_CullingBatch.h"
+#include "SG_Frustum.h"
+
+#include <random>
+
+/* Number of entries in the batch, not a multiple of the lane count or the mask bits. */
+#define ENTRY_COUNT 1003
+
+struct CullingEntry
+{
+	mt::mat3x4 trans;
+	SG_BBox aabb;
+};
+
+static std::vector<SG_Frustum> culling_views()
+{
+	const mt::mat4 proj = mt::mat4::Perspective(1.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+	const mt::mat4 ortho = mt::mat4::Ortho(-20.0f, 20.0f, -10.0f, 10.0f, 0.1f, 50.0f);
+
+	return {
+		SG_Frustum(proj * mt::mat4::LookAt(mt::vec3(0.0f, 10.0f, 0.0f), mt::zero3, mt::axisZ3, 1.0f)),
+		SG_Frustum(proj * mt::mat4::LookAt(mt::vec3(-30.0f, 0.0f, 5.0f), mt::vec3(20.0f, 20.0f, 0.0f), mt::axisZ3, 1.0f)),
+		SG_Frustum(ortho * mt::mat4::LookAt(mt::zero3, mt::vec3(0.0f, 0.0f, 30.0f), mt::axisY3, 1.0f))
+	};
+}
+
+static bool brute_force_visible(const SG_Frustum& frustum, const CullingEntry& entry)
+{
+	const mt::mat4 mat = mt::mat4::FromAffineTransform(entry.trans);
+	return (frustum.AabbInsideFrustum(entry.aabb.GetMin(), entry.aabb.GetMax(), mat) != SG_Frustum::OUTSIDE);
+}
+
+/* Check the batch visibility masks of several views against a test of each entry
+ * and each view, as done by the scene render schedule. */
+TEST(SG_CullingBatch, Views)
+{
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> angle(-M_PI, M_PI);
+	std::uniform_real_distribution<float> size(0.1f, 5.0f);
+	std::uniform_real_distribution<float> scale(0.2f, 3.0f);
+
+	std::vector<CullingEntry> entries(ENTRY_COUNT);
+	SG_CullingBatch batch;
+	for (CullingEntry& entry : entries) {
+		const mt::mat3 rot = mt::quat::FromEulerAngles(mt::vec3(angle(rng), angle(rng), angle(rng))).ToMatrix();
+		const mt::vec3 pos(position(rng), position(rng), position(rng));
+		const mt::vec3 sca(scale(rng), scale(rng), scale(rng));
+		const mt::vec3 min(-size(rng), -size(rng), -size(rng));
+		const mt::vec3 max(size(rng), size(rng), size(rng));
+
+		entry.trans = mt::mat3x4(rot, pos, sca);
+		entry.aabb = SG_BBox(min, max);
+		batch.Add(entry.trans, sca, entry.aabb);
+	}
+
+	EXPECT_EQ(batch.GetSize(), ENTRY_COUNT);
+
+	const std::vector<SG_Frustum> views = culling_views();
+	std::vector<bool> culledAll(ENTRY_COUNT, true);
+	std::vector<bool> refCulledAll(ENTRY_COUNT, true);
+
+	for (const SG_Frustum& frustum : views) {
+		SG_CullingBatch::VisibilityMask mask;
+		batch.Test(frustum, mask);
+
+		unsigned int visibleCount = 0;
+		for (unsigned int i = 0; i < ENTRY_COUNT; ++i) {
+			const bool visible = SG_CullingBatch::IsVisible(mask, i);
+			const bool refVisible = brute_force_visible(frustum, entries[i]);
+			EXPECT_EQ(visible, refVisible) << "entry " << i;
+
+			if (visible) {
+				culledAll[i] = false;
+				++visibleCount;
+			}
+			if (refVisible) {
+				refCulledAll[i] = false;
+			}
+		}
+
+		// The views must neither cull nor see everything to test something.
+		EXPECT_GT(visibleCount, 0);
+		EXPECT_LT(visibleCount, ENTRY_COUNT);
+	}
+
+	EXPECT_EQ(culledAll, refCulledAll);
+
+	// The batch is reused for the next frame.
+	batch.Clear();
+	EXPECT_EQ(batch.GetSize(), 0);
+
+	SG_CullingBatch::VisibilityMask mask;
+	batch.Test(views[0], mask);
+	EXPECT_TRUE(mask.empty());
+}
@@ -0,0 +1,116 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "SG_Node.h"
+#include "SG_Scene.h"
+#include "SG_TransformStore.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <random>
+
+extern "C" {
+#include "PIL_time_utildefines.h"
+}
+
+/* Number of time the distance pass is repeated. */
+#define DISTANCE_PASS_COUNT 100
+
+class TestScene : public SG_Scene
+{
+public:
+	virtual SG_Object *ReplicateNodeObject(SG_Node *UNUSED(node), SG_Object *UNUSED(origObject))
+	{
+		return nullptr;
+	}
+
+	virtual void DestructNodeObject(SG_Node *UNUSED(node), SG_Object *UNUSED(object))
+	{
+	}
+};
+
+static const mt::vec3 cam_positions[] = {
+	mt::vec3(0.0f, 0.0f, 0.0f),
+	mt::vec3(50.0f, -20.0f, 5.0f)
+};
+
+static float node_distance(const mt::vec3& pos)
+{
+	float dist = FLT_MAX;
+	for (const mt::vec3& campos : cam_positions) {
+		dist = std::min((pos - campos).LengthSquared(), dist);
+	}
+	return dist;
+}
+
+/* Compare the activity culling distance pass done through scattered nodes and
+ * through the packed positions of the transform store. */
+static void transform_store_distance_test(unsigned int numnodes)
+{
+	printf("\n========== STARTING %u nodes ==========\n", numnodes);
+
+	TestScene scene;
+	scene.SetUseTransformStore(true);
+	SG_TransformStore *store = scene.GetTransformStore();
+
+	std::mt19937 rng(numnodes);
+	std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+	SG_Callbacks callbacks;
+
+	/* Interleave allocations to scatter nodes in memory like in a running scene. */
+	std::vector<SG_Node *> nodes;
+	std::vector<std::vector<char> > fillers;
+	for (unsigned int i = 0; i < numnodes; ++i) {
+		SG_Node *node = new SG_Node(nullptr, &scene, callbacks, nullptr);
+		const mt::vec3 pos(dist(rng), dist(rng), dist(rng));
+		node->SetWorldPosition(pos);
+		store->Update(node->GetTransformIndex(), pos);
+		nodes.push_back(node);
+		fillers.emplace_back(rng() % 512);
+	}
+	std::shuffle(nodes.begin(), nodes.end(), rng);
+
+	std::vector<float> distances(numnodes);
+
+	{
+		TIMEIT_START(node_pointer_chasing);
+		for (unsigned int pass = 0; pass < DISTANCE_PASS_COUNT; ++pass) {
+			for (unsigned int i = 0; i < numnodes; ++i) {
+				distances[i] = node_distance(nodes[i]->GetWorldPosition());
+			}
+		}
+		TIMEIT_END(node_pointer_chasing);
+	}
+
+	{
+		const SG_TransformStore::PositionList& positions = store->GetPositions();
+		TIMEIT_START(transform_store);
+		for (unsigned int pass = 0; pass < DISTANCE_PASS_COUNT; ++pass) {
+			for (unsigned int i = 0; i < numnodes; ++i) {
+				distances[i] = node_distance(positions[i]);
+			}
+		}
+		TIMEIT_END(transform_store);
+	}
+
+	EXPECT_EQ(store->GetSize(), numnodes);
+	for (SG_Node *node : nodes) {
+		EXPECT_EQ(distances[node->GetTransformIndex()], node_distance(node->GetWorldPosition()));
+	}
+
+	scene.DestructRootNodes();
+	EXPECT_EQ(store->GetSize(), 0);
+
+	printf("========== ENDED %u nodes ==========\n\n", numnodes);
+}
+
+TEST(transform_store, Distance10k)
+{
+	transform_store_distance_test(10000);
+}
+
+TEST(transform_store, Distance100k)
+{
+	transform_store_distance_test(100000);
+}